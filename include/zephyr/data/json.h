@@ -699,6 +699,120 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/** @cond INTERNAL_HIDDEN */
+
+#if defined(CONFIG_JSON_LIBRARY_STREAM_DEPTH)
+#define Z_JSON_STREAM_DEPTH CONFIG_JSON_LIBRARY_STREAM_DEPTH
+#else
+#define Z_JSON_STREAM_DEPTH 8
+#endif
+
+/* Object or array being filled by the streaming parser */
+struct json_stream_frame {
+	/* Field descriptors of an object, element descriptor of an array */
+	const struct json_obj_descr *descr;
+	/* Struct of an object, next element of an array */
+	void *val;
+	union {
+		struct {
+			/* Descriptor of the current field, NULL if unknown */
+			const struct json_obj_descr *field;
+			size_t descr_len;
+			size_t next;
+			int64_t decoded;
+		} obj;
+		struct {
+			size_t *elements;
+			void *end;
+		} arr;
+	};
+	bool is_array;
+	uint8_t state;
+};
+
+/** @endcond */
+
+/**
+ * @brief State of an incremental JSON object parser
+ *
+ * Unlike json_obj_parse(), which needs the whole document in one buffer,
+ * the streaming parser is fed the document in chunks of any size as they
+ * arrive, e.g. from net_buf fragments or a recv() loop.  Values are stored
+ * as soon as their last character has been seen.  Memory use is bounded by
+ * the token buffer handed to json_stream_init(), which only needs to hold
+ * the longest key, number or string value to be decoded, and by the nesting
+ * depth set with @kconfig{CONFIG_JSON_LIBRARY_STREAM_DEPTH}.
+ *
+ * Members are internal, use the json_stream_*() functions.
+ */
+struct json_stream {
+	/** @cond INTERNAL_HIDDEN */
+	char *buf;
+	size_t buf_size;
+	size_t len;
+	size_t skip_depth;
+	const char *literal;
+	int64_t result;
+	int error;
+	uint8_t depth;
+	uint8_t lex_state;
+	uint8_t lex_count;
+	uint8_t literal_type;
+	bool store;
+	bool key_unknown;
+	struct json_stream_frame stack[Z_JSON_STREAM_DEPTH];
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize an incremental JSON object parser
+ *
+ * The descriptors are used the same way as by json_obj_parse(), with one
+ * restriction: fields of type JSON_TOK_STRING, JSON_TOK_OPAQUE,
+ * JSON_TOK_FLOAT and JSON_TOK_OBJ_ARRAY point into the input, which the
+ * streaming parser does not keep, and make the parsing fail with -ENOTSUP.
+ * Use JSON_TOK_STRING_BUF for strings instead.
+ *
+ * @param stream Parser state to initialize
+ * @param buf Buffer used to assemble tokens split across chunks
+ * @param buf_size Size of @a buf, one more than the longest key or value
+ * that has to be decoded.  Unknown fields are skipped without being stored,
+ * whatever the length of their key or value.
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ *
+ * @return 0 on success, -EINVAL if @a buf is too small to hold anything.
+ */
+int json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		     const struct json_obj_descr *descr, size_t descr_len, void *val);
+
+/**
+ * @brief Feed the next chunk of a document to an incremental parser
+ *
+ * @param stream Parser state
+ * @param data Next part of the JSON-encoded object
+ * @param len Length of @a data
+ *
+ * @return 0 if the chunk has been consumed, a negative value as defined
+ * in errno.h otherwise: -EINVAL for malformed input, -ENOMEM if a token
+ * does not fit in the token buffer or the nesting is too deep, -ENOSPC if
+ * an array has too many elements, -ENOTSUP for unsupported field types.
+ * Errors are sticky, later calls return the same value.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Finish parsing with an incremental parser
+ *
+ * @param stream Parser state
+ *
+ * @return < 0 if an error occurred or the object is incomplete, bitmap of
+ * decoded top-level fields otherwise, as returned by json_obj_parse().
+ */
+int64_t json_stream_finish(struct json_stream *stream);
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
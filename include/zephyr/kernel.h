@@ -1577,8 +1577,9 @@ const char *k_thread_state_str(k_tid_t thread_id, char *buf, size_t buf_size);
 struct k_timer {
 	/*
 	 * _timeout structure must be first here if we want to use
-	 * dynamic timer allocation. timeout.node is used in the double-linked
-	 * list of free timers
+	 * dynamic timer allocation. timeout.node links the running timer
+	 * into the timeout queue: a node of the double-linked delta list,
+	 * or of the red/black tree with CONFIG_TIMEOUT_QUEUE_SCALABLE.
 	 */
 	struct _timeout timeout;
 
@@ -5403,14 +5404,35 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Only filled in by the object core statistics, summed over CPUs */
+	uint32_t num_cached;
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+	char *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Threads allocating with a timeout and nothing cached locally */
+	atomic_t cache_waiters;
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5771,6 +5793,46 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+/**
+ * @brief Allocate several equally sized blocks from a k_heap
+ *
+ * Allocates @a count blocks of @a bytes each under a single
+ * acquisition of the heap lock, storing pointers to them in @a mem.
+ * Either all blocks are allocated or none is.  If the batch cannot
+ * be allocated immediately, the call will block for the specified
+ * timeout waiting for memory to be freed.  Allocated memory is
+ * aligned on a multiple of pointer sizes.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ * @note When CONFIG_MULTITHREADING=n any @a timeout is treated as K_NO_WAIT.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param h Heap from which to allocate
+ * @param bytes Desired size of each block
+ * @param mem Array receiving @a count block pointers
+ * @param count Number of blocks to allocate
+ * @param timeout How long to wait, or K_NO_WAIT
+ *
+ * @retval 0 All blocks were allocated
+ * @retval -ENOMEM The blocks could not be allocated before the timeout
+ */
+int k_heap_alloc_bulk(struct k_heap *h, size_t bytes, void **mem, size_t count,
+		      k_timeout_t timeout) __attribute_nonnull(1);
+
+/**
+ * @brief Free several blocks into a k_heap
+ *
+ * Returns the @a count blocks in @a mem, which must have been
+ * allocated from @a h, under a single acquisition of the heap lock.
+ * NULL entries are legal and have no effect.
+ *
+ * @param h Heap to which to return the memory
+ * @param mem Array of memory blocks
+ * @param count Number of entries in @a mem
+ */
+void k_heap_free_bulk(struct k_heap *h, void **mem, size_t count) __attribute_nonnull(1);
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -6244,6 +6306,77 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+struct k_poll_watch;
+
+/**
+ * @brief Poll watch callback
+ *
+ * Called for every event of a watch that becomes ready, from the context that
+ * made its object ready, which may be an ISR, and with interrupts locked. It
+ * must not block nor call k_poll() functions. The event is no longer
+ * registered with its object when the callback runs.
+ *
+ * @param watch The watch the event was added to.
+ * @param event The event that became ready, with its state field updated.
+ */
+typedef void (*k_poll_watch_cb_t)(struct k_poll_watch *watch, struct k_poll_event *event);
+
+/**
+ * @brief Poll watch
+ *
+ * Unlike k_poll(), which registers its events for the duration of the call,
+ * a poll watch keeps events registered with their objects until they become
+ * ready or are removed, and reports each of them through a callback. This
+ * lets a subsystem wait for a large, mostly idle set of objects without
+ * registering all of them again every time one of them becomes ready.
+ */
+struct k_poll_watch {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	k_poll_watch_cb_t cb;
+};
+
+/**
+ * @brief Initialize a poll watch
+ *
+ * @param watch The watch to initialize.
+ * @param cb Callback invoked when an event added to the watch becomes ready.
+ */
+void k_poll_watch_init(struct k_poll_watch *watch, k_poll_watch_cb_t cb);
+
+/**
+ * @brief Add events to a poll watch
+ *
+ * Registers each event with its object. Events whose object is already ready
+ * are not registered, the callback is invoked for them before this function
+ * returns. Otherwise, the callback is invoked once, when the object becomes
+ * ready, after which the event must be added again to be watched further.
+ *
+ * The events must stay valid until they fired or were removed with
+ * k_poll_watch_remove().
+ *
+ * @param watch The watch to add the events to.
+ * @param events Events initialized with k_poll_event_init().
+ * @param num_events Number of events.
+ */
+void k_poll_watch_add(struct k_poll_watch *watch, struct k_poll_event *events,
+		      int num_events);
+
+/**
+ * @brief Remove events from a poll watch
+ *
+ * Unregisters the events that did not fire yet. The callback is not invoked
+ * for them once this function returned.
+ *
+ * @param watch The watch the events were added to.
+ * @param events Events previously passed to k_poll_watch_add().
+ * @param num_events Number of events.
+ */
+void k_poll_watch_remove(struct k_poll_watch *watch, struct k_poll_event *events,
+			 int num_events);
+
 /** @} */
 
 /**
@@ -297,7 +297,11 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	struct rbnode node;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
 	/* Can't use k_ticks_t for header dependency reasons */
@@ -305,6 +309,16 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Orders timeouts expiring on the same tick, dticks holds the
+	 * absolute expiry tick while queued.
+	 */
+	uint32_t order_key;
+#endif
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* CPU whose queue holds this timeout */
+	uint8_t cpu;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -208,6 +208,11 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE	= BIT(22),
+
+	/** TCP segmentation offload, the device splits the TCP packets having
+	 *  a non-zero net_pkt_gso_size() and computes their checksums
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -12,6 +12,7 @@
 #ifndef ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 #define ZEPHYR_INCLUDE_NET_HTTP_SERVER_HPACK_H_
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -129,6 +130,55 @@ struct http_hpack_header_buf {
 
 /** @cond INTERNAL_HIDDEN */
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE
+
+/* An entry takes at least 34 bytes of the table size: 32 bytes plus a name
+ * and a value of one byte at least.
+ */
+#define HTTP_SERVER_HPACK_DYNAMIC_TABLE_ENTRIES (HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE / 34)
+
+struct http_hpack_dynamic_entry {
+	uint32_t name_hash;
+	uint32_t hash;
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+/* HPACK encoder state of a connection, the dynamic table mirrors the one of
+ * the peer decoder.
+ */
+struct http_hpack_encoder {
+	/* Entries from the oldest to the newest one */
+	struct http_hpack_dynamic_entry entries[HTTP_SERVER_HPACK_DYNAMIC_TABLE_ENTRIES];
+
+	/* Names and values of the entries, one after the other, in the same order */
+	uint8_t data[HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE];
+
+	uint16_t count;
+	uint16_t data_len;
+
+	/* Size of the entries, as defined by RFC7541, ch 4.1 */
+	uint16_t size;
+	uint16_t max_size;
+
+	/* Smallest maximum size since the last dynamic table size update */
+	uint16_t min_size;
+	bool size_update;
+};
+
+void http_hpack_encoder_init(struct http_hpack_encoder *encoder);
+void http_hpack_encoder_set_max_size(struct http_hpack_encoder *encoder,
+				     uint32_t max_size);
+int http_hpack_encode_size_update(struct http_hpack_encoder *encoder,
+				  uint8_t *buf, size_t buflen);
+int http_hpack_encode_header_dynamic(struct http_hpack_encoder *encoder,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header);
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen);
 int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
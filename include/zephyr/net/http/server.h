@@ -92,9 +92,6 @@ struct http_resource_detail {
 	/** Resource type. */
 	enum http_resource_type type;
 
-	/** Length of the URL path. */
-	int path_len;
-
 	/** Content encoding of the resource. */
 	const char *content_encoding;
 
@@ -232,6 +229,63 @@ typedef int (*http_resource_dynamic_cb_t)(struct http_client_ctx *client,
 					  struct http_response_ctx *response_ctx,
 					  void *user_data);
 
+/**
+ * @brief Response cache of a dynamic resource.
+ *
+ * The response to a GET request without query of a resource having a cache
+ * is kept in the buffer of the cache, and the following GET requests without
+ * query are answered from there, without calling the resource callback, until
+ * the cache expires. These responses carry an ETag, and the clients sending it
+ * back in an If-None-Match header get a 304 Not Modified response without
+ * body. Only the complete 200 OK responses without application headers which
+ * fit in the buffer are cached. Only the requests for the path the resource
+ * is registered with use the cache: the other paths a resource with wildcards
+ * matches, or the fallback resource, always get a generated response.
+ */
+struct http_resource_cache {
+	/** Buffer the response body is kept in. */
+	uint8_t *buf;
+
+	/** Size of the buffer. */
+	size_t buf_len;
+
+	/** Time the cached response is served for, in milliseconds. */
+	uint32_t ttl_ms;
+
+/** @cond INTERNAL_HIDDEN */
+	/* Path of the resource, set at boot */
+	const char *path;
+
+	/* Bumped on every invalidation, the cached response is only valid
+	 * while it did not change since the response was generated.
+	 */
+	atomic_t generation;
+	atomic_val_t response_generation;
+
+	int64_t expiry;
+	size_t len;
+	uint32_t etag;
+	bool valid;
+	bool storing;
+/** @endcond */
+};
+
+/**
+ * @brief Define a response cache for a dynamic resource.
+ *
+ * @param _name Name of the cache, to be set as the cache of the
+ *              @ref http_resource_detail_dynamic of the resource.
+ * @param _buf_len Size of the buffer for the response body.
+ * @param _ttl_ms Time a response is served from the cache, in milliseconds.
+ */
+#define HTTP_RESOURCE_CACHE_DEFINE(_name, _buf_len, _ttl_ms)                                       \
+	static uint8_t _name##_buf[_buf_len];                                                      \
+	static struct http_resource_cache _name = {                                                \
+		.buf = _name##_buf,                                                                \
+		.buf_len = sizeof(_name##_buf),                                                    \
+		.ttl_ms = _ttl_ms,                                                                 \
+	}
+
 /**
  * @brief Representation of a dynamic server resource.
  */
@@ -251,6 +305,14 @@ struct http_resource_detail_dynamic {
 
 	/** A pointer to the user data registered by the application.  */
 	void *user_data;
+
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE) || defined(__DOXYGEN__)
+	/** A pointer to the response cache of the resource, or NULL to call
+	 *  the resource callback for every request
+	 *  (see @ref HTTP_RESOURCE_CACHE_DEFINE).
+	 */
+	struct http_resource_cache *cache;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -440,6 +502,12 @@ struct http_client_ctx {
 	/** HTTP/2 header parser context. */
 	struct http_hpack_header_buf header_field;
 
+/** @cond INTERNAL_HIDDEN */
+	/** HTTP/2 response header encoder context. */
+	IF_ENABLED(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE,
+		   (struct http_hpack_encoder hpack_encoder;))
+/** @endcond */
+
 	/** HTTP/2 streams context. */
 	struct http2_stream_ctx streams[HTTP_SERVER_MAX_STREAMS];
 
@@ -455,6 +523,9 @@ struct http_client_ctx {
 	/** Request URL. */
 	unsigned char url_buffer[HTTP_SERVER_MAX_URL_LENGTH];
 
+	/** Length of the path of the request URL, without the query. */
+	int path_len;
+
 	/** Request content type. */
 	unsigned char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN];
 
@@ -544,6 +615,16 @@ int http_server_start(void);
  */
 int http_server_stop(void);
 
+/** @brief Invalidate the response cache of a dynamic resource.
+ *
+ * To be called when the data the response is generated from changes, so
+ * that the next request calls the resource callback again. A response being
+ * generated at the same time is not cached.
+ *
+ * @param cache Response cache of the resource.
+ */
+void http_resource_cache_invalidate(struct http_resource_cache *cache);
+
 #ifdef __cplusplus
 }
 #endif
@@ -67,6 +67,10 @@ struct http_resource_desc {
 
 struct http_service_runtime_data {
 	int num_clients;
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TRIE)
+	/* Root node of the resource trie, or -1 if the resources are looked up linearly */
+	int route_root;
+#endif
 };
 
 struct http_service_desc {
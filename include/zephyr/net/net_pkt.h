@@ -240,6 +240,11 @@ struct net_pkt {
 #if defined(CONFIG_NET_IP_FRAGMENT)
 	uint8_t ip_reassembled : 1; /* Packet is a reassembled IP packet. */
 #endif
+#if defined(CONFIG_NET_TCP_GRO)
+	uint8_t chksum_verified : 1; /* TCP checksum of the received packet
+				      * has already been verified.
+				      */
+#endif
 #if defined(CONFIG_NET_PKT_TIMESTAMP)
 	uint8_t tx_timestamping : 1; /** Timestamp transmitted packet */
 	uint8_t rx_timestamping : 1; /** Timestamp received packet */
@@ -360,6 +365,13 @@ struct net_pkt {
 	uint8_t ipv4_pmtu : 1;
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Size of the segments the TCP payload is to be split in before
+	 * being sent, or 0 if the packet is sent as it is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/* @endcond */
 };
 
@@ -872,6 +884,31 @@ static inline void net_pkt_set_ipv4_pmtu(struct net_pkt *pkt, bool value)
 }
 #endif /* CONFIG_NET_IPV4_PMTU */
 
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_NET_IPV4_FRAGMENT)
 static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
 {
@@ -1047,6 +1084,33 @@ static inline void net_pkt_set_ip_reassembled(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP_FRAGMENT */
 
+#if defined(CONFIG_NET_TCP_GRO)
+static inline bool net_pkt_is_chksum_verified(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_verified);
+}
+
+static inline void net_pkt_set_chksum_verified(struct net_pkt *pkt,
+					       bool verified)
+{
+	pkt->chksum_verified = verified;
+}
+#else /* CONFIG_NET_TCP_GRO */
+static inline bool net_pkt_is_chksum_verified(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_chksum_verified(struct net_pkt *pkt,
+					       bool verified)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(verified);
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -77,6 +77,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: Do not block once the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -537,6 +539,84 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receives up to @p vlen messages into @p msgvec, as if
+ * @ref zsock_recvmsg was called for each of them, but with a single system
+ * call and a single acquisition of the socket lock. The length of each
+ * received message is stored in the @c msg_len field of its entry.
+ * With @ref ZSOCK_MSG_WAITFORONE, the call blocks for the first message only
+ * and returns as soon as no more messages are queued.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages to receive
+ * @param vlen Number of entries in @p msgvec
+ * @param flags Flags, applied to every message
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Sends up to @p vlen messages from @p msgvec, as if @ref zsock_sendmsg was
+ * called for each of them, but with a single system call and a single
+ * acquisition of the socket lock. The number of bytes sent for each message
+ * is stored in the @c msg_len field of its entry. Sending stops at the first
+ * message which could not be sent.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages to send
+ * @param vlen Number of entries in @p msgvec
+ * @param flags Flags, applied to every message
+ *
+ * @return Number of messages sent, or -1 with errno set if no message
+ *         could be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			     int flags);
+
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Receives the next datagram, or the next chunk of data of a stream socket,
+ * by handing the network buffers holding it over to the caller instead of
+ * copying their contents. The data starts at the beginning of the first
+ * buffer of @p buf and may span several fragments.
+ *
+ * The caller owns the buffers and must release them with net_buf_unref()
+ * once done. The buffers come from the network receive pool, so holding on
+ * to them for long starves the network stack of receive buffers.
+ *
+ * This function is only available to supervisor threads, and only for
+ * native IP sockets. @ref ZSOCK_MSG_PEEK and @ref ZSOCK_MSG_WAITALL are not
+ * supported.
+ *
+ * @param sock Socket descriptor
+ * @param buf Set to the received buffers, or NULL if there was no data
+ * @param flags Flags
+ * @param src_addr Source address of a datagram, may be NULL
+ * @param addrlen Length of @p src_addr, value-result argument
+ *
+ * @return Number of bytes received, 0 on end of stream, or -1 with errno
+ *         set on error.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -959,6 +1039,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, as a string such as "reno" or "cubic" */
+#define TCP_CONGESTION 5
 
 /** @} */
 
@@ -79,14 +79,11 @@ struct net_socket_service_desc {
 	struct net_socket_service_event *pev;
 	/** Length of the pollable socket array for this service. */
 	int pev_len;
-	/** Where are my pollfd entries in the global list */
-	int *idx;
 };
 
 /** @cond INTERNAL_HIDDEN */
 
 #define __z_net_socket_svc_get_name(_svc_id) __z_net_socket_service_##_svc_id
-#define __z_net_socket_svc_get_idx(_svc_id) __z_net_socket_service_idx_##_svc_id
 #define __z_net_socket_svc_get_owner __FILE__ ":" STRINGIFY(__LINE__)
 
 #if CONFIG_NET_SOCKETS_LOG_LEVEL >= LOG_LEVEL_DBG
@@ -96,7 +93,6 @@ struct net_socket_service_desc {
 #endif
 
 #define __z_net_socket_service_define(_name, _cb, _count, ...) \
-	static int __z_net_socket_svc_get_idx(_name);			\
 	static struct net_socket_service_event				\
 			__z_net_socket_svc_get_name(_name)[_count] = {	\
 		[0 ... ((_count) - 1)] = {				\
@@ -109,7 +105,6 @@ struct net_socket_service_desc {
 		NET_SOCKET_SERVICE_OWNER				\
 		.pev = __z_net_socket_svc_get_name(_name),		\
 		.pev_len = (_count),					\
-		.idx = &__z_net_socket_svc_get_idx(_name),		\
 	}
 
 /** @endcond */
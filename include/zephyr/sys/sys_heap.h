@@ -65,6 +65,9 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint64_t elapsed_cycles;
+	size_t final_in_use_bytes;
+	size_t largest_free_bytes;
 };
 
 /**
@@ -165,6 +168,44 @@ void *sys_heap_noalign_alloc(struct sys_heap *heap, size_t align, size_t bytes);
  */
 void sys_heap_free(struct sys_heap *heap, void *mem);
 
+/** @brief Allocate several equally sized blocks from a sys_heap
+ *
+ * Allocates @a count blocks of @a bytes each and stores pointers to
+ * them in @a mem.  When a free block large enough for all of them
+ * exists, the whole batch is carved out of it with a single free
+ * list search.  Either all blocks are allocated or none is.  Each
+ * block may be freed individually with sys_heap_free() or together
+ * with sys_heap_free_bulk().
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param heap Heap from which to allocate
+ * @param bytes Number of bytes requested for each block
+ * @param mem Array receiving @a count block pointers
+ * @param count Number of blocks to allocate
+ * @retval 0 All blocks were allocated
+ * @retval -ENOMEM Not enough memory, no block was allocated
+ */
+int sys_heap_alloc_bulk(struct sys_heap *heap, size_t bytes, void **mem,
+			size_t count);
+
+/** @brief Free several blocks into a sys_heap
+ *
+ * Equivalent to calling sys_heap_free() on each of the @a count
+ * pointers in @a mem.
+ *
+ * @note The sys_heap implementation is not internally synchronized.
+ * No two sys_heap functions should operate on the same heap at the
+ * same time.  All locking must be provided by the user.
+ *
+ * @param heap Heap to which to return the memory
+ * @param mem Array of pointers previously returned from this heap
+ * @param count Number of pointers in @a mem
+ */
+void sys_heap_free_bulk(struct sys_heap *heap, void **mem, size_t count);
+
 /** @brief Expand the size of an existing allocation
  *
  * Returns a pointer to a new memory region with the same contents,
@@ -250,7 +291,11 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations, are returned via the @a result struct.  The struct
+ * also reports the hardware cycles spent inside the callbacks (for
+ * throughput figures) and, once the loop is done, the bytes still
+ * held by the rig and the largest block the heap could still hand
+ * out (for fragmentation figures).
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
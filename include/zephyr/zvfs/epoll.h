@@ -0,0 +1,100 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_
+
+#include <stdint.h>
+
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ZVFS_EPOLLIN      ZVFS_POLLIN
+#define ZVFS_EPOLLPRI     ZVFS_POLLPRI
+#define ZVFS_EPOLLOUT     ZVFS_POLLOUT
+#define ZVFS_EPOLLERR     ZVFS_POLLERR
+#define ZVFS_EPOLLHUP     ZVFS_POLLHUP
+#define ZVFS_EPOLLONESHOT BIT(30)
+
+#define ZVFS_EPOLL_CTL_ADD 1
+#define ZVFS_EPOLL_CTL_DEL 2
+#define ZVFS_EPOLL_CTL_MOD 3
+
+/** User data returned with the events of a file descriptor */
+typedef union zvfs_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zvfs_epoll_data_t;
+
+/** Events of interest, or reported events, of a file descriptor */
+struct zvfs_epoll_event {
+	/** Bitwise-ORed ZVFS_EPOLL* flags */
+	uint32_t events;
+	/** User data */
+	zvfs_epoll_data_t data;
+};
+
+/**
+ * @brief Create a ZVFS epoll instance
+ *
+ * An epoll instance holds a set of file descriptors together with the events
+ * they are watched for. Unlike @ref zvfs_poll, which registers every file
+ * descriptor on each call, an epoll instance registers a file descriptor once
+ * and queues it on a ready list when it becomes ready, so that the cost of
+ * @ref zvfs_epoll_wait depends on the number of ready file descriptors only.
+ *
+ * File descriptors are watched in level-triggered mode: a file descriptor
+ * is reported by every call to @ref zvfs_epoll_wait for as long as it is
+ * ready, unless it was added with @ref ZVFS_EPOLLONESHOT.
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int zvfs_epoll_create(void);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * Closing a file descriptor removes it from all epoll instances.
+ *
+ * @param epfd Epoll file descriptor
+ * @param op One of ZVFS_EPOLL_CTL_ADD, ZVFS_EPOLL_CTL_MOD or ZVFS_EPOLL_CTL_DEL
+ * @param fd File descriptor to watch, which must support @ref zvfs_poll
+ * @param event Events of interest and user data, ignored for ZVFS_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event);
+
+/**
+ * @brief Wait for file descriptors of an epoll instance to become ready
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Array filled with the ready file descriptors' events and data
+ * @param maxevents Size of @p events
+ * @param timeout Timeout in milliseconds, negative to wait forever
+ *
+ * @return Number of entries filled in @p events, 0 on timeout, -1 on error
+ */
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout);
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Called by zvfs_close() before a file descriptor is closed */
+void zvfs_epoll_fd_closed(int fd);
+
+/** @endcond */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_ZVFS_EPOLL_H_ */
@@ -27,7 +27,11 @@ extern "C" {
 
 static inline void z_init_timeout(struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	to->dticks = 0;
+#else
 	sys_dnode_init(&to->node);
+#endif
 }
 
 /* Adds the timeout to the queue.
@@ -40,7 +44,14 @@ int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Queued timeouts hold their absolute expiry tick, which is
+	 * always positive.
+	 */
+	return to->dticks <= 0;
+#else
 	return !sys_dnode_is_linked(&to->node);
+#endif
 }
 
 static inline bool z_is_aborted_timeout(const struct _timeout *to)
@@ -201,3 +201,43 @@ void k_heap_free(struct k_heap *heap, void *mem)
 		k_spin_unlock(&heap->lock, key);
 	}
 }
+
+int k_heap_alloc_bulk(struct k_heap *heap, size_t bytes, void **mem, size_t count,
+		      k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret;
+
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	while (true) {
+		ret = sys_heap_alloc_bulk(&heap->heap, bytes, mem, count);
+
+		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
+		    (ret == 0) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			break;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		(void) z_pend_curr(&heap->lock, key, &heap->wait_q, timeout);
+		key = k_spin_lock(&heap->lock);
+	}
+
+	k_spin_unlock(&heap->lock, key);
+	return ret;
+}
+
+void k_heap_free_bulk(struct k_heap *heap, void **mem, size_t count)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+
+	sys_heap_free_bulk(&heap->heap, mem, count);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_unpend_all(&heap->wait_q) != 0)) {
+		z_reschedule(&heap->lock, key);
+	} else {
+		k_spin_unlock(&heap->lock, key);
+	}
+}
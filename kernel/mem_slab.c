@@ -18,6 +18,23 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Blocks moved between a CPU cache and the slab's free list at a time */
+#define CPU_CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/* Free blocks currently held in the CPU caches, for statistics only */
+static uint32_t cpu_cache_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t num_cached = 0U;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		num_cached += slab->cpu_cache[i].count;
+	}
+
+	return num_cached;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +50,18 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_info *info = stats;
+
+	info->num_cached = 0U;
+	info->cache_hits = 0U;
+	info->cache_misses = 0U;
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		info->num_cached += slab->cpu_cache[i].count;
+		info->cache_hits += slab->cpu_cache[i].hits;
+		info->cache_misses += slab->cpu_cache[i].misses;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -51,6 +80,12 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
 			  slab->info.block_size;
 	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	uint32_t num_cached = cpu_cache_num_cached(slab);
+
+	ptr->free_bytes += num_cached * slab->info.block_size;
+	ptr->allocated_bytes -= num_cached * slab->info.block_size;
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -75,6 +110,13 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		slab->cpu_cache[i].hits = 0U;
+		slab->cpu_cache[i].misses = 0U;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -179,6 +221,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	slab->cache_waiters = ATOMIC_INIT(0);
+	memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -218,13 +265,143 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/*
+ * Each CPU cache is only ever filled and emptied by its own CPU, so its lock
+ * is uncontended except when cpu_cache_drain() runs. Cache locks are taken
+ * before the slab lock.
+ */
+
+/**
+ * @brief Allocate a block from the current CPU's cache
+ *
+ * An empty cache is first refilled with a batch of blocks from the slab.
+ *
+ * @return Block, or NULL if neither the cache nor the slab has one.
+ */
+static void *cpu_cache_alloc(struct k_mem_slab *slab)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	void *mem = NULL;
+
+	if (cache->count == 0U) {
+		cache->misses++;
+
+		K_SPINLOCK(&slab->lock) {
+			while ((cache->count < CPU_CACHE_BATCH) && (slab->free_list != NULL)) {
+				cache->blocks[cache->count] = slab->free_list;
+				cache->count++;
+				slab->free_list = *(char **)(slab->free_list);
+				slab->info.num_used++;
+			}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+			slab->info.max_used = MAX(slab->info.num_used,
+						  slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+		}
+	} else {
+		cache->hits++;
+	}
+
+	if (cache->count > 0U) {
+		cache->count--;
+		mem = cache->blocks[cache->count];
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return mem;
+}
+
+/**
+ * @brief Free a block to the current CPU's cache
+ *
+ * A full cache is first flushed of a batch of blocks back to the slab.
+ *
+ * @return true if the block was cached, false if threads may be waiting
+ *	   for a block, in which case the caller must free it to the slab.
+ */
+static bool cpu_cache_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int irq_key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&cache->lock);
+	bool cached = false;
+
+	/* Checked with the cache locked, so that a thread about to wait
+	 * either sees the block in cpu_cache_drain() or is seen here.
+	 */
+	if (atomic_get(&slab->cache_waiters) == 0) {
+		if (cache->count == CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+			K_SPINLOCK(&slab->lock) {
+				while (cache->count > CPU_CACHE_BATCH) {
+					cache->count--;
+					*(char **)cache->blocks[cache->count] = slab->free_list;
+					slab->free_list = cache->blocks[cache->count];
+					slab->info.num_used--;
+				}
+			}
+		}
+
+		cache->blocks[cache->count] = mem;
+		cache->count++;
+		cached = true;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	return cached;
+}
+
+/* Returns the blocks held in all CPU caches to the slab */
+static void cpu_cache_drain(struct k_mem_slab *slab)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+
+		K_SPINLOCK(&cache->lock) {
+			K_SPINLOCK(&slab->lock) {
+				while (cache->count > 0U) {
+					cache->count--;
+					*(char **)cache->blocks[cache->count] = slab->free_list;
+					slab->free_list = cache->blocks[cache->count];
+					slab->info.num_used--;
+				}
+			}
+		}
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool may_wait = !K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+
+	*mem = cpu_cache_alloc(slab);
+	if (*mem != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+
+	/* Free blocks may still be cached by other CPUs */
+	if (may_wait) {
+		atomic_inc(&slab->cache_waiters);
+	}
+	cpu_cache_drain(slab);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
-
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -255,6 +432,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		atomic_dec(&slab->cache_waiters);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
@@ -264,6 +445,12 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	k_spin_unlock(&slab->lock, key);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (may_wait) {
+		atomic_dec(&slab->cache_waiters);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	return result;
 }
 
@@ -275,6 +462,15 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cpu_cache_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -310,6 +506,12 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
 	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
 			    slab->info.block_size;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	uint32_t num_cached = cpu_cache_num_cached(slab);
+
+	stats->allocated_bytes -= num_cached * slab->info.block_size;
+	stats->free_bytes += num_cached * slab->info.block_size;
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -26,19 +26,44 @@
 #include <zephyr/sys/__assert.h>
 #include <stdbool.h>
 
-/* Single subsystem lock.  Locking per-event would be better on highly
- * contended SMP systems, but the original locking scheme here is
- * subtle (it relies on releasing/reacquiring the lock in areas for
- * latency control and it's sometimes hard to see exactly what data is
- * "inside" a given critical section).  Do the synchronization port
- * later as an optimization.
+/* Lock striping.  Instead of a single subsystem lock, two arrays of
+ * spinlocks are indexed by a hash of the address of what they protect:
+ *
+ * - An object lock protects the poll_events list of a kernel object,
+ *   and the poller and state of the events linked into it.  It is held
+ *   while checking whether the object is ready and registering an event
+ *   on it, as well as while signaling an event dequeued from it, which
+ *   closes the window between the two.
+ *
+ * - A poller lock protects the is_polling and mode fields of a poller,
+ *   and for triggered work the ownership of the work item.  It is held
+ *   when the polling thread decides to pend, and when a signaler wakes
+ *   it up, so that a wakeup cannot fall between the two.
+ *
+ * An object lock may be taken before a poller lock, never the reverse.
+ * Pollers of unrelated objects thus hardly ever contend with each other.
  */
-static struct k_spinlock lock;
+static struct k_spinlock obj_locks[CONFIG_POLL_LOCK_STRIPES];
+static struct k_spinlock poller_locks[CONFIG_POLL_LOCK_STRIPES];
+
+static inline struct k_spinlock *stripe(struct k_spinlock *locks, const void *ptr)
+{
+	/* Fibonacci hashing, objects are rarely less than 8 bytes apart */
+	uint32_t hash = (uint32_t)((uintptr_t)ptr >> 3) * 0x9e3779b1U;
+
+	return &locks[(hash >> 16) % CONFIG_POLL_LOCK_STRIPES];
+}
+
+static inline struct k_spinlock *poller_lock(struct z_poller *poller)
+{
+	return stripe(poller_locks, poller);
+}
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_WATCH };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_watch(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -136,31 +161,25 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 	sys_dlist_append(events, &event->_node);
 }
 
-/* must be called with interrupts locked */
-static inline void register_event(struct k_poll_event *event,
-				 struct z_poller *poller)
+/* returns the list of the polled object, NULL if there is none */
+static inline sys_dlist_t *event_list(struct k_poll_event *event)
 {
 	switch (event->type) {
 	case K_POLL_TYPE_SEM_AVAILABLE:
 		__ASSERT(event->sem != NULL, "invalid semaphore\n");
-		add_event(&event->sem->poll_events, event, poller);
-		break;
+		return &event->sem->poll_events;
 	case K_POLL_TYPE_DATA_AVAILABLE:
 		__ASSERT(event->queue != NULL, "invalid queue\n");
-		add_event(&event->queue->poll_events, event, poller);
-		break;
+		return &event->queue->poll_events;
 	case K_POLL_TYPE_SIGNAL:
 		__ASSERT(event->signal != NULL, "invalid poll signal\n");
-		add_event(&event->signal->poll_events, event, poller);
-		break;
+		return &event->signal->poll_events;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
-		add_event(&event->msgq->poll_events, event, poller);
-		break;
+		return &event->msgq->poll_events;
 	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
 		__ASSERT(event->pipe != NULL, "invalid pipe\n");
-		add_event(&event->pipe->poll_events, event, poller);
-		break;
+		return &event->pipe->poll_events;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -169,58 +188,47 @@ static inline void register_event(struct k_poll_event *event,
 		break;
 	}
 
+	return NULL;
+}
+
+static inline struct k_spinlock *event_lock(struct k_poll_event *event)
+{
+	return stripe(obj_locks, event_list(event));
+}
+
+/* must be called with the object lock of the event held */
+static inline void register_event(struct k_poll_event *event,
+				 struct z_poller *poller)
+{
+	sys_dlist_t *events = event_list(event);
+
+	if (events != NULL) {
+		add_event(events, event, poller);
+	}
+
 	event->poller = poller;
 }
 
-/* must be called with interrupts locked */
+/* must be called with the object lock of the event held */
 static inline void clear_event_registration(struct k_poll_event *event)
 {
-	bool remove_event = false;
-
 	event->poller = NULL;
 
-	switch (event->type) {
-	case K_POLL_TYPE_SEM_AVAILABLE:
-		__ASSERT(event->sem != NULL, "invalid semaphore\n");
-		remove_event = true;
-		break;
-	case K_POLL_TYPE_DATA_AVAILABLE:
-		__ASSERT(event->queue != NULL, "invalid queue\n");
-		remove_event = true;
-		break;
-	case K_POLL_TYPE_SIGNAL:
-		__ASSERT(event->signal != NULL, "invalid poll signal\n");
-		remove_event = true;
-		break;
-	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		__ASSERT(event->msgq != NULL, "invalid message queue\n");
-		remove_event = true;
-		break;
-	case K_POLL_TYPE_PIPE_DATA_AVAILABLE:
-		__ASSERT(event->pipe != NULL, "invalid pipe\n");
-		remove_event = true;
-		break;
-	case K_POLL_TYPE_IGNORE:
-		/* nothing to do */
-		break;
-	default:
-		__ASSERT(false, "invalid event type\n");
-		break;
-	}
-	if (remove_event && sys_dnode_is_linked(&event->_node)) {
+	if (event_list(event) != NULL && sys_dnode_is_linked(&event->_node)) {
 		sys_dlist_remove(&event->_node);
 	}
 }
 
-/* must be called with interrupts locked */
+/* must be called without the poller lock held */
 static inline void clear_event_registrations(struct k_poll_event *events,
-					      int num_events,
-					      k_spinlock_key_t key)
+					      int num_events)
 {
 	while (num_events--) {
+		struct k_spinlock *lock = event_lock(&events[num_events]);
+		k_spinlock_key_t key = k_spin_lock(lock);
+
 		clear_event_registration(&events[num_events]);
-		k_spin_unlock(&lock, key);
-		key = k_spin_lock(&lock);
+		k_spin_unlock(lock, key);
 	}
 }
 
@@ -238,10 +246,11 @@ static inline int register_events(struct k_poll_event *events,
 	int events_registered = 0;
 
 	for (int ii = 0; ii < num_events; ii++) {
+		struct k_spinlock *lock = event_lock(&events[ii]);
 		k_spinlock_key_t key;
 		uint32_t state;
 
-		key = k_spin_lock(&lock);
+		key = k_spin_lock(lock);
 		if (is_condition_met(&events[ii], &state)) {
 			set_event_ready(&events[ii], state);
 			poller->is_polling = false;
@@ -255,7 +264,7 @@ static inline int register_events(struct k_poll_event *events,
 			 */
 			;
 		}
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
 	}
 
 	return events_registered;
@@ -290,6 +299,7 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	int events_registered;
 	k_spinlock_key_t key;
 	struct z_poller *poller = &_current->poller;
+	struct k_spinlock *lock = poller_lock(poller);
 
 	poller->is_polling = true;
 	poller->mode = MODE_POLL;
@@ -303,7 +313,7 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	events_registered = register_events(events, num_events, poller,
 					    K_TIMEOUT_EQ(timeout, K_NO_WAIT));
 
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(lock);
 
 	/*
 	 * If we're not polling anymore, it means that at least one event
@@ -311,8 +321,8 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	 * because one of the events registered has had its state changed.
 	 */
 	if (!poller->is_polling) {
-		clear_event_registrations(events, events_registered, key);
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
+		clear_event_registrations(events, events_registered);
 
 		SYS_PORT_TRACING_FUNC_EXIT(k_poll_api, poll, events, 0);
 
@@ -322,7 +332,7 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	poller->is_polling = false;
 
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
 
 		SYS_PORT_TRACING_FUNC_EXIT(k_poll_api, poll, events, -EAGAIN);
 
@@ -331,7 +341,7 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 
 	static _wait_q_t wait_q = Z_WAIT_Q_INIT(&wait_q);
 
-	int swap_rc = z_pend_curr(&lock, key, &wait_q, timeout);
+	int swap_rc = z_pend_curr(lock, key, &wait_q, timeout);
 
 	/*
 	 * Clear all event registrations. If events happen while we're in this
@@ -342,9 +352,7 @@ int z_impl_k_poll(struct k_poll_event *events, int num_events,
 	 * added to the list of events that occurred, the user has to check the
 	 * return code first, which invalidates the whole list of event states.
 	 */
-	key = k_spin_lock(&lock);
-	clear_event_registrations(events, events_registered, key);
-	k_spin_unlock(&lock, key);
+	clear_event_registrations(events, events_registered);
 
 	SYS_PORT_TRACING_FUNC_EXIT(k_poll_api, poll, events, swap_rc);
 
@@ -356,6 +364,7 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 				int num_events, k_timeout_t timeout)
 {
 	int ret;
+	struct k_spinlock *lock;
 	k_spinlock_key_t key;
 	struct k_poll_event *events_copy = NULL;
 	uint32_t bounds;
@@ -380,13 +389,14 @@ static inline int z_vrfy_k_poll(struct k_poll_event *events,
 		goto out;
 	}
 
-	key = k_spin_lock(&lock);
+	lock = poller_lock(&_current->poller);
+	key = k_spin_lock(lock);
 	if (K_SYSCALL_MEMORY_WRITE(events, bounds)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
 		goto oops_free;
 	}
 	(void)memcpy(events_copy, events, bounds);
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(lock, key);
 
 	/* Validate what's inside events_copy */
 	for (int i = 0; i < num_events; i++) {
@@ -434,23 +444,29 @@ oops_free:
 #include <zephyr/syscalls/k_poll_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-/* must be called with interrupts locked */
+/* must be called with the object lock of the event held */
 static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 {
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
 	if (poller != NULL) {
+		struct k_spinlock *lock = poller_lock(poller);
+		k_spinlock_key_t key = k_spin_lock(lock);
+
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
+		} else if (poller->mode == MODE_WATCH) {
+			retcode = signal_watch(event, state);
 		} else {
 			/* Poller is not poll or triggered mode. No action needed.*/
 			;
 		}
 
 		poller->is_polling = false;
+		k_spin_unlock(lock, key);
 
 		if (retcode < 0) {
 			return retcode;
@@ -464,14 +480,15 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 bool z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_spinlock *lock = stripe(obj_locks, events);
+	k_spinlock_key_t key = k_spin_lock(lock);
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
 	if (poll_event != NULL) {
 		(void) signal_poll_event(poll_event, state);
 	}
 
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(lock, key);
 
 	return (poll_event != NULL);
 }
@@ -525,7 +542,8 @@ void z_vrfy_k_poll_signal_check(struct k_poll_signal *sig,
 
 int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_spinlock *lock = stripe(obj_locks, &sig->poll_events);
+	k_spinlock_key_t key = k_spin_lock(lock);
 	struct k_poll_event *poll_event;
 
 	sig->result = result;
@@ -533,7 +551,7 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 
 	poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events);
 	if (poll_event == NULL) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
 
 		SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, 0);
 
@@ -544,7 +562,7 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 
 	SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, rc);
 
-	z_reschedule(&lock, key);
+	z_reschedule(lock, key);
 	return rc;
 }
 
@@ -576,12 +594,7 @@ static void triggered_work_handler(struct k_work *work)
 	 * already cleared event registrations.
 	 */
 	if (twork->poller.mode != MODE_NONE) {
-		k_spinlock_key_t key;
-
-		key = k_spin_lock(&lock);
-		clear_event_registrations(twork->events,
-					  twork->num_events, key);
-		k_spin_unlock(&lock, key);
+		clear_event_registrations(twork->events, twork->num_events);
 	}
 
 	/* Drop work ownership and execute real handler. */
@@ -619,9 +632,12 @@ static int signal_triggered_work(struct k_poll_event *event, uint32_t status)
 	return 0;
 }
 
+/* must be called with the poller lock of the work held, releases it meanwhile */
 static int triggered_work_cancel(struct k_work_poll *work,
 				 k_spinlock_key_t key)
 {
+	struct k_spinlock *lock = poller_lock(&work->poller);
+
 	/* Check if the work waits for event. */
 	if (work->poller.is_polling && work->poller.mode != MODE_NONE) {
 		/* Remove timeout associated with the work. */
@@ -634,7 +650,9 @@ static int triggered_work_cancel(struct k_work_poll *work,
 		work->poller.mode = MODE_NONE;
 
 		/* Clear registrations and work ownership. */
-		clear_event_registrations(work->events, work->num_events, key);
+		k_spin_unlock(lock, key);
+		clear_event_registrations(work->events, work->num_events);
+		key = k_spin_lock(lock);
 		work->workq = NULL;
 		return 0;
 	}
@@ -669,6 +687,7 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 				k_timeout_t timeout)
 {
 	int events_registered;
+	struct k_spinlock *lock = poller_lock(&work->poller);
 	k_spinlock_key_t key;
 
 	__ASSERT(work_q != NULL, "NULL work_q\n");
@@ -679,14 +698,14 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 	SYS_PORT_TRACING_FUNC_ENTER(k_work_poll, submit_to_queue, work_q, work, timeout);
 
 	/* Take ownership of the work if it is possible. */
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(lock);
 	if (work->workq != NULL) {
 		if (work->workq == work_q) {
 			int retval;
 
 			retval = triggered_work_cancel(work, key);
 			if (retval < 0) {
-				k_spin_unlock(&lock, key);
+				k_spin_unlock(lock, key);
 
 				SYS_PORT_TRACING_FUNC_EXIT(k_work_poll, submit_to_queue, work_q,
 					work, timeout, retval);
@@ -694,7 +713,7 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 				return retval;
 			}
 		} else {
-			k_spin_unlock(&lock, key);
+			k_spin_unlock(lock, key);
 
 			SYS_PORT_TRACING_FUNC_EXIT(k_work_poll, submit_to_queue, work_q,
 				work, timeout, -EADDRINUSE);
@@ -707,7 +726,7 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 	work->poller.is_polling = true;
 	work->workq = work_q;
 	work->poller.mode = MODE_NONE;
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(lock, key);
 
 	/* Save list of events. */
 	work->events = events;
@@ -720,7 +739,7 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 	events_registered = register_events(events, num_events,
 					    &work->poller, false);
 
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(lock);
 	if (work->poller.is_polling && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/*
 		 * Poller is still polling.
@@ -738,7 +757,7 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 
 		/* From now, any event will result in submitted work. */
 		work->poller.mode = MODE_TRIGGERED;
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(lock, key);
 
 		SYS_PORT_TRACING_FUNC_EXIT(k_work_poll, submit_to_queue, work_q, work, timeout, 0);
 
@@ -763,9 +782,10 @@ int k_work_poll_submit_to_queue(struct k_work_q *work_q,
 		work->poll_result = 0;
 	}
 
+	k_spin_unlock(lock, key);
+
 	/* Clear registrations. */
-	clear_event_registrations(events, events_registered, key);
-	k_spin_unlock(&lock, key);
+	clear_event_registrations(events, events_registered);
 
 	/* Submit work. */
 	k_work_submit_to_queue(work_q, &work->work);
@@ -792,6 +812,7 @@ int k_work_poll_submit(struct k_work_poll *work,
 
 int k_work_poll_cancel(struct k_work_poll *work)
 {
+	struct k_spinlock *lock;
 	k_spinlock_key_t key;
 	int retval;
 
@@ -804,11 +825,65 @@ int k_work_poll_cancel(struct k_work_poll *work)
 		return -EINVAL;
 	}
 
-	key = k_spin_lock(&lock);
+	lock = poller_lock(&work->poller);
+	key = k_spin_lock(lock);
 	retval = triggered_work_cancel(work, key);
-	k_spin_unlock(&lock, key);
+	k_spin_unlock(lock, key);
 
 	SYS_PORT_TRACING_FUNC_EXIT(k_work_poll, cancel, work, retval);
 
 	return retval;
 }
+
+void k_poll_watch_init(struct k_poll_watch *watch, k_poll_watch_cb_t cb)
+{
+	__ASSERT(watch != NULL, "NULL watch\n");
+	__ASSERT(cb != NULL, "NULL callback\n");
+
+	watch->poller.is_polling = false;
+	watch->poller.mode = MODE_WATCH;
+	watch->cb = cb;
+}
+
+void k_poll_watch_add(struct k_poll_watch *watch, struct k_poll_event *events,
+		      int num_events)
+{
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(num_events >= 0, "<0 events\n");
+
+	for (int ii = 0; ii < num_events; ii++) {
+		struct k_spinlock *lock = event_lock(&events[ii]);
+		k_spinlock_key_t key;
+		uint32_t state;
+
+		key = k_spin_lock(lock);
+		if (is_condition_met(&events[ii], &state)) {
+			set_event_ready(&events[ii], state);
+			watch->cb(watch, &events[ii]);
+		} else {
+			register_event(&events[ii], &watch->poller);
+		}
+		k_spin_unlock(lock, key);
+	}
+}
+
+void k_poll_watch_remove(struct k_poll_watch *watch, struct k_poll_event *events,
+			 int num_events)
+{
+	ARG_UNUSED(watch);
+
+	clear_event_registrations(events, num_events);
+}
+
+/* must be called with the object lock of the event held */
+static int signal_watch(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_watch *watch =
+		CONTAINER_OF(event->poller, struct k_poll_watch, poller);
+
+	/* The event was dequeued from the object, it only fires once */
+	set_event_ready(event, state);
+	watch->cb(watch, event);
+
+	return 0;
+}
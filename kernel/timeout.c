@@ -11,11 +11,10 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/barrier.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
  * shall it call any other subsystem while holding this lock.
@@ -40,6 +39,205 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/* Queued timeouts are kept in a red/black tree keyed on their absolute
+ * expiry tick (stored in dticks), with a monotonically increasing
+ * order_key as tie-breaker so that timeouts expiring on the same tick
+ * fire in the order they were added, as with the delta list.
+ */
+static bool timeout_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	struct _timeout *ta = CONTAINER_OF(a, struct _timeout, node);
+	struct _timeout *tb = CONTAINER_OF(b, struct _timeout, node);
+
+	if (ta->dticks != tb->dticks) {
+		return ta->dticks < tb->dticks;
+	}
+
+	return (int32_t)(ta->order_key - tb->order_key) < 0;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+/* Each CPU keeps the timeouts it arms in its own tree, protected by its
+ * own lock, so that arming and aborting timeouts on different CPUs does
+ * not contend.  timeout_lock still serializes updates of the tick
+ * bookkeeping (curr_tick, announce_remaining and next_deadline) and may be
+ * held while taking a queue lock, never the other way around.  Code that
+ * only needs to read the bookkeeping samples it locklessly through
+ * tick_seq instead of taking timeout_lock.
+ */
+struct timeout_queue {
+	struct k_spinlock lock;
+	struct rbtree tree;
+	uint32_t order_key;
+
+	/* Expiry tick of the first timeout, published under head_seq so that
+	 * scans for the earliest queue need not take every queue lock.
+	 */
+	atomic_t head_seq;
+	k_ticks_t head_expiry;
+	bool has_head;
+};
+
+static struct timeout_queue timeout_queues[CONFIG_MP_MAX_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_MAX_NUM_CPUS - 1)] = {
+		.tree = {
+			.lessthan_fn = timeout_lessthan,
+		},
+	},
+};
+
+/* Absolute tick by which the system timer will have announced, i.e.
+ * timeouts expiring at or after it need not reprogram the timer.
+ */
+static uint64_t next_deadline = UINT64_MAX;
+
+/* Odd while the tick bookkeeping is being updated */
+static atomic_t tick_seq;
+
+struct tick_snapshot {
+	atomic_val_t seq;
+	uint64_t curr_tick;
+	uint64_t next_deadline;
+	int32_t elapsed;
+	bool announcing;
+};
+
+/* must be locked */
+static void tick_update_begin(void)
+{
+	atomic_inc(&tick_seq);
+}
+
+/* must be locked */
+static void tick_update_end(void)
+{
+	atomic_inc(&tick_seq);
+}
+
+static bool tick_snapshot_stale(const struct tick_snapshot *snap)
+{
+	barrier_dmem_fence_full();
+
+	return atomic_get(&tick_seq) != snap->seq;
+}
+
+static struct _timeout *queue_first(struct timeout_queue *q)
+{
+	struct rbnode *n = rb_get_min(&q->tree);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Publishes the expiry of the first timeout, the queue must be locked */
+static void queue_head_update(struct timeout_queue *q)
+{
+	struct _timeout *t = queue_first(q);
+
+	atomic_inc(&q->head_seq);
+	q->has_head = (t != NULL);
+	q->head_expiry = (t != NULL) ? t->dticks : 0;
+	atomic_inc(&q->head_seq);
+}
+
+/* Reads the expiry of the first timeout without taking the queue lock */
+static bool queue_head_get(struct timeout_queue *q, k_ticks_t *expiry)
+{
+	atomic_val_t seq;
+	bool has_head;
+
+	do {
+		seq = atomic_get(&q->head_seq);
+		has_head = q->has_head;
+		*expiry = q->head_expiry;
+		barrier_dmem_fence_full();
+	} while (((seq & 1) != 0) || (atomic_get(&q->head_seq) != seq));
+
+	return has_head;
+}
+
+/* Finds the queue holding the earliest timeout and its expiry tick.
+ * Must be locked.  The queue heads are read without their locks, so the
+ * caller must check the head again under the lock of the queue found.
+ */
+static struct timeout_queue *earliest_queue(k_ticks_t *expiry)
+{
+	struct timeout_queue *ret = NULL;
+	k_ticks_t head;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+
+		if (queue_head_get(q, &head) && ((ret == NULL) || (head < *expiry))) {
+			*expiry = head;
+			ret = q;
+		}
+	}
+
+	return ret;
+}
+
+#else
+
+static struct rbtree timeout_tree = {
+	.lessthan_fn = timeout_lessthan,
+};
+
+static uint32_t timeout_order_key;
+
+static struct _timeout *first(void)
+{
+	struct rbnode *n = rb_get_min(&timeout_tree);
+
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+/* Ticks from curr_tick until the head of the queue expires */
+static k_ticks_t head_dticks(const struct _timeout *t)
+{
+	return t->dticks - (k_ticks_t)curr_tick;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	to->dticks = (k_ticks_t)curr_tick + dticks;
+	to->order_key = timeout_order_key++;
+	rb_insert(&timeout_tree, &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	rb_remove(&timeout_tree, &t->node);
+}
+
+/* Removes the expiring head of the queue, curr_tick already points to it */
+static void remove_expired(struct _timeout *t)
+{
+	remove_timeout(t);
+	t->dticks = 0;
+}
+
+/* Applies ticks announced past the last expired timeout */
+static void consume_ticks(int32_t ticks)
+{
+	/* Expiries are absolute, advancing curr_tick is enough */
+	ARG_UNUSED(ticks);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return timeout->dticks - (k_ticks_t)curr_tick;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
+#else
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -54,6 +252,32 @@ static struct _timeout *next(struct _timeout *t)
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Ticks from curr_tick until the head of the queue expires */
+static k_ticks_t head_dticks(const struct _timeout *t)
+{
+	return t->dticks;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -63,6 +287,41 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Removes the expiring head of the queue, curr_tick already points to it */
+static void remove_expired(struct _timeout *t)
+{
+	/* The next timeout is already relative to this one */
+	t->dticks = 0;
+	remove_timeout(t);
+}
+
+/* Applies ticks announced past the last expired timeout */
+static void consume_ticks(int32_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -84,16 +343,297 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+
+static void tick_snapshot_get(struct tick_snapshot *snap)
+{
+	do {
+		snap->seq = atomic_get(&tick_seq);
+		if ((snap->seq & 1) != 0) {
+			continue;
+		}
+
+		snap->curr_tick = curr_tick;
+		snap->next_deadline = next_deadline;
+		snap->announcing = (announce_remaining != 0);
+		snap->elapsed = elapsed();
+	} while (((snap->seq & 1) != 0) || tick_snapshot_stale(snap));
+}
+
+/* must be locked */
+static int32_t next_timeout(int32_t ticks_elapsed)
+{
+	k_ticks_t expiry = 0;
+	int32_t ret;
+
+	if ((earliest_queue(&expiry) == NULL) ||
+	    ((int64_t)(expiry - (k_ticks_t)curr_tick - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, expiry - (k_ticks_t)curr_tick - ticks_elapsed);
+	}
+
+	return ret;
+}
+
+/* Must be locked and called between tick_update_begin() and
+ * tick_update_end(), so that lockless readers either see the new deadline
+ * or retry, and every timeout queued before the scan is accounted for.
+ */
+static int32_t update_deadline(int32_t ticks_elapsed)
+{
+	int32_t next = next_timeout(ticks_elapsed);
+
+	next_deadline = (next == K_TICKS_FOREVER) ? UINT64_MAX
+						  : curr_tick + ticks_elapsed + next;
+
+	return next;
+}
+
+/* Removes the earliest timeout expiring within ticks of curr_tick, setting
+ * dt to its offset from curr_tick.  Must be locked.
+ */
+static struct _timeout *pop_expired(int32_t ticks, int32_t *dt)
+{
+	struct timeout_queue *q;
+	struct _timeout *t = NULL;
+	k_ticks_t expiry = 0;
+
+	while ((t == NULL) && ((q = earliest_queue(&expiry)) != NULL) &&
+	       (expiry - (k_ticks_t)curr_tick <= ticks)) {
+		/* The head may have been aborted since the scan, look again */
+		K_SPINLOCK(&q->lock) {
+			t = queue_first(q);
+			if ((t != NULL) && (t->dticks - (k_ticks_t)curr_tick <= ticks)) {
+				*dt = MAX(0, t->dticks - (k_ticks_t)curr_tick);
+				rb_remove(&q->tree, &t->node);
+				queue_head_update(q);
+				t->dticks = 0;
+			} else {
+				t = NULL;
+			}
+		}
+	}
+
+	return t;
+}
+
+k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	struct tick_snapshot now;
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	k_ticks_t expiry;
+	k_ticks_t ticks;
+	bool is_first;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return 0;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(z_is_inactive_timeout(to), "");
+	to->fn = fn;
+
+	tick_snapshot_get(&now);
+
+	if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
+		ticks = now.curr_tick + timeout.ticks + 1 + now.elapsed;
+		expiry = ticks;
+	} else {
+		expiry = now.curr_tick + MAX(1, Z_TICK_ABS(timeout.ticks) - now.curr_tick);
+		ticks = timeout.ticks;
+	}
+
+	/* Queue on the current CPU, which must not change under us */
+	irq_key = arch_irq_lock();
+	q = &timeout_queues[_current_cpu->id];
+	key = k_spin_lock(&q->lock);
+
+	to->cpu = _current_cpu->id;
+	to->dticks = expiry;
+	to->order_key = q->order_key++;
+	rb_insert(&q->tree, &to->node);
+	is_first = (to == queue_first(q));
+	if (is_first) {
+		queue_head_update(q);
+	}
+
+	k_spin_unlock(&q->lock, key);
+	arch_irq_unlock(irq_key);
+
+	/* The system timer only needs reprogramming if this timeout expires
+	 * before it is due to announce.  A running sys_clock_announce() or a
+	 * deadline update since the snapshot was taken may not have seen it,
+	 * so recheck under the lock in those cases too.
+	 */
+	if (is_first && (now.announcing || ((uint64_t)expiry < now.next_deadline) ||
+			 tick_snapshot_stale(&now))) {
+		K_SPINLOCK(&timeout_lock) {
+			if (announce_remaining == 0) {
+				int32_t next;
+
+				tick_update_begin();
+				next = update_deadline(elapsed());
+				tick_update_end();
+
+				sys_clock_set_timeout(next, false);
+			}
+		}
+	}
+
+	return ticks;
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	struct timeout_queue *q = &timeout_queues[to->cpu];
+	int ret = -EINVAL;
+
+	/* The system timer is left as is when aborting the first timeout,
+	 * sys_clock_announce() copes with finding nothing to expire.
+	 */
+	K_SPINLOCK(&q->lock) {
+		if (!z_is_inactive_timeout(to)) {
+			bool is_first = (to == queue_first(q));
+
+			rb_remove(&q->tree, &to->node);
+			if (is_first) {
+				queue_head_update(q);
+			}
+			to->dticks = TIMEOUT_DTICKS_ABORTED;
+			ret = 0;
+		}
+	}
+
+	return ret;
+}
+
+/* Returns the absolute expiry tick of a queued timeout, 0 if inactive */
+static k_ticks_t timeout_expiry(const struct _timeout *timeout)
+{
+	k_ticks_t expiry = 0;
+
+	K_SPINLOCK(&timeout_queues[timeout->cpu].lock) {
+		if (!z_is_inactive_timeout(timeout)) {
+			expiry = timeout->dticks;
+		}
+	}
+
+	return expiry;
+}
+
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_ticks_t expiry = timeout_expiry(timeout);
+	struct tick_snapshot now;
+
+	if (expiry == 0) {
+		return 0;
+	}
+
+	tick_snapshot_get(&now);
+
+	return expiry - (k_ticks_t)now.curr_tick - now.elapsed;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_ticks_t expiry = timeout_expiry(timeout);
+	struct tick_snapshot now;
+
+	if (expiry != 0) {
+		return expiry;
+	}
+
+	tick_snapshot_get(&now);
+
+	return now.curr_tick;
+}
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+
+	K_SPINLOCK(&timeout_lock) {
+		ret = next_timeout(elapsed());
+	}
+	return ret;
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	struct _timeout *t;
+	int32_t next;
+	int32_t dt;
+
+	/* We release the lock around the callbacks below, so someone
+	 * might be already running the loop.  Just increment the tick
+	 * count and return.
+	 */
+	if (announce_remaining != 0) {
+		tick_update_begin();
+		announce_remaining += ticks;
+		tick_update_end();
+		k_spin_unlock(&timeout_lock, key);
+		return;
+	}
+
+	tick_update_begin();
+	announce_remaining = ticks;
+	tick_update_end();
+
+	/* Timeouts are expired one at a time in expiry order across all
+	 * CPU queues, from the CPU the tick was announced on.  Finding the
+	 * next one reads the published queue heads, so each expiry takes a
+	 * single queue lock.
+	 */
+	while ((t = pop_expired(announce_remaining, &dt)) != NULL) {
+		tick_update_begin();
+		curr_tick += dt;
+		tick_update_end();
+
+		k_spin_unlock(&timeout_lock, key);
+		t->fn(t);
+		key = k_spin_lock(&timeout_lock);
+
+		tick_update_begin();
+		announce_remaining -= dt;
+		tick_update_end();
+	}
+
+	tick_update_begin();
+	curr_tick += announce_remaining;
+	announce_remaining = 0;
+	next = update_deadline(0);
+	tick_update_end();
+
+	sys_clock_set_timeout(next, false);
+
+	k_spin_unlock(&timeout_lock, key);
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+
+#else
+
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
 	struct _timeout *to = first();
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(head_dticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, head_dticks(to) - ticks_elapsed);
 	}
 
 	return ret;
@@ -111,38 +651,25 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif /* CONFIG_KERNEL_COHERENCE */
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t dticks;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
 			ticks_elapsed = elapsed();
 			has_elapsed = true;
-			to->dticks = timeout.ticks + 1 + ticks_elapsed;
-			ticks = curr_tick + to->dticks;
+			dticks = timeout.ticks + 1 + ticks_elapsed;
+			ticks = curr_tick + dticks;
 		} else {
-			k_ticks_t dticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, dticks);
+			dticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 			ticks = timeout.ticks;
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, dticks);
 
 		if (to == first() && announce_remaining == 0) {
 			if (!has_elapsed) {
@@ -163,7 +690,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			bool is_first = (to == first());
 
 			remove_timeout(to);
@@ -178,21 +705,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -251,13 +763,12 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (head_dticks(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = head_dticks(t);
 
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		remove_expired(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -265,9 +776,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	consume_ticks(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -281,13 +790,22 @@ void sys_clock_announce(int32_t ticks)
 #endif /* CONFIG_TIMESLICING */
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
+
 int64_t sys_clock_tick_get(void)
 {
 	uint64_t t = 0U;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct tick_snapshot now;
+
+	tick_snapshot_get(&now);
+	t = now.curr_tick + now.elapsed;
+#else
 	K_SPINLOCK(&timeout_lock) {
 		t = curr_tick + elapsed();
 	}
+#endif /* CONFIG_TIMEOUT_QUEUE_PER_CPU */
 	return t;
 }
 
@@ -6,6 +6,8 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_engine.h"
+
 uint16_t crc16(uint16_t poly, uint16_t seed, const uint8_t *src, size_t len)
 {
 	uint16_t crc = seed;
@@ -51,6 +53,9 @@ uint16_t crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src, size_t
 
 uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
+#if defined(CRC_TABLE_SLICES)
+	return crc16_slice_update(crc16_ccitt_slice_table, seed, src, len);
+#else
 	for (; len > 0; len--) {
 		uint8_t e, f;
 
@@ -61,6 +66,7 @@ uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
 
 uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
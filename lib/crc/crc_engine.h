@@ -0,0 +1,164 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Faster engines shared by the reflected CRC implementations: slice-by-4
+ * or slice-by-8 lookup tables, and the CRC instructions of some CPUs.
+ * The helpers operate on the raw CRC register, any initial value or final
+ * XOR is up to the caller.
+ */
+
+#ifndef ZEPHYR_LIB_CRC_CRC_ENGINE_H_
+#define ZEPHYR_LIB_CRC_CRC_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+#if defined(CONFIG_CRC_TABLE_SLICE_BY_8)
+#define CRC_TABLE_SLICES 8
+#elif defined(CONFIG_CRC_TABLE_SLICE_BY_4)
+#define CRC_TABLE_SLICES 4
+#endif
+
+#if defined(CRC_TABLE_SLICES)
+
+extern const uint32_t crc32_ieee_slice_table[CRC_TABLE_SLICES][256];
+extern const uint32_t crc32c_slice_table[CRC_TABLE_SLICES][256];
+extern const uint16_t crc16_ccitt_slice_table[CRC_TABLE_SLICES][256];
+
+static inline uint32_t crc32_slice_update(const uint32_t t[][256], uint32_t crc,
+					  const uint8_t *data, size_t len)
+{
+	while (len >= CRC_TABLE_SLICES) {
+		uint32_t a = crc ^ sys_get_le32(data);
+
+#if CRC_TABLE_SLICES == 8
+		uint32_t b = sys_get_le32(data + 4);
+
+		crc = t[7][a & 0xff] ^ t[6][(a >> 8) & 0xff] ^
+		      t[5][(a >> 16) & 0xff] ^ t[4][a >> 24] ^
+		      t[3][b & 0xff] ^ t[2][(b >> 8) & 0xff] ^
+		      t[1][(b >> 16) & 0xff] ^ t[0][b >> 24];
+#else
+		crc = t[3][a & 0xff] ^ t[2][(a >> 8) & 0xff] ^
+		      t[1][(a >> 16) & 0xff] ^ t[0][a >> 24];
+#endif
+		data += CRC_TABLE_SLICES;
+		len -= CRC_TABLE_SLICES;
+	}
+
+	for (; len > 0; len--) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+		data++;
+	}
+
+	return crc;
+}
+
+static inline uint16_t crc16_slice_update(const uint16_t t[][256], uint16_t crc,
+					  const uint8_t *data, size_t len)
+{
+	while (len >= CRC_TABLE_SLICES) {
+		uint16_t a = crc ^ sys_get_le16(data);
+
+#if CRC_TABLE_SLICES == 8
+		crc = t[7][a & 0xff] ^ t[6][a >> 8] ^ t[5][data[2]] ^ t[4][data[3]] ^
+		      t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+#else
+		crc = t[3][a & 0xff] ^ t[2][a >> 8] ^ t[1][data[2]] ^ t[0][data[3]];
+#endif
+		data += CRC_TABLE_SLICES;
+		len -= CRC_TABLE_SLICES;
+	}
+
+	for (; len > 0; len--) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+		data++;
+	}
+
+	return crc;
+}
+
+#endif /* CRC_TABLE_SLICES */
+
+#if defined(CONFIG_CRC_HW_INSTRUCTIONS) && defined(__ARM_FEATURE_CRC32)
+
+#include <arm_acle.h>
+
+#define CRC_HW_CRC32_IEEE 1
+#define CRC_HW_CRC32C 1
+
+/* The CRC32{B,W,D} and CRC32C{B,W,D} instructions, one macro per flavor */
+#define CRC_ARM_UPDATE(crc, data, len, b, w, d)                                                    \
+	do {                                                                                       \
+		while ((len > 0) && (((uintptr_t)data & 7) != 0)) {                                \
+			crc = b(crc, *data);                                                       \
+			data++;                                                                    \
+			len--;                                                                     \
+		}                                                                                  \
+		for (; len >= 8; len -= 8, data += 8) {                                            \
+			crc = d(crc, sys_get_le64(data));                                          \
+		}                                                                                  \
+		if (len >= 4) {                                                                    \
+			crc = w(crc, sys_get_le32(data));                                          \
+			data += 4;                                                                 \
+			len -= 4;                                                                  \
+		}                                                                                  \
+		for (; len > 0; len--, data++) {                                                   \
+			crc = b(crc, *data);                                                       \
+		}                                                                                  \
+	} while (false)
+
+static inline uint32_t crc32_ieee_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	CRC_ARM_UPDATE(crc, data, len, __crc32b, __crc32w, __crc32d);
+
+	return crc;
+}
+
+static inline uint32_t crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	CRC_ARM_UPDATE(crc, data, len, __crc32cb, __crc32cw, __crc32cd);
+
+	return crc;
+}
+
+#elif defined(CONFIG_CRC_HW_INSTRUCTIONS) && defined(__SSE4_2__)
+
+#include <nmmintrin.h>
+
+/* SSE4.2 only implements the Castagnoli polynomial */
+#define CRC_HW_CRC32C 1
+
+static inline uint32_t crc32c_hw_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+	while ((len > 0) && (((uintptr_t)data & 7) != 0)) {
+		crc = _mm_crc32_u8(crc, *data);
+		data++;
+		len--;
+	}
+
+#if defined(__x86_64__)
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = (uint32_t)_mm_crc32_u64(crc, sys_get_le64(data));
+	}
+#endif
+
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = _mm_crc32_u32(crc, sys_get_le32(data));
+	}
+
+	for (; len > 0; len--, data++) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+
+	return crc;
+}
+
+#endif /* CONFIG_CRC_HW_INSTRUCTIONS */
+
+#endif /* ZEPHYR_LIB_CRC_CRC_ENGINE_H_ */
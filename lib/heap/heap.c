@@ -160,6 +160,139 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Cached chunks stay marked used so that their neighbors do not merge
+ * with them, which hides a second free of them from the double-free
+ * assertion of sys_heap_free().  With assertions enabled they point
+ * back to themselves instead, and the class list is only walked to
+ * confirm a chunk freed with that mark is cached.
+ */
+#if __ASSERT_ON
+static bool size_class_cached(struct z_heap *h, struct z_heap_size_class *sc,
+			      chunkid_t c)
+{
+	if (prev_free_chunk(h, c) != c) {
+		return false;
+	}
+
+	for (chunkid_t n = sc->next; n != 0U; n = next_free_chunk(h, n)) {
+		if (n == c) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+static void size_class_push(struct z_heap *h, struct z_heap_size_class *sc,
+			    chunkid_t c)
+{
+#if __ASSERT_ON
+	set_prev_free_chunk(h, c, c);
+#endif
+	set_next_free_chunk(h, c, sc->next);
+	sc->next = c;
+	sc->count++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+}
+
+static chunkid_t size_class_pop(struct z_heap *h, struct z_heap_size_class *sc)
+{
+	chunkid_t c = sc->next;
+
+	CHECK(chunk_used(h, c));
+	sc->next = next_free_chunk(h, c);
+	sc->count--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+	return c;
+}
+
+/* Hands the chunks of a detached class list back to the heap */
+static void size_class_release(struct z_heap *h, chunkid_t c)
+{
+	while (c != 0U) {
+		chunkid_t next = next_free_chunk(h, c);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+		set_chunk_used(h, c, false);
+		free_chunk(h, c);
+		c = next;
+	}
+}
+
+/* Caches a freed chunk if it belongs to a size class.  Chunks with a
+ * free neighbor go back to the heap instead: caching those would
+ * pin a hole that free_chunk() could have merged, and fragmentation
+ * builds up quickly that way.  A full class first returns its older
+ * half to the heap, keeping the most recently freed (likely
+ * cache-hot) chunks at the head of the list.
+ */
+static bool size_class_free(struct z_heap *h, chunkid_t c)
+{
+	int idx = size_class_idx(h, chunk_size(h, c));
+
+	if (idx < 0) {
+		return false;
+	}
+
+	struct z_heap_size_class *sc = &size_classes(h)[idx];
+
+#if __ASSERT_ON
+	__ASSERT(!size_class_cached(h, sc, c),
+		 "unexpected heap state (double-free?) for memory at %p",
+		 chunk_mem(h, c));
+#endif
+
+	if (!chunk_used(h, left_chunk(h, c)) || !chunk_used(h, right_chunk(h, c))) {
+		return false;
+	}
+
+	if (sc->count >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH) {
+		chunkid_t last = sc->next;
+
+		for (int i = 1; i < CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH / 2; i++) {
+			last = next_free_chunk(h, last);
+		}
+		size_class_release(h, next_free_chunk(h, last));
+		set_next_free_chunk(h, last, 0);
+		sc->count = CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH / 2;
+	}
+
+	size_class_push(h, sc, c);
+	return true;
+}
+
+/* Returns every cached chunk to the heap so that they can merge with
+ * their neighbors again.  Returns true if anything was released.
+ */
+static bool size_class_drain(struct z_heap *h)
+{
+	bool drained = false;
+
+	for (int i = 0; i < nb_size_classes(h); i++) {
+		struct z_heap_size_class *sc = &size_classes(h)[i];
+
+		if (sc->count != 0U) {
+			size_class_release(h, sc->next);
+			sc->next = 0;
+			sc->count = 0;
+			drained = true;
+		}
+	}
+
+	return drained;
+}
+#endif
+
 void sys_heap_free(struct sys_heap *heap, void *mem)
 {
 	if (mem == NULL) {
@@ -184,7 +317,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +326,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (size_class_free(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -260,17 +399,67 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+static chunkid_t size_class_alloc(struct z_heap *h, chunksz_t sz)
+{
+	int idx = size_class_idx(h, sz);
+	chunkid_t c;
+
+	if (idx >= 0) {
+		struct z_heap_size_class *sc = &size_classes(h)[idx];
+
+		if (sc->next != 0U) {
+			return size_class_pop(h, sc);
+		}
+	}
+
+	/* Cached chunks must never make an allocation fail */
+	c = alloc_chunk(h, sz);
+	if ((c == 0U) && size_class_drain(h)) {
+		c = alloc_chunk(h, sz);
+	}
+
+	return c;
+}
+#endif
+
+/* Marks a chunk taken off the free lists as used and returns its memory */
+static void *alloc_chunk_mem(struct sys_heap *heap, chunkid_t c, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
 	void *mem;
 
+	set_chunk_used(h, c, true);
+
+	mem = chunk_mem(h, c);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+				   chunksz_to_bytes(h, chunk_size(h, c)));
+#endif
+
+	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+	return mem;
+}
+
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	struct z_heap *h = heap->heap;
+
 	if ((bytes == 0U) || size_too_big(h, bytes)) {
 		return NULL;
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	chunkid_t c = size_class_alloc(h, chunk_sz);
+#else
 	chunkid_t c = alloc_chunk(h, chunk_sz);
+#endif
 	if (c == 0U) {
 		return NULL;
 	}
@@ -281,21 +470,66 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 		free_list_add(h, c + chunk_sz);
 	}
 
-	set_chunk_used(h, c, true);
+	return alloc_chunk_mem(heap, c, bytes);
+}
 
-	mem = chunk_mem(h, c);
+void sys_heap_free_bulk(struct sys_heap *heap, void **mem, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		sys_heap_free(heap, mem[i]);
+	}
+}
 
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	increase_allocated_bytes(h, chunksz_to_bytes(h, chunk_size(h, c)));
-#endif
+int sys_heap_alloc_bulk(struct sys_heap *heap, size_t bytes, void **mem,
+			size_t count)
+{
+	struct z_heap *h = heap->heap;
 
-#ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
-#endif
+	if (count == 0U) {
+		return 0;
+	}
 
-	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
-	return mem;
+	if ((bytes == 0U) || size_too_big(h, bytes)) {
+		return -ENOMEM;
+	}
+
+	/* When the whole batch fits in one free block, a single bucket
+	 * search serves all of it and the block is simply cut up.
+	 */
+	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
+	chunkid_t c = 0;
+
+	if (count <= h->end_chunk / chunk_sz) {
+		c = alloc_chunk(h, chunk_sz * count);
+	}
+
+	if (c != 0U) {
+		chunksz_t batch_sz = chunk_sz * count;
+
+		if (chunk_size(h, c) > batch_sz) {
+			split_chunks(h, c, c + batch_sz);
+			free_list_add(h, c + batch_sz);
+		}
+
+		for (size_t i = count - 1; i > 0; i--) {
+			split_chunks(h, c, c + i * chunk_sz);
+			mem[i] = alloc_chunk_mem(heap, c + i * chunk_sz, bytes);
+		}
+		mem[0] = alloc_chunk_mem(heap, c, bytes);
+
+		return 0;
+	}
+
+	/* Otherwise the blocks have to be found one by one */
+	for (size_t i = 0; i < count; i++) {
+		mem[i] = sys_heap_alloc(heap, bytes);
+		if (mem[i] == NULL) {
+			sys_heap_free_bulk(heap, mem, i);
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
 }
 
 void *sys_heap_noalign_alloc(struct sys_heap *heap, size_t align, size_t bytes)
@@ -342,6 +576,11 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if ((c0 == 0) && size_class_drain(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+#endif
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -564,8 +803,14 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 #endif
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
-	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+	size_t meta_bytes = sizeof(struct z_heap) +
+			    nb_buckets * sizeof(struct z_heap_bucket);
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	meta_bytes += nb_size_classes(h) * sizeof(struct z_heap_size_class);
+#endif
+
+	chunksz_t chunk0_size = chunksz(meta_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
@@ -573,6 +818,13 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	for (int i = 0; i < nb_size_classes(h); i++) {
+		size_classes(h)[i].next = 0;
+		size_classes(h)[i].count = 0;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
@@ -262,6 +262,52 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 	return (bytes / CHUNK_UNIT) >= h->end_chunk;
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* The size-class front-end keeps one LIFO list of cached chunks per
+ * chunk size, from min_chunk_size() up to the size needed for
+ * CONFIG_SYS_HEAP_SIZE_CLASS_MAX_BYTES.  Cached chunks stay marked
+ * "used" so that the general allocator never touches them, and are
+ * linked through their FREE_NEXT field (which lies within the
+ * chunk's payload, as for free chunks).  The list heads follow the
+ * bucket array in chunk0.
+ */
+struct z_heap_size_class {
+	chunkid_t next;
+	uint32_t count;
+};
+
+static inline chunksz_t size_class_max_chunksz(struct z_heap *h)
+{
+	return bytes_to_chunksz(h, CONFIG_SYS_HEAP_SIZE_CLASS_MAX_BYTES);
+}
+
+static inline int nb_size_classes(struct z_heap *h)
+{
+	/* Heaps holding only a handful of the largest class would
+	 * mostly see their free memory pinned by the caches.
+	 */
+	if (h->end_chunk < 8U * size_class_max_chunksz(h)) {
+		return 0;
+	}
+	return size_class_max_chunksz(h) - min_chunk_size(h) + 1;
+}
+
+static inline struct z_heap_size_class *size_classes(struct z_heap *h)
+{
+	int nb_buckets = bucket_idx(h, h->end_chunk) + 1;
+
+	return (struct z_heap_size_class *)&h->buckets[nb_buckets];
+}
+
+/* Returns the class index for a chunk size, or -1 if it has none */
+static inline int size_class_idx(struct z_heap *h, chunksz_t sz)
+{
+	int idx = sz - min_chunk_size(h);
+
+	return (idx < nb_size_classes(h)) ? idx : -1;
+}
+#endif
+
 static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			   size_t *free_bytes)
 {
@@ -277,6 +323,17 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Chunks cached by the size classes are accounted as free */
+	for (int i = 0; i < nb_size_classes(h); i++) {
+		size_t bytes = size_classes(h)[i].count *
+			       chunksz_to_bytes(h, min_chunk_size(h) + i);
+
+		*alloc_bytes -= bytes;
+		*free_bytes += bytes;
+	}
+#endif
 }
 
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
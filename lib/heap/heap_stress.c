@@ -96,6 +96,28 @@ static size_t rand_free_choice(struct z_heap_stress_rec *sr)
 	return rand32() % sr->blocks_alloced;
 }
 
+/* Binary searches for the largest block the heap can still hand
+ * out.  Every probe is freed right away, leaving the heap as it was.
+ */
+static size_t largest_free_block(struct z_heap_stress_rec *sr)
+{
+	size_t lo = 0, hi = sr->total_bytes;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo + 1) / 2;
+		void *p = sr->alloc_fn(sr->arg, mid);
+
+		if (p != NULL) {
+			sr->free_fn(sr->arg, p);
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	return lo;
+}
+
 /* General purpose heap stress test.  Takes function pointers to allow
  * for testing multiple heap APIs with the same rig.  The alloc and
  * free functions are passed back the argument as a context pointer.
@@ -127,8 +149,10 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	for (uint32_t i = 0; i < op_count; i++) {
 		if (rand_alloc_choice(&sr)) {
 			size_t sz = rand_alloc_size(&sr);
+			uint32_t start = k_cycle_get_32();
 			void *p = sr.alloc_fn(sr.arg, sz);
 
+			result->elapsed_cycles += k_cycle_get_32() - start;
 			result->total_allocs++;
 			if (p != NULL) {
 				result->successful_allocs++;
@@ -146,8 +170,15 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
 			sr.blocks_alloced--;
 			sr.bytes_alloced -= sz;
+
+			uint32_t start = k_cycle_get_32();
+
 			sr.free_fn(sr.arg, p);
+			result->elapsed_cycles += k_cycle_get_32() - start;
 		}
 		result->accumulated_in_use_bytes += sr.bytes_alloced;
 	}
+
+	result->final_in_use_bytes = sr.bytes_alloced;
+	result->largest_free_bytes = largest_free_block(&sr);
 }
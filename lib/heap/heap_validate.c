@@ -85,6 +85,33 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Cached chunks must be valid, in use, of their class's size
+	 * (and carry their cached mark when assertions are enabled)
+	 * and exactly as many as the class believes it holds.
+	 */
+	for (int i = 0; i < nb_size_classes(h); i++) {
+		struct z_heap_size_class *sc = &size_classes(h)[i];
+		uint32_t n = 0;
+
+		for (c = sc->next; c != 0; n++, c = next_free_chunk(h, c)) {
+			if (n >= sc->count || !valid_chunk(h, c) ||
+			    !chunk_used(h, c) ||
+			    chunk_size(h, c) != min_chunk_size(h) + i) {
+				return false;
+			}
+#if __ASSERT_ON
+			if (prev_free_chunk(h, c) != c) {
+				return false;
+			}
+#endif
+		}
+		if (n != sc->count) {
+			return false;
+		}
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -31,8 +31,17 @@
 
 #define A(k) ((uint8_t *)base + size * (k))
 
+enum qsort_swap {
+	QSORT_SWAP_BYTES,
+	QSORT_SWAP_LONGS,
+	QSORT_SWAP_U32,
+	QSORT_SWAP_U64,
+};
+
 struct qsort_comp {
 	bool has3;
+	uint8_t swap;
+	size_t size;
 	void *arg;
 	union {
 		int (*comp2)(const void *a, const void *b);
@@ -49,6 +58,64 @@ static inline int compare(struct qsort_comp *cmp, void *a, void *b)
 	return cmp->comp2(a, b);
 }
 
+/*
+ * Most arrays hold ints, pointers or word-sized structs, so exchange those a
+ * whole register at a time instead of a byte at a time.
+ */
+static enum qsort_swap swap_type(const void *base, size_t size)
+{
+	uintptr_t align = (uintptr_t)base | size;
+
+	if (size == sizeof(uint32_t) && (align % __alignof__(uint32_t)) == 0) {
+		return QSORT_SWAP_U32;
+	}
+
+	if (size == sizeof(uint64_t) && (align % __alignof__(uint64_t)) == 0) {
+		return QSORT_SWAP_U64;
+	}
+
+	if ((align % sizeof(unsigned long)) == 0) {
+		return QSORT_SWAP_LONGS;
+	}
+
+	return QSORT_SWAP_BYTES;
+}
+
+static inline void exchange(struct qsort_comp *cmp, void *a, void *b)
+{
+	switch (cmp->swap) {
+	case QSORT_SWAP_U32: {
+		uint32_t t = *(uint32_t *)a;
+
+		*(uint32_t *)a = *(uint32_t *)b;
+		*(uint32_t *)b = t;
+		break;
+	}
+	case QSORT_SWAP_U64: {
+		uint64_t t = *(uint64_t *)a;
+
+		*(uint64_t *)a = *(uint64_t *)b;
+		*(uint64_t *)b = t;
+		break;
+	}
+	case QSORT_SWAP_LONGS: {
+		unsigned long *aa = a;
+		unsigned long *bb = b;
+
+		for (size_t n = cmp->size / sizeof(unsigned long); n > 0; --n) {
+			unsigned long t = *aa;
+
+			*aa++ = *bb;
+			*bb++ = t;
+		}
+		break;
+	}
+	default:
+		byteswp(a, b, cmp->size);
+		break;
+	}
+}
+
 static void sift_down(void *base, int start, int end, size_t size, struct qsort_comp *cmp)
 {
 	int root;
@@ -72,7 +139,7 @@ static void sift_down(void *base, int start, int end, size_t size, struct qsort_
 			return;
 		}
 
-		byteswp(A(root), A(swap), size);
+		exchange(cmp, A(root), A(swap));
 	}
 }
 
@@ -92,23 +159,285 @@ static void heap_sort(void *base, int nmemb, size_t size, struct qsort_comp *cmp
 	heapify(base, nmemb, size, cmp);
 
 	for (end = nmemb - 1; end > 0; --end) {
-		byteswp(A(end), A(0), size);
+		exchange(cmp, A(end), A(0));
 		sift_down(base, 0, end, size, cmp);
 	}
 }
 
+#ifdef CONFIG_MINIMAL_LIBC_QSORT_INTROSORT
+
+/*
+ * Introsort with the refinements of pattern-defeating quicksort (pdqsort):
+ * short ranges are insertion sorted, runs of keys equal to an earlier pivot
+ * are split off in one pass, ranges that partition without a single swap are
+ * checked for being sorted already, and unbalanced partitions shuffle a few
+ * elements before falling back to heap sort once O(log n) of them occurred.
+ * Elements are only ever exchanged, so no scratch element is needed.
+ */
+
+/* Ranges at most this long are insertion sorted */
+#define INSERTION_SORT_THRESHOLD 16
+/* Ranges longer than this use the median of three medians as pivot */
+#define NINTHER_THRESHOLD 128
+/* Maximum number of swaps partial_insertion_sort() may do before giving up */
+#define PARTIAL_INSERTION_SORT_LIMIT 8
+
+#define ELEM(p, k) ((p) + cmp->size * (k))
+
+static inline bool less(struct qsort_comp *cmp, uint8_t *a, uint8_t *b)
+{
+	return compare(cmp, a, b) < 0;
+}
+
+static void insertion_sort(uint8_t *first, size_t nmemb, struct qsort_comp *cmp)
+{
+	for (size_t i = 1; i < nmemb; i++) {
+		for (uint8_t *p = ELEM(first, i); p > first; p -= cmp->size) {
+			if (!less(cmp, p, p - cmp->size)) {
+				break;
+			}
+			exchange(cmp, p, p - cmp->size);
+		}
+	}
+}
+
+/* Insertion sort that gives up, returning false, if the range is not nearly sorted */
+static bool partial_insertion_sort(uint8_t *first, size_t nmemb, struct qsort_comp *cmp)
+{
+	size_t swaps = 0;
+
+	for (size_t i = 1; i < nmemb; i++) {
+		for (uint8_t *p = ELEM(first, i); p > first; p -= cmp->size) {
+			if (!less(cmp, p, p - cmp->size)) {
+				break;
+			}
+			if (++swaps > PARTIAL_INSERTION_SORT_LIMIT) {
+				return false;
+			}
+			exchange(cmp, p, p - cmp->size);
+		}
+	}
+
+	return true;
+}
+
+static inline void sort2(uint8_t *a, uint8_t *b, struct qsort_comp *cmp)
+{
+	if (less(cmp, b, a)) {
+		exchange(cmp, a, b);
+	}
+}
+
+static inline void sort3(uint8_t *a, uint8_t *b, uint8_t *c, struct qsort_comp *cmp)
+{
+	sort2(a, b, cmp);
+	sort2(b, c, cmp);
+	sort2(a, b, cmp);
+}
+
+/*
+ * Partitions [first, first + nmemb) around the pivot stored at first, with
+ * the elements equal to the pivot on the right. The pivot is moved to its
+ * final place, whose index is returned. *partitioned is set if no element
+ * had to be moved.
+ */
+static size_t partition_right(uint8_t *first, size_t nmemb, struct qsort_comp *cmp,
+			      bool *partitioned)
+{
+	uint8_t *i = first;
+	uint8_t *j = ELEM(first, nmemb);
+
+	/* The median selection left an element not less than the pivot at the end */
+	do {
+		i += cmp->size;
+	} while (less(cmp, i, first));
+
+	if (i - cmp->size == first) {
+		do {
+			j -= cmp->size;
+		} while (i < j && !less(cmp, j, first));
+	} else {
+		/* Guarded by the element at i - 1, which is less than the pivot */
+		do {
+			j -= cmp->size;
+		} while (!less(cmp, j, first));
+	}
+
+	*partitioned = i >= j;
+
+	while (i < j) {
+		exchange(cmp, i, j);
+		do {
+			i += cmp->size;
+		} while (less(cmp, i, first));
+		do {
+			j -= cmp->size;
+		} while (!less(cmp, j, first));
+	}
+
+	i -= cmp->size;
+	exchange(cmp, first, i);
+
+	return (i - first) / cmp->size;
+}
+
+/*
+ * Like partition_right(), but with the elements equal to the pivot on the
+ * left. Used when the pivot equals the element preceding the range, in which
+ * case the left part is made only of such elements and needs no sorting.
+ */
+static size_t partition_left(uint8_t *first, size_t nmemb, struct qsort_comp *cmp)
+{
+	uint8_t *i = first;
+	uint8_t *j = ELEM(first, nmemb);
+
+	do {
+		j -= cmp->size;
+	} while (less(cmp, first, j));
+
+	if (j == ELEM(first, nmemb - 1)) {
+		do {
+			i += cmp->size;
+		} while (i < j && !less(cmp, first, i));
+	} else {
+		do {
+			i += cmp->size;
+		} while (!less(cmp, first, i));
+	}
+
+	while (i < j) {
+		exchange(cmp, i, j);
+		do {
+			j -= cmp->size;
+		} while (less(cmp, first, j));
+		do {
+			i += cmp->size;
+		} while (!less(cmp, first, i));
+	}
+
+	exchange(cmp, first, j);
+
+	return (j - first) / cmp->size;
+}
+
+/* Swaps a few elements of a range to break patterns that cause bad pivots */
+static void break_patterns(uint8_t *first, size_t nmemb, struct qsort_comp *cmp)
+{
+	size_t q = nmemb / 4;
+
+	if (nmemb < INSERTION_SORT_THRESHOLD) {
+		return;
+	}
+
+	exchange(cmp, first, ELEM(first, q));
+	exchange(cmp, ELEM(first, nmemb - 1), ELEM(first, nmemb - q));
+
+	if (nmemb > NINTHER_THRESHOLD) {
+		exchange(cmp, ELEM(first, 1), ELEM(first, q + 1));
+		exchange(cmp, ELEM(first, 2), ELEM(first, q + 2));
+		exchange(cmp, ELEM(first, nmemb - 2), ELEM(first, nmemb - q - 1));
+		exchange(cmp, ELEM(first, nmemb - 3), ELEM(first, nmemb - q - 2));
+	}
+}
+
+/*
+ * Sorts [first, first + nmemb). If leftmost is false, the element preceding
+ * the range is not greater than any element in it.
+ */
+static void intro_sort(uint8_t *first, size_t nmemb, struct qsort_comp *cmp, int bad_allowed,
+		       bool leftmost)
+{
+	while (nmemb > INSERTION_SORT_THRESHOLD) {
+		size_t half = nmemb / 2;
+		size_t pivot;
+		size_t left;
+		size_t right;
+		bool partitioned;
+
+		/* Move the median of the samples to first */
+		if (nmemb > NINTHER_THRESHOLD) {
+			sort3(first, ELEM(first, half), ELEM(first, nmemb - 1), cmp);
+			sort3(ELEM(first, 1), ELEM(first, half - 1), ELEM(first, nmemb - 2), cmp);
+			sort3(ELEM(first, 2), ELEM(first, half + 1), ELEM(first, nmemb - 3), cmp);
+			sort3(ELEM(first, half - 1), ELEM(first, half), ELEM(first, half + 1), cmp);
+			exchange(cmp, first, ELEM(first, half));
+		} else {
+			sort3(ELEM(first, half), first, ELEM(first, nmemb - 1), cmp);
+		}
+
+		if (!leftmost && !less(cmp, first - cmp->size, first)) {
+			pivot = partition_left(first, nmemb, cmp);
+			first = ELEM(first, pivot + 1);
+			nmemb -= pivot + 1;
+			continue;
+		}
+
+		pivot = partition_right(first, nmemb, cmp, &partitioned);
+		left = pivot;
+		right = nmemb - pivot - 1;
+
+		if (left < nmemb / 8 || right < nmemb / 8) {
+			if (--bad_allowed == 0) {
+				heap_sort(first, nmemb, cmp->size, cmp);
+				return;
+			}
+
+			break_patterns(first, left, cmp);
+			break_patterns(ELEM(first, pivot + 1), right, cmp);
+		} else if (partitioned && partial_insertion_sort(first, left, cmp) &&
+			   partial_insertion_sort(ELEM(first, pivot + 1), right, cmp)) {
+			return;
+		}
+
+		/* Recurse into the smaller part to bound the stack depth */
+		if (left < right) {
+			intro_sort(first, left, cmp, bad_allowed, leftmost);
+			first = ELEM(first, pivot + 1);
+			nmemb = right;
+			leftmost = false;
+		} else {
+			intro_sort(ELEM(first, pivot + 1), right, cmp, bad_allowed, false);
+			nmemb = left;
+		}
+	}
+
+	insertion_sort(first, nmemb, cmp);
+}
+
+static void sort(void *base, size_t nmemb, struct qsort_comp *cmp)
+{
+	int bad_allowed = 0;
+
+	for (size_t n = nmemb; n > 0; n >>= 1) {
+		bad_allowed++;
+	}
+
+	intro_sort(base, nmemb, cmp, bad_allowed, true);
+}
+
+#else
+
+static void sort(void *base, size_t nmemb, struct qsort_comp *cmp)
+{
+	heap_sort(base, nmemb, cmp->size, cmp);
+}
+
+#endif /* CONFIG_MINIMAL_LIBC_QSORT_INTROSORT */
+
 void qsort_r(void *base, size_t nmemb, size_t size,
 	     int (*comp3)(const void *a, const void *b, void *arg), void *arg)
 {
 	struct qsort_comp cmp = {
 		.has3 = true,
+		.swap = swap_type(base, size),
+		.size = size,
 		.arg = arg,
 		{
 			.comp3 = comp3
 		}
 	};
 
-	heap_sort(base, nmemb, size, &cmp);
+	sort(base, nmemb, &cmp);
 }
 
 void qsort(void *base, size_t nmemb, size_t size,
@@ -116,11 +445,13 @@ void qsort(void *base, size_t nmemb, size_t size,
 {
 	struct qsort_comp cmp = {
 		.has3 = false,
+		.swap = swap_type(base, size),
+		.size = size,
 		.arg = NULL,
 		{
 			.comp2 = comp2
 		}
 	};
 
-	heap_sort(base, nmemb, size, &cmp);
+	sort(base, nmemb, &cmp);
 }
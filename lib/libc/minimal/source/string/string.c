@@ -10,6 +10,10 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#if !defined(CONFIG_MINIMAL_LIBC_STRING_BYTEWISE)
+#include "string_block.h"
+#endif
+
 /**
  *
  * @brief Copy a string
@@ -66,10 +70,31 @@ char *strncpy(char *ZRESTRICT d, const char *ZRESTRICT s, size_t n)
  * @return pointer to 1st instance of found byte, or NULL if not found
  */
 
-char *strchr(const char *s, int c)
+__noasan char *strchr(const char *s, int c)
 {
 	char tmp = (char) c;
 
+#if !defined(CONFIG_MINIMAL_LIBC_STRING_BYTEWISE)
+	while (!str_block_aligned(s)) {
+		if ((*s == tmp) || (*s == '\0')) {
+			return (*s == tmp) ? (char *) s : NULL;
+		}
+		s++;
+	}
+
+	/* skip whole blocks holding neither the character nor a NUL */
+	str_block_t splat = str_block_splat((unsigned char)c);
+
+	while (true) {
+		str_block_t b = str_block_load(s);
+
+		if ((str_zero_mask(b) | str_eq_mask(b, splat)) != 0) {
+			break;
+		}
+		s += STR_BLOCK_SIZE;
+	}
+#endif
+
 	while ((*s != tmp) && (*s != '\0')) {
 		s++;
 	}
@@ -104,8 +129,27 @@ char *strrchr(const char *s, int c)
  * @return number of bytes in string <s>
  */
 
-size_t strlen(const char *s)
+__noasan size_t strlen(const char *s)
 {
+#if !defined(CONFIG_MINIMAL_LIBC_STRING_BYTEWISE)
+	const char *start = s;
+
+	while (!str_block_aligned(s)) {
+		if (*s == '\0') {
+			return s - start;
+		}
+		s++;
+	}
+
+	while (true) {
+		str_mask_t m = str_zero_mask(str_block_load(s));
+
+		if (m != 0) {
+			return s - start + str_mask_index(m);
+		}
+		s += STR_BLOCK_SIZE;
+	}
+#else
 	size_t n = 0;
 
 	while (*s != '\0') {
@@ -114,6 +158,7 @@ size_t strlen(const char *s)
 	}
 
 	return n;
+#endif
 }
 
 /**
@@ -123,8 +168,33 @@ size_t strlen(const char *s)
  * @return negative # if <s1> < <s2>, 0 if <s1> == <s2>, else positive #
  */
 
-int strcmp(const char *s1, const char *s2)
+__noasan int strcmp(const char *s1, const char *s2)
 {
+#if !defined(CONFIG_MINIMAL_LIBC_STRING_BYTEWISE)
+	/* compare block-wise only if both strings have identical alignment */
+	if (str_block_aligned((const void *)((uintptr_t)s1 - (uintptr_t)s2))) {
+		while (!str_block_aligned(s1)) {
+			if ((*s1 != *s2) || (*s1 == '\0')) {
+				return *s1 - *s2;
+			}
+			s1++;
+			s2++;
+		}
+
+		/* skip identical blocks without a NUL, then finish bytewise */
+		while (true) {
+			str_block_t b1 = str_block_load(s1);
+
+			if ((str_zero_mask(b1) != 0) ||
+			    !str_block_equal(b1, str_block_load(s2))) {
+				break;
+			}
+			s1 += STR_BLOCK_SIZE;
+			s2 += STR_BLOCK_SIZE;
+		}
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -387,6 +457,35 @@ void *memchr(const void *s, int c, size_t n)
 	if (n != 0) {
 		const unsigned char *p = s;
 
+#if !defined(CONFIG_MINIMAL_LIBC_STRING_BYTEWISE)
+		while (!str_block_aligned(p)) {
+			if (*p == (unsigned char)c) {
+				return (void *)p;
+			}
+			p++;
+			if (--n == 0) {
+				return NULL;
+			}
+		}
+
+		/* only whole blocks inside the buffer are loaded */
+		str_block_t splat = str_block_splat((unsigned char)c);
+
+		while (n >= STR_BLOCK_SIZE) {
+			str_mask_t m = str_eq_mask(str_block_load(p), splat);
+
+			if (m != 0) {
+				return (void *)(p + str_mask_index(m));
+			}
+			p += STR_BLOCK_SIZE;
+			n -= STR_BLOCK_SIZE;
+		}
+
+		if (n == 0) {
+			return NULL;
+		}
+#endif
+
 		do {
 			if (*p++ == (unsigned char)c) {
 				return ((void *)(p - 1));
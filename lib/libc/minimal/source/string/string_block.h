@@ -0,0 +1,151 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_LIBC_MINIMAL_SOURCE_STRING_STRING_BLOCK_H_
+#define ZEPHYR_LIB_LIBC_MINIMAL_SOURCE_STRING_STRING_BLOCK_H_
+
+/*
+ * Helpers for the block-at-a-time string scanning routines.
+ *
+ * A block is either a mem_word_t (word-at-a-time, "SWAR") or, for the
+ * SSE2 variant, a 16-byte vector.  Blocks are only ever loaded from
+ * addresses aligned to their size, so a load that runs past the end of
+ * a string never crosses into another page or MPU region.
+ *
+ * str_zero_mask() and str_eq_mask() return a mask that is non-zero if
+ * the block holds a NUL byte, respectively a byte equal to the splatted
+ * character.  str_mask_index() turns such a mask into the offset of
+ * the first matching byte in memory order.  Bytes after the first
+ * match may show up in the mask as false positives, so nothing but the
+ * first index may be derived from it.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(__SSE2__)
+
+#include <emmintrin.h>
+
+typedef __m128i str_block_t;
+typedef uint32_t str_mask_t;
+
+#define STR_BLOCK_SIZE 16U
+
+static inline str_block_t str_block_load(const void *p)
+{
+	return _mm_load_si128((const __m128i *)p);
+}
+
+static inline str_block_t str_block_splat(unsigned char c)
+{
+	return _mm_set1_epi8((char)c);
+}
+
+static inline str_mask_t str_eq_mask(str_block_t b, str_block_t c)
+{
+	return (str_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(b, c));
+}
+
+static inline str_mask_t str_zero_mask(str_block_t b)
+{
+	return str_eq_mask(b, _mm_setzero_si128());
+}
+
+static inline unsigned int str_mask_index(str_mask_t m)
+{
+	return __builtin_ctz(m);
+}
+
+static inline bool str_block_equal(str_block_t a, str_block_t b)
+{
+	return str_eq_mask(a, b) == 0xffffU;
+}
+
+#else
+
+typedef mem_word_t str_block_t;
+typedef mem_word_t str_mask_t;
+
+#define STR_BLOCK_SIZE sizeof(mem_word_t)
+
+#define STR_ONES  ((mem_word_t)-1 / 0xffU)
+#define STR_HIGHS (STR_ONES * 0x80U)
+
+static inline str_block_t str_block_load(const void *p)
+{
+	return *(const mem_word_t *)p;
+}
+
+static inline str_block_t str_block_splat(unsigned char c)
+{
+	return STR_ONES * c;
+}
+
+static inline str_mask_t str_zero_mask(str_block_t b)
+{
+#if defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(__riscv_zbb) && \
+	(Z_MEM_WORD_T_WIDTH == __riscv_xlen)
+	str_mask_t m;
+
+	/* orc.b sets every non-zero byte to 0xff and leaves zero bytes alone */
+	__asm__ ("orc.b %0, %1" : "=r" (m) : "r" (b));
+
+	return ~m;
+#elif defined(CONFIG_MINIMAL_LIBC_STRING_ARCH) && defined(__ARM_FEATURE_DSP) && \
+	(Z_MEM_WORD_T_WIDTH == 32)
+	str_mask_t m;
+
+	/*
+	 * Adding 0xff to a byte carries out, setting its GE flag, unless the
+	 * byte is zero.  sel then picks 0x00 for those bytes and 0xff for the
+	 * zero ones.
+	 */
+	__asm__ ("uadd8 %0, %1, %2\n\t"
+		 "sel %0, %3, %2"
+		 : "=&r" (m)
+		 : "r" (b), "r" (0xffffffffU), "r" (0U)
+		 : "cc");
+
+	return m;
+#elif __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	/* Exact up to the first zero byte, which is all we need */
+	return (b - STR_ONES) & ~b & STR_HIGHS;
+#else
+	/* Borrows travel towards lower addresses here, so be exact */
+	return ~(((b & ~STR_HIGHS) + ~STR_HIGHS) | b | ~STR_HIGHS);
+#endif
+}
+
+static inline str_mask_t str_eq_mask(str_block_t b, str_block_t c)
+{
+	return str_zero_mask(b ^ c);
+}
+
+static inline bool str_block_equal(str_block_t a, str_block_t b)
+{
+	return a == b;
+}
+
+static inline unsigned int str_mask_index(str_mask_t m)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	return (unsigned int)(__builtin_ctzll(m) / 8);
+#else
+	return (unsigned int)(__builtin_clzll(m) - (64 - Z_MEM_WORD_T_WIDTH)) / 8;
+#endif
+}
+
+#endif
+
+static inline bool str_block_aligned(const void *p)
+{
+	return ((uintptr_t)p & (STR_BLOCK_SIZE - 1)) == 0;
+}
+
+#endif /* ZEPHYR_LIB_LIBC_MINIMAL_SOURCE_STRING_STRING_BLOCK_H_ */
@@ -23,6 +23,7 @@
 #include <zephyr/sys/speculation.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/zvfs/epoll.h>
 
 struct stat;
 
@@ -392,6 +393,11 @@ int zvfs_close(int fd)
 		return -1;
 	}
 
+	if (IS_ENABLED(CONFIG_ZVFS_EPOLL)) {
+		/* epoll instances take descriptor locks, so not under ours */
+		zvfs_epoll_fd_closed(fd);
+	}
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 	if (fdtable[fd].vtable->close != NULL) {
 		/* close() is optional - e.g. stdinout_fd_op_vtable */
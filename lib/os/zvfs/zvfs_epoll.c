@@ -0,0 +1,460 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+
+/* A file descriptor is watched through at most two events, POLLIN and POLLOUT */
+#define ZVFS_EPOLL_EVENTS_PER_FD 2
+
+/* k_event bit set while the ready list is not empty */
+#define ZVFS_EPOLL_READY BIT(0)
+
+/* Events that are reported even if not requested */
+#define ZVFS_EPOLL_ALWAYS (ZVFS_EPOLLERR | ZVFS_EPOLLHUP)
+
+#define ZVFS_EPOLL_SUPPORTED                                                                       \
+	(ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT | ZVFS_EPOLL_ALWAYS | ZVFS_EPOLLONESHOT)
+
+struct zvfs_epoll;
+
+struct zvfs_epoll_item {
+	struct k_poll_watch watch;
+	struct k_poll_event pev[ZVFS_EPOLL_EVENTS_PER_FD];
+	sys_dnode_t ready_node;
+	struct zvfs_epoll *ep;
+	struct zvfs_epoll_event event;
+	uint8_t num_pev;
+	/* in the interest set */
+	bool in_use;
+	/* on the ready list, or being collected with its watch still armed,
+	 * protected by the spinlock of the instance
+	 */
+	bool queued;
+};
+
+struct zvfs_epoll {
+	/* protects the ready list */
+	struct k_spinlock lock;
+	sys_dlist_t ready;
+	struct k_event ready_evt;
+	/* serializes zvfs_epoll_ctl() and zvfs_epoll_wait() */
+	struct k_mutex mutex;
+	bool in_use;
+	/* indexed by file descriptor */
+	struct zvfs_epoll_item items[CONFIG_ZVFS_OPEN_MAX];
+};
+
+SYS_BITARRAY_DEFINE_STATIC(epolls_bitarray, CONFIG_ZVFS_EPOLL_MAX);
+static struct zvfs_epoll epolls[CONFIG_ZVFS_EPOLL_MAX];
+static const struct fd_op_vtable zvfs_epoll_fd_vtable;
+
+static void zvfs_epoll_queue(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key;
+	bool wake = false;
+
+	key = k_spin_lock(&ep->lock);
+	if (!item->queued) {
+		wake = sys_dlist_is_empty(&ep->ready);
+		sys_dlist_append(&ep->ready, &item->ready_node);
+		item->queued = true;
+	}
+	k_spin_unlock(&ep->lock, key);
+
+	if (wake) {
+		k_event_post(&ep->ready_evt, ZVFS_EPOLL_READY);
+	}
+}
+
+static void zvfs_epoll_dequeue(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->lock);
+	if (item->queued) {
+		sys_dlist_remove(&item->ready_node);
+		item->queued = false;
+	}
+	k_spin_unlock(&ep->lock, key);
+}
+
+/* Called by the kernel, possibly from an ISR, when an event of the item fires */
+static void zvfs_epoll_notify(struct k_poll_watch *watch, struct k_poll_event *event)
+{
+	struct zvfs_epoll_item *item = CONTAINER_OF(watch, struct zvfs_epoll_item, watch);
+
+	ARG_UNUSED(event);
+
+	zvfs_epoll_queue(item->ep, item);
+}
+
+static int zvfs_epoll_arm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = ARRAY_INDEX(ep->items, item),
+		.events = item->event.events & (ZVFS_POLLIN | ZVFS_POLLPRI | ZVFS_POLLOUT),
+	};
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = item->pev;
+	struct k_mutex *lock;
+	void *ctx;
+	int result;
+
+	ctx = zvfs_get_fd_obj_and_vtable(pfd.fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return -EBADF;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	result = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+					 item->pev + ARRAY_SIZE(item->pev));
+	k_mutex_unlock(lock);
+
+	if (result == -EXDEV) {
+		/* offloaded sockets are polled by their driver */
+		return -EPERM;
+	} else if (result < 0 && result != -EALREADY) {
+		return result;
+	}
+
+	item->num_pev = pev - item->pev;
+	k_poll_watch_add(&item->watch, item->pev, item->num_pev);
+
+	if (result == -EALREADY) {
+		/* ready without any of its events firing, e.g. on EOF */
+		zvfs_epoll_queue(ep, item);
+	}
+
+	return 0;
+}
+
+static void zvfs_epoll_disarm(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	k_poll_watch_remove(&item->watch, item->pev, item->num_pev);
+	zvfs_epoll_dequeue(ep, item);
+}
+
+/* Returns the events of an item being collected, which is disarmed */
+static uint32_t zvfs_epoll_check(struct zvfs_epoll *ep, struct zvfs_epoll_item *item)
+{
+	struct zvfs_pollfd pfd = {
+		.fd = ARRAY_INDEX(ep->items, item),
+		.events = item->event.events & (ZVFS_POLLIN | ZVFS_POLLPRI | ZVFS_POLLOUT),
+	};
+	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev = item->pev;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	void *ctx;
+	int result;
+
+	k_poll_watch_remove(&item->watch, item->pev, item->num_pev);
+
+	/* no event can queue it anymore, until it is armed again */
+	key = k_spin_lock(&ep->lock);
+	item->queued = false;
+	k_spin_unlock(&ep->lock, key);
+
+	ctx = zvfs_get_fd_obj_and_vtable(pfd.fd, &vtable, &lock);
+	if (ctx == NULL) {
+		return ZVFS_POLLNVAL;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+	result = zvfs_fdtable_call_ioctl(vtable, ctx, ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+	k_mutex_unlock(lock);
+
+	if (result != 0) {
+		/* -EAGAIN, e.g. TLS handshake data only, is not an event */
+		return 0;
+	}
+
+	return (uint16_t)pfd.revents & (item->event.events | ZVFS_EPOLL_ALWAYS);
+}
+
+static int zvfs_epoll_collect(struct zvfs_epoll *ep, struct zvfs_epoll_event *events,
+			      int maxevents)
+{
+	sys_dlist_t ready;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	int n = 0;
+
+	/* Items that are still ready are queued again as they are checked, work on a
+	 * private list so that they are not reported twice. The items stay marked
+	 * queued until their watch is removed, so that their events firing
+	 * meanwhile do not link them into the ready list as well.
+	 */
+	sys_dlist_init(&ready);
+	key = k_spin_lock(&ep->lock);
+	while ((node = sys_dlist_get(&ep->ready)) != NULL) {
+		sys_dlist_append(&ready, node);
+	}
+	k_spin_unlock(&ep->lock, key);
+
+	while (n < maxevents && (node = sys_dlist_get(&ready)) != NULL) {
+		struct zvfs_epoll_item *item = CONTAINER_OF(node, struct zvfs_epoll_item, ready_node);
+		uint32_t revents = zvfs_epoll_check(ep, item);
+
+		if (revents & ZVFS_POLLNVAL) {
+			/* closed behind our back, drop it */
+			item->in_use = false;
+			continue;
+		}
+
+		if (revents != 0) {
+			events[n].events = revents;
+			events[n].data = item->event.data;
+			n++;
+
+			if (item->event.events & ZVFS_EPOLLONESHOT) {
+				/* disabled until rearmed with ZVFS_EPOLL_CTL_MOD */
+				item->event.events &= ZVFS_EPOLLONESHOT;
+				continue;
+			}
+		}
+
+		if (zvfs_epoll_arm(ep, item) < 0) {
+			item->in_use = false;
+		}
+	}
+
+	/* give back what did not fit, still marked queued */
+	if (!sys_dlist_is_empty(&ready)) {
+		key = k_spin_lock(&ep->lock);
+		while ((node = sys_dlist_peek_tail(&ready)) != NULL) {
+			sys_dlist_remove(node);
+			sys_dlist_prepend(&ep->ready, node);
+		}
+		k_spin_unlock(&ep->lock, key);
+	}
+
+	return n;
+}
+
+int zvfs_epoll_create(void)
+{
+	struct zvfs_epoll *ep;
+	size_t offset;
+	int fd;
+
+	if (sys_bitarray_alloc(&epolls_bitarray, 1, &offset) < 0) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	ep = &epolls[offset];
+	ep->lock = (struct k_spinlock){};
+	sys_dlist_init(&ep->ready);
+	k_event_init(&ep->ready_evt);
+	k_mutex_init(&ep->mutex);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		ep->items[i] = (struct zvfs_epoll_item){.ep = ep};
+		k_poll_watch_init(&ep->items[i].watch, zvfs_epoll_notify);
+	}
+
+	fd = zvfs_reserve_fd();
+	if (fd < 0) {
+		(void)sys_bitarray_free(&epolls_bitarray, 1, offset);
+		return -1;
+	}
+
+	ep->in_use = true;
+	zvfs_finalize_fd(fd, ep, &zvfs_epoll_fd_vtable);
+
+	return fd;
+}
+
+int zvfs_epoll_ctl(int epfd, int op, int fd, struct zvfs_epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct zvfs_epoll_item *item;
+	struct zvfs_epoll *ep;
+	int ret = 0;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (zvfs_get_fd_obj_and_vtable(fd, &vtable, NULL) == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != ZVFS_EPOLL_CTL_DEL &&
+	    (event == NULL || (event->events & ~ZVFS_EPOLL_SUPPORTED) != 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	item = &ep->items[fd];
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	switch (op) {
+	case ZVFS_EPOLL_CTL_ADD:
+		if (item->in_use) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item->event = *event;
+		ret = zvfs_epoll_arm(ep, item);
+		item->in_use = (ret == 0);
+		break;
+
+	case ZVFS_EPOLL_CTL_MOD:
+		if (!item->in_use) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_disarm(ep, item);
+		item->event = *event;
+		ret = zvfs_epoll_arm(ep, item);
+		item->in_use = (ret == 0);
+		break;
+
+	case ZVFS_EPOLL_CTL_DEL:
+		if (!item->in_use) {
+			ret = -ENOENT;
+			break;
+		}
+
+		zvfs_epoll_disarm(ep, item);
+		item->in_use = false;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+int zvfs_epoll_wait(int epfd, struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	struct zvfs_epoll *ep;
+	k_timeout_t remaining;
+	k_spinlock_key_t key;
+	k_timepoint_t end;
+	int n;
+
+	ep = zvfs_get_fd_obj(epfd, &zvfs_epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_timepoint_calc((timeout < 0) ? K_FOREVER : K_MSEC(timeout));
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	while (true) {
+		n = zvfs_epoll_collect(ep, events, maxevents);
+		if (n > 0) {
+			break;
+		}
+
+		remaining = sys_timepoint_timeout(end);
+		if (K_TIMEOUT_EQ(remaining, K_NO_WAIT)) {
+			break;
+		}
+
+		/* The ready bit is only cleared with the list empty and the lock held, so
+		 * an item queued after this point sets it again.
+		 */
+		key = k_spin_lock(&ep->lock);
+		if (sys_dlist_is_empty(&ep->ready)) {
+			k_event_clear(&ep->ready_evt, ZVFS_EPOLL_READY);
+		}
+		k_spin_unlock(&ep->lock, key);
+
+		k_mutex_unlock(&ep->mutex);
+		(void)k_event_wait(&ep->ready_evt, ZVFS_EPOLL_READY, false, remaining);
+		(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+	}
+
+	k_mutex_unlock(&ep->mutex);
+
+	return n;
+}
+
+void zvfs_epoll_fd_closed(int fd)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(epolls); i++) {
+		struct zvfs_epoll *ep = &epolls[i];
+
+		if (!ep->in_use || fd < 0 || fd >= ARRAY_SIZE(ep->items)) {
+			continue;
+		}
+
+		(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+		if (ep->in_use && ep->items[fd].in_use) {
+			zvfs_epoll_disarm(ep, &ep->items[fd]);
+			ep->items[fd].in_use = false;
+		}
+		k_mutex_unlock(&ep->mutex);
+	}
+}
+
+static int zvfs_epoll_close_op(void *obj)
+{
+	struct zvfs_epoll *ep = obj;
+
+	(void)k_mutex_lock(&ep->mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].in_use) {
+			zvfs_epoll_disarm(ep, &ep->items[i]);
+			ep->items[i].in_use = false;
+		}
+	}
+
+	ep->in_use = false;
+	k_mutex_unlock(&ep->mutex);
+
+	(void)sys_bitarray_free(&epolls_bitarray, 1, ep - epolls);
+
+	return 0;
+}
+
+static int zvfs_epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(request);
+	ARG_UNUSED(args);
+
+	/* in particular, epoll instances cannot be polled themselves */
+	errno = EOPNOTSUPP;
+	return -1;
+}
+
+static const struct fd_op_vtable zvfs_epoll_fd_vtable = {
+	.close = zvfs_epoll_close_op,
+	.ioctl = zvfs_epoll_ioctl_op,
+};
@@ -1071,10 +1071,111 @@ static int arr_data_parse(struct json_obj *obj, struct json_obj_token *val)
 	return -EINVAL;
 }
 
+/* Descriptor arrays up to this size are searched linearly */
+#define KEY_LOOKUP_LINEAR_MAX 8
+#define KEY_LOOKUP_BUCKETS 16
+#define KEY_LOOKUP_END UINT8_MAX
+
+/*
+ * Maps object keys to descriptor indexes.
+ *
+ * Keys usually come in the order of their descriptors, so the descriptor
+ * following the previous match is tried first.  When that guess fails on
+ * a large descriptor array, the descriptors are hashed by name into a few
+ * buckets on the stack, which is done at most once per object.
+ */
+struct key_lookup {
+	const struct json_obj_descr *descr;
+	size_t descr_len;
+	size_t next;
+	bool hashed;
+	uint8_t head[KEY_LOOKUP_BUCKETS];
+	uint8_t chain[sizeof(int64_t) * CHAR_BIT];
+};
+
+static unsigned int key_bucket(const char *key, size_t len)
+{
+	if (len == 0) {
+		return 0;
+	}
+
+	return (len + (uint8_t)key[0] * 3U + (uint8_t)key[len - 1] * 7U) %
+	       KEY_LOOKUP_BUCKETS;
+}
+
+static void key_lookup_hash(struct key_lookup *lookup)
+{
+	(void)memset(lookup->head, KEY_LOOKUP_END, sizeof(lookup->head));
+
+	/* Insert backwards so that chains are in descriptor order */
+	for (size_t i = lookup->descr_len; i-- > 0;) {
+		unsigned int b = key_bucket(lookup->descr[i].field_name,
+					    lookup->descr[i].field_name_len);
+
+		lookup->chain[i] = lookup->head[b];
+		lookup->head[b] = (uint8_t)i;
+	}
+
+	lookup->hashed = true;
+}
+
+static bool key_matches(const struct json_obj_descr *descr,
+			const struct json_obj_key_value *kv)
+{
+	return kv->key_len == descr->field_name_len &&
+	       memcmp(kv->key, descr->field_name, kv->key_len) == 0;
+}
+
+/* Returns the first matching field not decoded yet, or descr_len */
+static size_t key_lookup_find(struct key_lookup *lookup,
+			      const struct json_obj_key_value *kv,
+			      int64_t decoded_fields)
+{
+	const struct json_obj_descr *descr = lookup->descr;
+	size_t i = lookup->next;
+
+	if (i < lookup->descr_len && !(decoded_fields & ((int64_t)1 << i)) &&
+	    key_matches(&descr[i], kv)) {
+		goto found;
+	}
+
+	if (lookup->descr_len <= KEY_LOOKUP_LINEAR_MAX) {
+		for (i = 0; i < lookup->descr_len; i++) {
+			if (!(decoded_fields & ((int64_t)1 << i)) &&
+			    key_matches(&descr[i], kv)) {
+				goto found;
+			}
+		}
+		return lookup->descr_len;
+	}
+
+	if (!lookup->hashed) {
+		key_lookup_hash(lookup);
+	}
+
+	for (i = lookup->head[key_bucket(kv->key, kv->key_len)];
+	     i != KEY_LOOKUP_END; i = lookup->chain[i]) {
+		if (!(decoded_fields & ((int64_t)1 << i)) &&
+		    key_matches(&descr[i], kv)) {
+			goto found;
+		}
+	}
+
+	return lookup->descr_len;
+
+found:
+	lookup->next = i + 1;
+	return i;
+}
+
 static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *descr,
 			 size_t descr_len, void *val)
 {
 	struct json_obj_key_value kv;
+	struct key_lookup lookup = {
+		.descr = descr,
+		.descr_len = descr_len,
+	};
 	int64_t decoded_fields = 0;
 	size_t i;
 	int ret;
@@ -1084,24 +1185,10 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			return decoded_fields;
 		}
 
-		for (i = 0; i < descr_len; i++) {
+		i = key_lookup_find(&lookup, &kv, decoded_fields);
+		if (i < descr_len) {
 			void *decode_field = (char *)val + descr[i].offset;
 
-			/* Field has been decoded already, skip */
-			if (decoded_fields & ((int64_t)1 << i)) {
-				continue;
-			}
-
-			/* Check if it's the i-th field */
-			if (kv.key_len != descr[i].field_name_len) {
-				continue;
-			}
-
-			if (memcmp(kv.key, descr[i].field_name,
-				   descr[i].field_name_len)) {
-				continue;
-			}
-
 			/* Store the decoded value */
 			ret = decode_value(obj, &descr[i], &kv.value,
 					   decode_field, val);
@@ -1110,7 +1197,6 @@ static int64_t obj_parse(struct json_obj *obj, const struct json_obj_descr *desc
 			}
 
 			decoded_fields |= (int64_t)1<<i;
-			break;
 		}
 
 		/* Skip field, if no descriptor was found */
@@ -1189,6 +1275,570 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+/* Tokenizer states of the streaming parser */
+enum {
+	STREAM_LEX_IDLE,
+	STREAM_LEX_STRING,
+	STREAM_LEX_ESCAPE,
+	STREAM_LEX_UNICODE,
+	STREAM_LEX_MINUS,
+	STREAM_LEX_NUMBER,
+	STREAM_LEX_LITERAL,
+};
+
+/* Parser states of a streaming parser frame */
+enum {
+	STREAM_OBJ_START,
+	STREAM_OBJ_KEY_OR_END,
+	STREAM_OBJ_KEY,
+	STREAM_OBJ_COLON,
+	STREAM_OBJ_VALUE,
+	STREAM_ARR_VALUE_OR_END,
+	STREAM_ARR_VALUE,
+	STREAM_COMMA_OR_END,
+};
+
+static struct json_stream_frame *stream_frame(struct json_stream *stream)
+{
+	return &stream->stack[stream->depth - 1];
+}
+
+/* Whether the token being read belongs to a value nobody asked for */
+static bool stream_skipping(struct json_stream *stream)
+{
+	struct json_stream_frame *frame;
+
+	if (stream->skip_depth > 0 || stream->depth == 0) {
+		return true;
+	}
+
+	frame = stream_frame(stream);
+
+	return !frame->is_array && frame->state == STREAM_OBJ_VALUE &&
+	       frame->obj.field == NULL;
+}
+
+/* Whether the token being read is the key of an object member */
+static bool stream_lexing_key(struct json_stream *stream)
+{
+	struct json_stream_frame *frame;
+
+	if (stream->skip_depth > 0 || stream->depth == 0) {
+		return false;
+	}
+
+	frame = stream_frame(stream);
+
+	return !frame->is_array && (frame->state == STREAM_OBJ_KEY_OR_END ||
+				    frame->state == STREAM_OBJ_KEY);
+}
+
+static struct json_stream_frame *stream_push(struct json_stream *stream)
+{
+	if (stream->depth >= ARRAY_SIZE(stream->stack)) {
+		return NULL;
+	}
+
+	return &stream->stack[stream->depth++];
+}
+
+static int stream_push_obj(struct json_stream *stream, const struct json_obj_descr *descr,
+			   size_t descr_len, void *val, uint8_t state)
+{
+	struct json_stream_frame *frame = stream_push(stream);
+
+	if (frame == NULL) {
+		return -ENOMEM;
+	}
+
+	frame->descr = descr;
+	frame->val = val;
+	frame->is_array = false;
+	frame->state = state;
+	frame->obj.descr_len = descr_len;
+	frame->obj.decoded = 0;
+	frame->obj.next = 0;
+	frame->obj.field = NULL;
+
+	return 0;
+}
+
+/* Same layout rules as arr_parse() */
+static int stream_push_arr(struct json_stream *stream, const struct json_obj_descr *elem_descr,
+			   size_t max_elements, void *field, void *val)
+{
+	struct json_stream_frame *frame = stream_push(stream);
+	ptrdiff_t elem_size;
+
+	if (frame == NULL) {
+		return -ENOMEM;
+	}
+
+	frame->arr.elements = (size_t *)((char *)val + elem_descr->offset);
+
+	/* For nested arrays, skip parent descriptor to get elements */
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		elem_descr = elem_descr->array.element_descr;
+	}
+
+	elem_size = get_elem_size(elem_descr);
+	__ASSERT_NO_MSG(elem_size > 0);
+
+	*frame->arr.elements = 0;
+	frame->descr = elem_descr;
+	frame->val = field;
+	frame->arr.end = (char *)field + elem_size * max_elements;
+	frame->is_array = true;
+	frame->state = STREAM_ARR_VALUE_OR_END;
+
+	return 0;
+}
+
+static void stream_pop(struct json_stream *stream)
+{
+	if (--stream->depth == 0) {
+		stream->result = stream->stack[0].obj.decoded;
+		return;
+	}
+
+	stream_frame(stream)->state = STREAM_COMMA_OR_END;
+}
+
+/* Counterpart of decode_value() for the value starting with token @a value */
+static int stream_value(struct json_stream *stream, const struct json_obj_descr *descr,
+			struct json_token *value, void *field, void *val)
+{
+	if (!equivalent_types(value->type, descr->type)) {
+		return -EINVAL;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		return stream_push_obj(stream, descr->object.sub_descr,
+				       descr->object.sub_descr_len, field,
+				       STREAM_OBJ_KEY_OR_END);
+	case JSON_TOK_ARRAY_START:
+		return stream_push_arr(stream, descr->array.element_descr,
+				       descr->array.n_elements, field, val);
+	case JSON_TOK_STRING:
+	case JSON_TOK_OPAQUE:
+	case JSON_TOK_FLOAT:
+	case JSON_TOK_OBJ_ARRAY:
+		/* These would point into the input, which is not kept */
+		return -ENOTSUP;
+	default:
+		return decode_value(NULL, descr, value, field, val);
+	}
+}
+
+static bool stream_is_value(enum json_tokens type)
+{
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+	case JSON_TOK_ARRAY_START:
+	case JSON_TOK_STRING:
+	case JSON_TOK_NUMBER:
+	case JSON_TOK_TRUE:
+	case JSON_TOK_FALSE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static int stream_obj_key(struct json_stream *stream, struct json_stream_frame *frame,
+			  struct json_token *tok)
+{
+	struct json_obj_key_value kv = {
+		.key = tok->start,
+		.key_len = tok->end - tok->start,
+	};
+	struct key_lookup lookup = {
+		.descr = frame->descr,
+		.descr_len = frame->obj.descr_len,
+		.next = frame->obj.next,
+	};
+	size_t i;
+
+	if (tok->type != JSON_TOK_STRING) {
+		return -EINVAL;
+	}
+
+	if (stream->key_unknown) {
+		frame->obj.field = NULL;
+		frame->state = STREAM_OBJ_COLON;
+		return 0;
+	}
+
+	i = key_lookup_find(&lookup, &kv, frame->obj.decoded);
+	frame->obj.next = lookup.next;
+	frame->obj.field = (i < frame->obj.descr_len) ? &frame->descr[i] : NULL;
+	frame->state = STREAM_OBJ_COLON;
+
+	return 0;
+}
+
+static int stream_obj_value(struct json_stream *stream, struct json_stream_frame *frame,
+			    struct json_token *tok)
+{
+	const struct json_obj_descr *field = frame->obj.field;
+	int ret;
+
+	if (!stream_is_value(tok->type)) {
+		return -EINVAL;
+	}
+
+	frame->state = STREAM_COMMA_OR_END;
+
+	/* Skip field, if no descriptor was found */
+	if (field == NULL) {
+		if (tok->type == JSON_TOK_OBJECT_START || tok->type == JSON_TOK_ARRAY_START) {
+			stream->skip_depth = 1;
+		}
+		return 0;
+	}
+
+	ret = stream_value(stream, field, tok, (char *)frame->val + field->offset, frame->val);
+	if (ret < 0) {
+		return ret;
+	}
+
+	frame->obj.decoded |= (int64_t)1 << (field - frame->descr);
+
+	return 0;
+}
+
+static int stream_arr_value(struct json_stream *stream, struct json_stream_frame *frame,
+			    struct json_token *tok)
+{
+	void *field = frame->val;
+
+	if (!stream_is_value(tok->type)) {
+		return -EINVAL;
+	}
+
+	if (field == frame->arr.end) {
+		return -ENOSPC;
+	}
+
+	frame->state = STREAM_COMMA_OR_END;
+	frame->val = (char *)field + get_elem_size(frame->descr);
+	(*frame->arr.elements)++;
+
+	/* For nested arrays, the element holds the length field */
+	return stream_value(stream, frame->descr, tok, field, field);
+}
+
+static int stream_token(struct json_stream *stream, enum json_tokens type)
+{
+	struct json_token tok = {
+		.type = type,
+		.start = stream->buf,
+		.end = stream->buf + stream->len,
+	};
+	struct json_stream_frame *frame;
+	enum json_tokens end;
+
+	if (stream->skip_depth > 0) {
+		if (type == JSON_TOK_OBJECT_START || type == JSON_TOK_ARRAY_START) {
+			stream->skip_depth++;
+		} else if (type == JSON_TOK_OBJECT_END || type == JSON_TOK_ARRAY_END) {
+			stream->skip_depth--;
+		}
+		return 0;
+	}
+
+	/* Nothing may follow the top-level object */
+	if (stream->depth == 0) {
+		return -EINVAL;
+	}
+
+	frame = stream_frame(stream);
+	end = frame->is_array ? JSON_TOK_ARRAY_END : JSON_TOK_OBJECT_END;
+
+	switch (frame->state) {
+	case STREAM_OBJ_START:
+		if (type != JSON_TOK_OBJECT_START) {
+			return -EINVAL;
+		}
+		frame->state = STREAM_OBJ_KEY_OR_END;
+		return 0;
+	case STREAM_OBJ_KEY_OR_END:
+		if (type == JSON_TOK_OBJECT_END) {
+			stream_pop(stream);
+			return 0;
+		}
+		__fallthrough;
+	case STREAM_OBJ_KEY:
+		return stream_obj_key(stream, frame, &tok);
+	case STREAM_OBJ_COLON:
+		if (type != JSON_TOK_COLON) {
+			return -EINVAL;
+		}
+		frame->state = STREAM_OBJ_VALUE;
+		return 0;
+	case STREAM_OBJ_VALUE:
+		return stream_obj_value(stream, frame, &tok);
+	case STREAM_ARR_VALUE_OR_END:
+		if (type == JSON_TOK_ARRAY_END) {
+			stream_pop(stream);
+			return 0;
+		}
+		__fallthrough;
+	case STREAM_ARR_VALUE:
+		return stream_arr_value(stream, frame, &tok);
+	case STREAM_COMMA_OR_END:
+		if (type == end) {
+			stream_pop(stream);
+			return 0;
+		}
+		if (type != JSON_TOK_COMMA) {
+			return -EINVAL;
+		}
+		frame->state = frame->is_array ? STREAM_ARR_VALUE : STREAM_OBJ_KEY;
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int stream_append(struct json_stream *stream, char chr)
+{
+	if (!stream->store) {
+		return 0;
+	}
+
+	/* Keep a byte for the terminator the number decoders write */
+	if (stream->len + 1 >= stream->buf_size) {
+		/* No descriptor has a key this long: the member is skipped */
+		if (stream_lexing_key(stream)) {
+			stream->store = false;
+			stream->key_unknown = true;
+			return 0;
+		}
+
+		return -ENOMEM;
+	}
+
+	stream->buf[stream->len++] = chr;
+
+	return 0;
+}
+
+static void stream_start(struct json_stream *stream, uint8_t lex_state)
+{
+	stream->lex_state = lex_state;
+	stream->len = 0;
+	stream->store = !stream_skipping(stream);
+	stream->key_unknown = false;
+}
+
+static int stream_start_literal(struct json_stream *stream, const char *literal,
+				enum json_tokens type)
+{
+	stream_start(stream, STREAM_LEX_LITERAL);
+	stream->literal = literal;
+	stream->lex_count = 1;
+	stream->literal_type = type;
+
+	/* Numbers spelled out as words are decoded from their text */
+	return (type == JSON_TOK_NUMBER) ? stream_append(stream, literal[0]) : 0;
+}
+
+static int stream_char(struct json_stream *stream, char chr)
+{
+	int ret;
+
+	switch (stream->lex_state) {
+	case STREAM_LEX_STRING:
+		if (chr == '"') {
+			stream->lex_state = STREAM_LEX_IDLE;
+			return stream_token(stream, JSON_TOK_STRING);
+		}
+
+		if (chr == '\0') {
+			return -EINVAL;
+		}
+
+		if (chr == '\\') {
+			stream->lex_state = STREAM_LEX_ESCAPE;
+		}
+
+		return stream_append(stream, chr);
+	case STREAM_LEX_ESCAPE:
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+		case 'b':
+		case 'f':
+		case 'n':
+		case 'r':
+		case 't':
+			stream->lex_state = STREAM_LEX_STRING;
+			break;
+		case 'u':
+			stream->lex_state = STREAM_LEX_UNICODE;
+			stream->lex_count = 4;
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		return stream_append(stream, chr);
+	case STREAM_LEX_UNICODE:
+		if (isxdigit((unsigned char)chr) == 0) {
+			return -EINVAL;
+		}
+
+		if (--stream->lex_count == 0) {
+			stream->lex_state = STREAM_LEX_STRING;
+		}
+
+		return stream_append(stream, chr);
+	case STREAM_LEX_MINUS:
+		if (isdigit((unsigned char)chr) != 0) {
+			stream->lex_state = STREAM_LEX_NUMBER;
+			return stream_append(stream, chr);
+		}
+
+#ifdef CONFIG_JSON_LIBRARY_FP_SUPPORT
+		if (chr == 'I') {
+			stream->lex_state = STREAM_LEX_LITERAL;
+			stream->literal = "-Infinity";
+			stream->lex_count = 2;
+			stream->literal_type = JSON_TOK_NUMBER;
+			return stream_append(stream, chr);
+		}
+#endif
+
+		return -EINVAL;
+	case STREAM_LEX_NUMBER:
+		if (isdigit((unsigned char)chr) != 0 || chr == '.' || chr == 'e' ||
+		    chr == '+' || chr == '-') {
+			return stream_append(stream, chr);
+		}
+
+		stream->lex_state = STREAM_LEX_IDLE;
+		ret = stream_token(stream, JSON_TOK_NUMBER);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* The character ending the number starts the next token */
+		break;
+	case STREAM_LEX_LITERAL:
+		if (chr != stream->literal[stream->lex_count]) {
+			return -EINVAL;
+		}
+
+		if (stream->literal_type == JSON_TOK_NUMBER) {
+			ret = stream_append(stream, chr);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		if (stream->literal[++stream->lex_count] == '\0') {
+			stream->lex_state = STREAM_LEX_IDLE;
+			return stream_token(stream, stream->literal_type);
+		}
+
+		return 0;
+	default:
+		break;
+	}
+
+	switch (chr) {
+	case '{':
+	case '}':
+	case '[':
+	case ']':
+	case ',':
+	case ':':
+		stream->len = 0;
+		return stream_token(stream, (enum json_tokens)chr);
+	case '"':
+		stream_start(stream, STREAM_LEX_STRING);
+		return 0;
+	case 't':
+		return stream_start_literal(stream, "true", JSON_TOK_TRUE);
+	case 'f':
+		return stream_start_literal(stream, "false", JSON_TOK_FALSE);
+	case 'n':
+		return stream_start_literal(stream, "null", JSON_TOK_NULL);
+#ifdef CONFIG_JSON_LIBRARY_FP_SUPPORT
+	case 'N':
+		return stream_start_literal(stream, "NaN", JSON_TOK_NUMBER);
+	case 'I':
+		return stream_start_literal(stream, "Infinity", JSON_TOK_NUMBER);
+#endif
+	case '-':
+		stream_start(stream, STREAM_LEX_MINUS);
+		return stream_append(stream, chr);
+	default:
+		if (isspace((unsigned char)chr) != 0) {
+			return 0;
+		}
+
+		if (isdigit((unsigned char)chr) != 0) {
+			stream_start(stream, STREAM_LEX_NUMBER);
+			return stream_append(stream, chr);
+		}
+
+		return -EINVAL;
+	}
+}
+
+int json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		     const struct json_obj_descr *descr, size_t descr_len, void *val)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(stream->result) * CHAR_BIT - 1));
+
+	if (buf_size < 2) {
+		return -EINVAL;
+	}
+
+	*stream = (struct json_stream){
+		.buf = buf,
+		.buf_size = buf_size,
+		.lex_state = STREAM_LEX_IDLE,
+	};
+
+	return stream_push_obj(stream, descr, descr_len, val, STREAM_OBJ_START);
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len)
+{
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		int ret = stream_char(stream, data[i]);
+
+		if (ret < 0) {
+			stream->error = ret;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int64_t json_stream_finish(struct json_stream *stream)
+{
+	if (stream->error < 0) {
+		return stream->error;
+	}
+
+	if (stream->depth > 0 || stream->lex_state != STREAM_LEX_IDLE) {
+		return -EINVAL;
+	}
+
+	return stream->result;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -56,11 +56,31 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Rank of a connection with all its addresses and ports specified */
+#define NET_CONN_RANK_MAX		NET_CONN_RANK(0xff)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* IP connections are also kept in lookup tables, so that net_conn_input()
+ * only looks at the connections that may accept a packet: connections with
+ * a fully specified 4-tuple are hashed on it, the other ones with a local
+ * port on that port, and the rest are kept in a wildcard list.
+ */
+static sys_slist_t conn_tuple_table[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_port_table[CONFIG_NET_CONN_HASH_SIZE];
+static sys_slist_t conn_wildcard;
+
+/* Protects the lookup tables and the fields of the connections in them.
+ * Writers hold conn_lock too, so either lock is enough for reading.
+ */
+static struct k_spinlock conn_hash_lock;
+
+/* Number of lookup table lists net_conn_input() looks at for a packet */
+#define NET_CONN_INPUT_LISTS 3
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -113,6 +133,133 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t value)
+{
+	return (hash ^ value) * 0x9e3779b1U;
+}
+
+static uint32_t conn_hash_addr(uint32_t hash, const uint8_t *addr, size_t len)
+{
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = conn_hash_mix(hash, sys_get_be32(&addr[i]));
+	}
+
+	return hash;
+}
+
+/* Ports are in network byte order, addresses are raw IPv4 or IPv6 addresses */
+static sys_slist_t *conn_tuple_bucket(uint16_t proto, uint8_t family,
+				      const uint8_t *remote_addr,
+				      uint16_t remote_port,
+				      const uint8_t *local_addr,
+				      uint16_t local_port)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+	uint32_t hash;
+
+	hash = conn_hash_mix(proto, ((uint32_t)remote_port << 16) | local_port);
+	hash = conn_hash_addr(hash, remote_addr, len);
+	hash = conn_hash_addr(hash, local_addr, len);
+
+	return &conn_tuple_table[(hash >> 16) % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+static sys_slist_t *conn_port_bucket(uint16_t proto, uint16_t local_port)
+{
+	uint32_t hash = conn_hash_mix(proto, local_port);
+
+	return &conn_port_table[(hash >> 16) % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+static const uint8_t *conn_addr_raw(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return net_sin6(addr)->sin6_addr.s6_addr;
+	}
+
+	return (const uint8_t *)&net_sin(addr)->sin_addr;
+}
+
+static bool conn_addr_is_specified(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return !net_ipv6_is_addr_unspecified(&net_sin6(addr)->sin6_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && addr->sa_family == AF_INET) {
+		return net_sin(addr)->sin_addr.s_addr != 0;
+	}
+
+	return false;
+}
+
+/* Can the connection only accept packets of a single 4-tuple? */
+static bool conn_is_exact(struct net_conn *conn)
+{
+	if (!(conn->flags & NET_CONN_REMOTE_ADDR_SET) ||
+	    !(conn->flags & NET_CONN_LOCAL_ADDR_SET)) {
+		return false;
+	}
+
+	if (conn->remote_addr.sa_family != conn->family ||
+	    conn->local_addr.sa_family != conn->family) {
+		return false;
+	}
+
+	if (net_sin(&conn->remote_addr)->sin_port == 0U ||
+	    net_sin(&conn->local_addr)->sin_port == 0U) {
+		return false;
+	}
+
+	return conn_addr_is_specified(&conn->remote_addr) &&
+	       conn_addr_is_specified(&conn->local_addr);
+}
+
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	uint16_t local_port;
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		/* Not handled by net_conn_input() */
+		return NULL;
+	}
+
+	if (conn_is_exact(conn)) {
+		return conn_tuple_bucket(conn->proto, conn->family,
+					 conn_addr_raw(&conn->remote_addr),
+					 net_sin(&conn->remote_addr)->sin_port,
+					 conn_addr_raw(&conn->local_addr),
+					 net_sin(&conn->local_addr)->sin_port);
+	}
+
+	local_port = net_sin(&conn->local_addr)->sin_port;
+	if (local_port != 0U) {
+		return conn_port_bucket(conn->proto, local_port);
+	}
+
+	return &conn_wildcard;
+}
+
+/* Must be called with both conn_lock and conn_hash_lock held */
+static void conn_hash_insert(struct net_conn *conn)
+{
+	conn->hash_list = conn_hash_list(conn);
+	if (conn->hash_list != NULL) {
+		sys_slist_prepend(conn->hash_list, &conn->hash_node);
+	}
+}
+
+/* Must be called with both conn_lock and conn_hash_lock held */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if (conn->hash_list != NULL) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -134,10 +281,17 @@ static struct net_conn *conn_get_unused(void)
 
 static void conn_set_used(struct net_conn *conn)
 {
+	k_spinlock_key_t key;
+
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+
+	key = k_spin_lock(&conn_hash_lock);
+	conn_hash_insert(conn);
+	k_spin_unlock(&conn_hash_lock, key);
+
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -435,10 +589,10 @@ int net_conn_register(uint16_t proto, enum net_sock_type type, uint8_t family,
 		*handle = (struct net_conn_handle *)conn;
 	}
 
-	conn_set_used(conn);
-
 	conn->v6only = net_context_is_v6only_set(context);
 
+	conn_set_used(conn);
+
 	conn_register_debug(conn, remote_port, local_port);
 
 	return 0;
@@ -450,6 +604,7 @@ error:
 int net_conn_unregister(struct net_conn_handle *handle)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
+	k_spinlock_key_t key;
 
 	if (conn < &conns[0] || conn > &conns[CONFIG_NET_MAX_CONN]) {
 		return -EINVAL;
@@ -463,6 +618,11 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+
+	key = k_spin_lock(&conn_hash_lock);
+	conn_hash_remove(conn);
+	k_spin_unlock(&conn_hash_lock, key);
+
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -479,6 +639,7 @@ int net_conn_update(struct net_conn_handle *handle,
 		    uint16_t local_port)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
+	k_spinlock_key_t key;
 	int ret;
 
 	if (conn < &conns[0] || conn > &conns[CONFIG_NET_MAX_CONN]) {
@@ -489,14 +650,23 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	key = k_spin_lock(&conn_hash_lock);
+
+	/* The new addresses may move the connection to another list */
+	conn_hash_remove(conn);
+
 	net_conn_change_callback(conn, cb, user_data);
 
 	ret = net_conn_change_local(conn, local_addr, local_port);
-	if (ret < 0) {
-		return ret;
+	if (ret == 0) {
+		ret = net_conn_change_remote(conn, remote_addr, remote_port);
 	}
 
-	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_insert(conn);
+
+	k_spin_unlock(&conn_hash_lock, key);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -873,6 +1043,143 @@ enum net_verdict net_conn_can_input(struct net_pkt *pkt, uint8_t proto)
 }
 #endif /* defined(CONFIG_NET_SOCKETS_CAN) */
 
+/* Is the candidate IP connection accepting the packet? */
+static bool conn_is_matching(struct net_conn *conn, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's interface? */
+	if (!is_iface_matching(conn, pkt)) {
+		return false; /* wrong interface */
+	}
+
+	/* Is the candidate connection matching the packet's protocol family? */
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only && conn->type != SOCK_RAW)) {
+				return false;
+			}
+		} else {
+			return false; /* wrong protocol family */
+		}
+
+		/* We might have a match for v4-to-v6 mapping, check more */
+	}
+
+	/* Is the candidate connection matching the packet's protocol within the family? */
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	if (!IS_ENABLED(CONFIG_NET_UDP) && !IS_ENABLED(CONFIG_NET_TCP)) {
+		return false;
+	}
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	return true;
+}
+
+/* Gets the lookup table lists holding the connections that may accept the packet */
+static void conn_input_lists(sys_slist_t *lists[NET_CONN_INPUT_LISTS],
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	const uint8_t *src;
+	const uint8_t *dst;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+	} else {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+	}
+
+	lists[0] = conn_tuple_bucket(proto, net_pkt_family(pkt), src, src_port,
+				     dst, dst_port);
+	lists[1] = conn_port_bucket(proto, dst_port);
+	lists[2] = &conn_wildcard;
+}
+
+/* Must be called with conn_hash_lock or conn_lock held */
+static struct net_conn *conn_find_best(sys_slist_t *lists[NET_CONN_INPUT_LISTS],
+				       struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr, uint8_t proto,
+				       uint16_t src_port, uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+
+	for (int i = 0; i < NET_CONN_INPUT_LISTS; i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (best_rank >= NET_CONN_RANK(conn->flags)) {
+				continue; /* cannot be better than the match we have */
+			}
+
+			if (!conn_is_matching(conn, pkt, ip_hdr, proto,
+					      src_port, dst_port)) {
+				continue;
+			}
+
+			best_rank = NET_CONN_RANK(conn->flags);
+			best_match = conn;
+
+			if (best_rank == NET_CONN_RANK_MAX) {
+				/* Nothing can beat a fully specified match */
+				return best_match;
+			}
+		}
+	}
+
+	return best_match;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -914,13 +1221,14 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
 	struct net_conn *best_match = NULL;
-	int16_t best_rank = -1;
 	bool is_mcast_pkt = false;
 	bool mcast_pkt_delivered = false;
 	bool is_bcast_pkt = false;
+	sys_slist_t *lists[NET_CONN_INPUT_LISTS];
 	struct net_conn *conn;
 	net_conn_cb_t cb = NULL;
 	void *user_data = NULL;
+	k_spinlock_key_t key;
 
 	/* If we receive a packet with multicast destination address, we might
 	 * need to deliver the packet to multiple recipients.
@@ -936,89 +1244,33 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		is_mcast_pkt = net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
 	}
 
-	k_mutex_lock(&conn_lock, K_FOREVER);
-
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
-		/* Is the candidate connection matching the packet's interface? */
-		if (!is_iface_matching(conn, pkt)) {
-			continue; /* wrong interface */
-		}
+	conn_input_lists(lists, pkt, ip_hdr, proto, src_port, dst_port);
 
-		/* Is the candidate connection matching the packet's protocol family? */
-		if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
-			if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-				if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-				      !conn->v6only && conn->type != SOCK_RAW)) {
-					continue;
-				}
-			} else {
-				continue; /* wrong protocol family */
-			}
+	if (!is_mcast_pkt) {
+		/* The lookup does not sleep, so a spinlock keeps it cheap.
+		 * The callback is called without it.
+		 */
+		key = k_spin_lock(&conn_hash_lock);
 
-			/* We might have a match for v4-to-v6 mapping, check more */
+		best_match = conn_find_best(lists, pkt, ip_hdr, proto,
+					    src_port, dst_port);
+		if (best_match != NULL) {
+			cb = best_match->cb;
+			user_data = best_match->user_data;
 		}
 
-		/* Is the candidate connection matching the packet's protocol within the family? */
-		if (conn->proto != proto) {
-			continue; /* wrong protocol */
-		}
-
-		/* Apply protocol-specific matching criteria... */
-		uint8_t conn_family = conn->family;
-
-		if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
-		    (conn_family == AF_INET || conn_family == AF_INET6 ||
-		     conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
+		k_spin_unlock(&conn_hash_lock, key);
+	} else {
+		/* Cloning the packet may sleep, hold the mutex instead */
+		k_mutex_lock(&conn_lock, K_FOREVER);
 
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
+		ARRAY_FOR_EACH(lists, i) {
+			SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
 				struct net_pkt *mcast_pkt;
 
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
+				if (!conn_is_matching(conn, pkt, ip_hdr, proto,
+						      src_port, dst_port)) {
+					continue;
 				}
 
 				/* If we have a multicast packet, and we found
@@ -1038,8 +1290,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 					goto drop;
 				}
 
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
+				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr,
+					     conn->user_data) == NET_DROP) {
 					net_stats_update_per_proto_drop(pkt_iface, proto);
 					net_pkt_unref(mcast_pkt);
 				} else {
@@ -1049,15 +1301,10 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 				mcast_pkt_delivered = true;
 			}
 		}
-	} /* loop end */
 
-	if (best_match != NULL) {
-		cb = best_match->cb;
-		user_data = best_match->user_data;
+		k_mutex_unlock(&conn_lock);
 	}
 
-	k_mutex_unlock(&conn_lock);
-
 	if (is_mcast_pkt && mcast_pkt_delivered) {
 		/* As one or more multicast packets
 		 * have already been delivered in the loop above,
@@ -1119,6 +1366,12 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wildcard);
+
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_tuple_table[i]);
+		sys_slist_init(&conn_port_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
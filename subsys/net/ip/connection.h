@@ -54,6 +54,12 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal node in a lookup table list */
+	sys_snode_t hash_node;
+
+	/** Lookup table list the connection is in, NULL if none */
+	sys_slist_t *hash_list;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
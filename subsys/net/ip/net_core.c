@@ -64,8 +64,9 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 #include "net_stats.h"
 
 #if defined(CONFIG_NET_NATIVE)
-static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+/* Processing up to the point where the packet is handed to L3 */
+static inline enum net_verdict process_l2(struct net_pkt *pkt,
+					  bool is_loopback)
 {
 	int ret;
 	bool locally_routed = false;
@@ -123,6 +124,12 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		}
 	}
 
+	return NET_CONTINUE;
+}
+
+static inline enum net_verdict process_l3(struct net_pkt *pkt,
+					  bool is_loopback)
+{
 	uint8_t family = net_pkt_family(pkt);
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (family == AF_INET || family == AF_INET6 ||
@@ -148,24 +155,32 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	return NET_DROP;
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static inline enum net_verdict process_data(struct net_pkt *pkt,
+					    bool is_loopback)
 {
-again:
-	switch (process_data(pkt, is_loopback)) {
-	case NET_CONTINUE:
-		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
-			/* If we have a tunneling packet, feed it back
-			 * to the stack in this case.
-			 */
-			goto again;
-		} else {
-			NET_DBG("Dropping pkt %p", pkt);
-			net_pkt_unref(pkt);
-		}
-		break;
+	enum net_verdict ret;
+
+	ret = process_l2(pkt, is_loopback);
+	if (ret != NET_CONTINUE) {
+		return ret;
+	}
+
+	return process_l3(pkt, is_loopback);
+}
+
+static void processing_verdict(struct net_pkt *pkt, bool is_loopback,
+			       enum net_verdict verdict)
+{
+	/* If we have a tunneling packet, feed it back to the stack */
+	while (IS_ENABLED(CONFIG_NET_L2_VIRTUAL) && verdict == NET_CONTINUE) {
+		verdict = process_data(pkt, is_loopback);
+	}
+
+	switch (verdict) {
 	case NET_OK:
 		NET_DBG("Consumed pkt %p", pkt);
 		break;
+	case NET_CONTINUE:
 	case NET_DROP:
 	default:
 		NET_DBG("Dropping pkt %p", pkt);
@@ -174,6 +189,11 @@ again:
 	}
 }
 
+static void processing_data(struct net_pkt *pkt, bool is_loopback)
+{
+	processing_verdict(pkt, is_loopback, process_data(pkt, is_loopback));
+}
+
 /* Things to setup after we are able to RX and TX */
 static void net_post_init(void)
 {
@@ -426,6 +446,15 @@ int net_try_send_data(struct net_pkt *pkt, k_timeout_t timeout)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* A TCP packet to be split is not split on its way back */
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U) {
+			ret = net_tcp_gso_finalize(pkt);
+			if (ret < 0) {
+				goto err;
+			}
+		}
+
 		processing_data(pkt, true);
 		ret = 0;
 		goto err;
@@ -484,9 +513,22 @@ err:
 	return ret;
 }
 
+static bool net_rx_is_loopback(struct net_if *iface)
+{
+	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
+#ifdef CONFIG_NET_L2_DUMMY
+		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+			return true;
+		}
+#endif
+	}
+
+	return false;
+}
+
 static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 {
-	bool is_loopback = false;
+	bool is_loopback = net_rx_is_loopback(iface);
 	size_t pkt_len;
 
 	pkt_len = net_pkt_get_len(pkt);
@@ -495,14 +537,6 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	net_stats_update_bytes_recv(iface, pkt_len);
 
-	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
-#ifdef CONFIG_NET_L2_DUMMY
-		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
-			is_loopback = true;
-		}
-#endif
-	}
-
 	processing_data(pkt, is_loopback);
 
 	net_print_statistics();
@@ -518,6 +552,75 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Same as net_process_rx_packet(), except that the TCP segments are held
+ * back after L2 so that the next ones of the same connection can be merged
+ * into them. The held packet must be flushed before the thread waits for
+ * more packets.
+ */
+void net_process_rx_packet_gro(struct net_tcp_gro *gro, struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	bool is_loopback = net_rx_is_loopback(iface);
+	enum net_verdict verdict;
+	size_t pkt_len;
+
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+	net_capture_pkt(iface, pkt);
+
+	pkt_len = net_pkt_get_len(pkt);
+
+	NET_DBG("Received pkt %p len %zu", pkt, pkt_len);
+
+	net_stats_update_bytes_recv(iface, pkt_len);
+
+	verdict = process_l2(pkt, is_loopback);
+	if (verdict != NET_CONTINUE) {
+		processing_verdict(pkt, is_loopback, verdict);
+		goto out;
+	}
+
+	if (gro->pkt != NULL) {
+		if (net_tcp_gro_merge(gro, pkt)) {
+			if (gro->full) {
+				net_process_rx_gro_flush(gro);
+			}
+
+			goto out;
+		}
+
+		net_process_rx_gro_flush(gro);
+	}
+
+	if (!net_tcp_gro_hold(gro, pkt)) {
+		processing_verdict(pkt, is_loopback, process_l3(pkt, is_loopback));
+	}
+
+out:
+	net_print_statistics();
+	net_pkt_print();
+}
+
+void net_process_rx_gro_flush(struct net_tcp_gro *gro)
+{
+	struct net_pkt *pkt = gro->pkt;
+	bool is_loopback;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	gro->pkt = NULL;
+
+	is_loopback = net_rx_is_loopback(net_pkt_iface(pkt));
+
+	net_pkt_cursor_init(pkt);
+
+	processing_verdict(pkt, is_loopback, process_l3(pkt, is_loopback));
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	size_t len = net_pkt_get_len(pkt);
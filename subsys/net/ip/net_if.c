@@ -453,6 +453,31 @@ static inline void init_iface(struct net_if *iface)
 }
 
 #if defined(CONFIG_NET_NATIVE)
+/* Check if the packets carrying several TCP segments need to be split in
+ * software, or if the device can do it.
+ */
+static bool need_tx_segmentation(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		if (IS_ENABLED(CONFIG_NET_VLAN) && net_eth_is_vlan_interface(iface)) {
+			iface = net_eth_get_vlan_main(iface);
+			if (iface == NULL) {
+				return true;
+			}
+		} else {
+			return true;
+		}
+	}
+
+	return !(net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO);
+#else
+	ARG_UNUSED(iface);
+
+	return true;
+#endif
+}
+
 enum net_verdict net_if_try_send_data(struct net_if *iface, struct net_pkt *pkt,
 				      k_timeout_t timeout)
 {
@@ -554,8 +579,14 @@ done:
 			net_if_call_link_cb(iface, dst, status);
 		}
 	} else if (verdict == NET_OK) {
-		/* Packet is ready to be sent by L2, let's queue */
-		net_if_try_queue_tx(iface, pkt, timeout);
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0U &&
+		    need_tx_segmentation(iface)) {
+			/* Split the packet and queue its segments to L2 */
+			net_tcp_gso_send(iface, pkt, timeout);
+		} else {
+			/* Packet is ready to be sent by L2, let's queue */
+			net_if_try_queue_tx(iface, pkt, timeout);
+		}
 	}
 
 	return verdict;
@@ -74,6 +74,41 @@ extern int net_icmp_call_ipv6_handlers(struct net_pkt *pkt,
 
 extern struct net_if *net_ipip_get_virtual_interface(struct net_if *input_iface);
 
+/* Splits a TCP packet in segments of net_pkt_gso_size() bytes, and queues
+ * them to the TX path of the interface. The packet is always consumed.
+ */
+extern void net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt,
+			     k_timeout_t timeout);
+
+/* Turns a TCP packet carrying several segments into a single large segment,
+ * with the checksum computed over all of its data, for the packets that are
+ * delivered back to us without being split.
+ */
+extern int net_tcp_gso_finalize(struct net_pkt *pkt);
+
+/* Received TCP packet held back by an RX traffic class thread, to which the
+ * next segments of the same connection are appended.
+ */
+struct net_tcp_gro {
+	struct net_pkt *pkt;
+	uint8_t segs;
+	bool full;
+};
+
+/* Starts holding pkt, which has been processed by L2, if later segments can
+ * be merged into it.
+ */
+extern bool net_tcp_gro_hold(struct net_tcp_gro *gro, struct net_pkt *pkt);
+
+/* Appends the data of pkt, which has been processed by L2, to the held
+ * packet if it is its next segment. The packet is consumed on success.
+ */
+extern bool net_tcp_gro_merge(struct net_tcp_gro *gro, struct net_pkt *pkt);
+
+extern void net_process_rx_packet_gro(struct net_tcp_gro *gro,
+				      struct net_pkt *pkt);
+extern void net_process_rx_gro_flush(struct net_tcp_gro *gro);
+
 #if defined(CONFIG_NET_STATISTICS_VIA_PROMETHEUS)
 extern void net_stats_prometheus_init(struct net_if *iface);
 #else
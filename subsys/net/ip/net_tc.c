@@ -296,6 +296,9 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 #endif
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_TCP_GRO)
+	struct net_tcp_gro gro = { 0 };
+#endif
 
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
@@ -307,7 +310,18 @@ static void tc_rx_handler(void *p1, void *p2, void *p3)
 		k_sem_give(fifo_slot);
 #endif
 
+#if defined(CONFIG_NET_TCP_GRO)
+		net_process_rx_packet_gro(&gro, pkt);
+
+		/* A segment is only held back while the next ones are
+		 * already queued.
+		 */
+		if (k_fifo_is_empty(fifo)) {
+			net_process_rx_gro_flush(&gro);
+		}
+#else
 		net_process_rx_packet(pkt);
+#endif
 	}
 }
 #endif
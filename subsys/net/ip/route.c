@@ -16,6 +16,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <limits.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/dlist.h>
 
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_core.h>
@@ -32,7 +33,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -263,19 +264,215 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/*
+ * Path compressed binary trie of the route prefixes. Every node stands for
+ * the first len bits of prefix and holds the routes with exactly that
+ * prefix. A node without routes always has two children, so there are less
+ * than two nodes per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	struct route_trie_node *parent;
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t len;
+};
+
+static struct route_trie_node route_trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *route_trie_root;
+
+/* Free nodes, linked through child[0] */
+static struct route_trie_node *route_trie_free;
+
+static inline uint8_t route_trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8U] >> (7U - pos % 8U)) & 1U;
+}
+
+/* Number of leading bits, up to max, that a and b have in common */
+static uint8_t route_trie_common_len(const struct in6_addr *a,
+				     const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_trie_node *route_trie_node_new(const struct in6_addr *prefix,
+						   uint8_t len)
+{
+	struct route_trie_node *tnode = route_trie_free;
+
+	/* The pool is large enough for a full route table */
+	NET_ASSERT(tnode != NULL, "No free route trie node");
+
+	route_trie_free = tnode->child[0];
+
+	*tnode = (struct route_trie_node){ .len = len };
+	net_ipaddr_copy(&tnode->prefix, prefix);
+	sys_slist_init(&tnode->routes);
+
+	return tnode;
+}
+
+static void route_trie_node_free(struct route_trie_node *tnode)
+{
+	tnode->child[0] = route_trie_free;
+	route_trie_free = tnode;
+}
+
+static inline struct route_trie_node **route_trie_link(struct route_trie_node *tnode)
+{
+	if (tnode->parent == NULL) {
+		return &route_trie_root;
+	}
+
+	return &tnode->parent->child[tnode->parent->child[1] == tnode];
+}
+
+static void route_trie_insert(struct net_route_entry *route)
+{
+	const struct in6_addr *prefix = &route->addr;
+	uint8_t len = route->prefix_len;
+	struct route_trie_node **link = &route_trie_root;
+	struct route_trie_node *parent = NULL;
+	struct route_trie_node *tnode;
+
+	while (*link != NULL) {
+		struct route_trie_node *cur = *link;
+		uint8_t common = route_trie_common_len(prefix, &cur->prefix,
+						       MIN(len, cur->len));
+
+		if (common < cur->len) {
+			struct route_trie_node *split;
+
+			/* The new prefix leaves the path to cur at bit common,
+			 * put a node there with cur below it.
+			 */
+			split = route_trie_node_new(prefix, common);
+			split->parent = parent;
+			split->child[route_trie_bit(&cur->prefix, common)] = cur;
+			cur->parent = split;
+			*link = split;
+
+			if (common == len) {
+				tnode = split;
+			} else {
+				tnode = route_trie_node_new(prefix, len);
+				tnode->parent = split;
+				split->child[route_trie_bit(prefix, common)] = tnode;
+			}
+
+			goto out;
+		}
+
+		if (cur->len == len) {
+			tnode = cur;
+			goto out;
+		}
+
+		parent = cur;
+		link = &cur->child[route_trie_bit(prefix, cur->len)];
+	}
+
+	tnode = route_trie_node_new(prefix, len);
+	tnode->parent = parent;
+	*link = tnode;
+
+out:
+	sys_slist_prepend(&tnode->routes, &route->trie_node);
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node *tnode = route_trie_root;
+
+	while (tnode != NULL && tnode->len < route->prefix_len) {
+		tnode = tnode->child[route_trie_bit(&route->addr, tnode->len)];
+	}
+
+	if (tnode == NULL || tnode->len != route->prefix_len ||
+	    !sys_slist_find_and_remove(&tnode->routes, &route->trie_node)) {
+		return;
+	}
+
+	/* Drop the nodes that are no longer needed to tell routes apart */
+	while (tnode != NULL && sys_slist_is_empty(&tnode->routes) &&
+	       (tnode->child[0] == NULL || tnode->child[1] == NULL)) {
+		struct route_trie_node *child = tnode->child[0] != NULL ?
+						tnode->child[0] : tnode->child[1];
+		struct route_trie_node *parent = tnode->parent;
+
+		*route_trie_link(tnode) = child;
+		if (child != NULL) {
+			child->parent = parent;
+		}
+
+		route_trie_node_free(tnode);
+		tnode = parent;
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct net_route_entry *found = NULL;
+	struct route_trie_node *tnode = route_trie_root;
+	struct net_route_entry *route;
+
+	/* Deeper nodes have longer prefixes, so the last match is the best */
+	while (tnode != NULL &&
+	       route_trie_common_len(dst, &tnode->prefix, tnode->len) == tnode->len) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&tnode->routes, route, trie_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (tnode->len == 128U) {
+			break;
+		}
+
+		tnode = tnode->child[route_trie_bit(dst, tnode->len)];
+	}
+
+	return found;
+}
+#else
+static inline void route_trie_insert(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+}
+
+static inline void route_trie_remove(struct net_route_entry *route)
+{
+	ARG_UNUSED(route);
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	net_ipv6_nbr_lock();
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -298,6 +495,18 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	net_ipv6_nbr_lock();
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -393,9 +602,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -444,7 +653,8 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
+	route_trie_insert(route);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -586,7 +796,11 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
+
+	route_trie_remove(route);
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -1128,6 +1342,12 @@ void net_route_init(void)
 	NET_DBG("Allocated %d nexthop entries (%zu bytes)",
 		CONFIG_NET_MAX_NEXTHOPS, sizeof(net_route_nexthop_pool));
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	for (int i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		route_trie_node_free(&route_trie_nodes[i]);
+	}
+#endif
+
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	memset(route_mcast_entries, 0, sizeof(route_mcast_entries));
 #endif
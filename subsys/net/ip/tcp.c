@@ -514,29 +514,270 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
-static void tcp_ca_init(struct tcp *conn)
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+
+/* Implementation according to RFC9438. The fast recovery phase is the same as
+ * in New Reno, only the window reduction and its growth in congestion
+ * avoidance differ.
+ */
+
+/* beta_cubic = 0.7, C = 0.4 and alpha_cubic = 3 * (1 - beta) / (1 + beta) */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+/* Limit of |t - K| so that the cube of it, in ms, fits with the MSS in 64 bits */
+#define CUBIC_MAX_DELTA_MS 30000
+
+static uint32_t tcp_cubic_cbrt(uint64_t value)
+{
+	uint32_t root = 0;
+
+	/* Bitwise cube root, the result fits in 22 bits */
+	for (int shift = 63; shift >= 0; shift -= 3) {
+		uint64_t b;
+
+		root <<= 1;
+		b = 3 * (uint64_t)root * (root + 1) + 1;
+
+		if ((value >> shift) >= b) {
+			value -= b << shift;
+			root++;
+		}
+	}
+
+	return root;
+}
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%u, k=%u, fast_pend=%i",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh, conn->cubic.w_max,
+		conn->cubic.k, conn->ca.pending_fast_retransmit_bytes);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
 {
 	tcp_new_reno_init(conn);
+	memset(&conn->cubic, 0, sizeof(conn->cubic));
+	tcp_cubic_log(conn, "init");
+}
+
+/* Remember where the window was before reducing it, and start a new epoch */
+static uint32_t tcp_cubic_reduce(struct tcp *conn)
+{
+	uint32_t cwnd = conn->ca.cwnd;
+
+	if (cwnd < conn->cubic.w_max) {
+		/* Fast convergence, release bandwidth for new flows */
+		conn->cubic.w_max = cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+				    (2 * CUBIC_BETA_DEN);
+	} else {
+		conn->cubic.w_max = cwnd;
+	}
+
+	conn->cubic.epoch_start = 0;
+
+	return MAX(conn_mss(conn) * 2U, MIN(cwnd, (uint32_t)conn->unacked_len) *
+					 CUBIC_BETA_NUM / CUBIC_BETA_DEN);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		conn->ca.ssthresh = tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = MIN(conn_mss(conn) * 3 + conn->ca.ssthresh, UINT16_MAX);
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	conn->ca.ssthresh = tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static uint32_t tcp_cubic_target(struct tcp *conn, uint16_t mss)
+{
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	int64_t delta;
+	int64_t target;
+
+	if (conn->cubic.epoch_start == 0) {
+		/* 0 means that no epoch is running */
+		conn->cubic.epoch_start = now ? now : 1;
+		conn->cubic.w_est = cwnd;
+
+		if (cwnd < conn->cubic.w_max) {
+			/* K = cbrt((W_max - cwnd) / C), in ms */
+			conn->cubic.k = tcp_cubic_cbrt((uint64_t)(conn->cubic.w_max - cwnd) *
+						       2500000000ULL / mss);
+			conn->cubic.origin = conn->cubic.w_max;
+		} else {
+			conn->cubic.k = 0;
+			conn->cubic.origin = cwnd;
+		}
+	}
+
+	delta = (int64_t)(uint32_t)(now - conn->cubic.epoch_start) - conn->cubic.k;
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max, with t in seconds */
+	target = (int64_t)conn->cubic.origin +
+		 2 * mss * delta * delta * delta / 5000000000LL;
+
+	/* Do not grow by more than half of the window per RTT */
+	return CLAMP(target, (int64_t)cwnd, (int64_t)cwnd * 3 / 2);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	uint16_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, mss);
+	uint32_t new_win;
+	uint32_t target;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0 || cwnd < conn->ca.ssthresh) {
+		/* Fast recovery and slow start behave as in New Reno */
+		tcp_new_reno_pkts_acked(conn, acked_len);
+		return;
+	}
+
+	target = tcp_cubic_target(conn, mss);
+
+	/* Implement a div_ceil to avoid rounding to 0 */
+	new_win = cwnd + ((target - cwnd) * win_inc + cwnd - 1) / cwnd;
+
+	/* Never be slower than Reno would be in the same conditions */
+	conn->cubic.w_est += (CUBIC_ALPHA_NUM * win_inc * mss + CUBIC_ALPHA_DEN * cwnd - 1) /
+			     (CUBIC_ALPHA_DEN * cwnd);
+	new_win = MAX(new_win, conn->cubic.w_est);
+
+	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CA_CUBIC */
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+	&tcp_ca_cubic,
+#endif
+};
+
+static const struct tcp_ca_ops *tcp_ca_default(void)
+{
+#ifdef CONFIG_NET_TCP_CA_DEFAULT_CUBIC
+	return &tcp_ca_cubic;
+#else
+	return &tcp_ca_new_reno;
+#endif
+}
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		if (strlen(tcp_ca_algorithms[i]->name) == len &&
+		    strncmp(tcp_ca_algorithms[i]->name, name, len) == 0) {
+			return tcp_ca_algorithms[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_ca_init(struct tcp *conn)
+{
+	conn->ca_ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->pkts_acked(conn, acked_len);
+}
+
+/* Accepted connections use the algorithm chosen for the listening socket */
+static void tcp_ca_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca_ops = from->ca_ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	/* Accept the name with or without its terminating null character */
+	len = strnlen(value, MIN(len, TCP_CA_NAME_MAX));
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca_ops) {
+		conn->ca_ops = ops;
+
+		/* Restart from the initial window if the algorithm is already running */
+		if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+			tcp_ca_init(conn);
+		}
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca_ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	/* Truncate the name if it does not fit, as Linux does */
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca_ops->name, name_len);
+	*len = name_len;
+
+	return 0;
 }
 #else
 
@@ -550,6 +791,18 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+static void tcp_ca_copy(struct tcp *to, struct tcp *from) { }
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	return -ENOPROTOOPT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	return -ENOPROTOOPT;
+}
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -1011,6 +1264,7 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	recv_options->mss_found = false;
 	recv_options->wnd_found = false;
+	recv_options->sack_perm_found = false;
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1059,6 +1313,33 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 			recv_options->window = opt;
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count = MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+						       NET_TCP_MAX_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start = sys_get_be32(block);
+				recv_options->sack[i].end = sys_get_be32(block + 4);
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1131,6 +1412,17 @@ static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
 	return 0;
 }
 
+/* Returns the last buffer of the run of contiguous data that starts at buf */
+static struct net_buf *tcp_queue_run_last(struct net_buf *buf)
+{
+	while (buf->frags != NULL &&
+	       tcp_get_seq(buf->frags) == tcp_get_seq(buf) + buf->len) {
+		buf = buf->frags;
+	}
+
+	return buf;
+}
+
 static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 				     size_t len)
 {
@@ -1138,55 +1430,45 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 
 	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
 	    !net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off   | Gap size | Required handling
-		 * Seq|Len|Seq|Len|           |          |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | 6-3-3=0  | Append
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | 6-3-4=-1 | Append, pull from queue
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3-7=-4 | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3-8=-5 | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6-5=-5 | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6-4=-4 | Drop queued data / packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10-2=-6| Should not happen, dropping queue
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7-4=-5 | Should not happen, dropping queue
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11-2=-7| Should not happen, dropping queue
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2-3=1  | Keep queued data
+		/* The queue holds runs of contiguous data, sorted by sequence
+		 * number and separated by gaps. Drop the queued data that the
+		 * packet makes redundant, then if the first run starts within
+		 * the packet or right after it, move that run, but not the
+		 * ones after the next gap, to the end of the packet.
 		 */
-		struct tcphdr *th = th_get(pkt);
-		uint32_t expected_seq = th_seq(th) + len;
-		uint32_t pending_seq;
-		int32_t gap_size;
-		uint32_t end_offset;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = expected_seq - pending_seq;
-		gap_size = (int32_t)(pending_seq - th_seq(th) - ((uint32_t)len));
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset) {
-				net_pkt_remove_tail(pkt, end_offset);
-				pending_len -= end_offset;
+		uint32_t expected_seq = conn->ack + len;
+		struct net_buf *head = conn->queue_recv_data->buffer;
+		struct net_buf *last;
+		uint32_t overlap;
+
+		while (head != NULL &&
+		       (!net_tcp_seq_greater(tcp_get_seq(head) + head->len, expected_seq) ||
+			net_tcp_seq_greater(conn->ack, tcp_get_seq(head)))) {
+			head = net_buf_frag_del(NULL, head);
+		}
+
+		conn->queue_recv_data->buffer = head;
+
+		if (head != NULL && !net_tcp_seq_greater(tcp_get_seq(head), expected_seq)) {
+			last = tcp_queue_run_last(head);
+			conn->queue_recv_data->buffer = last->frags;
+			last->frags = NULL;
+
+			overlap = expected_seq - tcp_get_seq(head);
+			pending_len = net_buf_frags_len(head);
+			if (overlap) {
+				net_pkt_remove_tail(pkt, overlap);
+				pending_len -= overlap;
 			}
 
 			NET_DBG("Found pending data seq %u len %zd",
 				expected_seq, pending_len);
 
-			net_buf_frag_add(pkt->buffer,
-					 conn->queue_recv_data->buffer);
-			conn->queue_recv_data->buffer = NULL;
+			net_buf_frag_add(pkt->buffer, head);
+		}
 
+		if (net_pkt_is_empty(conn->queue_recv_data)) {
 			k_work_cancel_delayable(&conn->recv_queue_timer);
-		} else {
-			/* Check if the queued data is just a section of the incoming data */
-			if (gap_size <= 0) {
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-
-				k_work_cancel_delayable(&conn->recv_queue_timer);
-			}
-
-			pending_len = 0;
 		}
 	}
 
@@ -1250,7 +1532,7 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1270,6 +1552,8 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	th->th_off += opts_len / 4;
+
 	UNALIGNED_PUT(flags, &th->th_flags);
 	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
@@ -1453,10 +1737,106 @@ err:
 	tcp_pkt_unref(rst);
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Fills blocks with the runs of the out-of-order queue, the one holding the
+ * most recently queued data first, as RFC 2018 asks for.
+ */
+static int tcp_sack_blocks_get(struct tcp *conn, struct tcp_sack_block *blocks)
+{
+	struct net_buf *buf;
+	struct net_buf *last;
+	uint32_t start;
+	uint32_t end;
+	int count = 1;
+	bool found = false;
+
+	for (buf = conn->queue_recv_data->buffer; buf != NULL; buf = last->frags) {
+		last = tcp_queue_run_last(buf);
+		start = tcp_get_seq(buf);
+		end = tcp_get_seq(last) + last->len;
+
+		if (!found && (conn->sack_last_seq - start) < (end - start)) {
+			blocks[0].start = start;
+			blocks[0].end = end;
+			found = true;
+		} else if (count < NET_TCP_MAX_SACK_BLOCKS) {
+			blocks[count].start = start;
+			blocks[count].end = end;
+			count++;
+		}
+	}
+
+	if (!found) {
+		count--;
+		memmove(&blocks[0], &blocks[1], count * sizeof(blocks[0]));
+	}
+
+	return count;
+}
+
+/* Writes the SACK related options of a segment to buf and returns their
+ * length, which is a multiple of 4.
+ */
+static size_t tcp_sack_options_get(struct tcp *conn, uint8_t flags, bool has_data,
+				   uint8_t *buf)
+{
+	struct tcp_sack_block blocks[NET_TCP_MAX_SACK_BLOCKS];
+	int count;
+
+	if (flags & RST) {
+		return 0;
+	}
+
+	if (flags & SYN) {
+		/* Offer SACK in a SYN, and accept it in a SYN-ACK if offered */
+		if ((flags & ACK) && !conn->sack_permitted) {
+			return 0;
+		}
+
+		buf[0] = NET_TCP_NOP_OPT;
+		buf[1] = NET_TCP_NOP_OPT;
+		buf[2] = NET_TCP_SACK_PERM_OPT;
+		buf[3] = NET_TCP_SACK_PERM_SIZE;
+
+		return 4;
+	}
+
+	/* Only pure ACKs carry SACK blocks, so that data segments keep the
+	 * size allowed by the MSS.
+	 */
+	if (!conn->sack_permitted || has_data || !(flags & ACK) ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	count = tcp_sack_blocks_get(conn, blocks);
+
+	buf[0] = NET_TCP_NOP_OPT;
+	buf[1] = NET_TCP_NOP_OPT;
+	buf[2] = NET_TCP_SACK_OPT;
+	buf[3] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (int i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].start, &buf[4 + i * NET_TCP_SACK_BLOCK_SIZE]);
+		sys_put_be32(blocks[i].end, &buf[8 + i * NET_TCP_SACK_BLOCK_SIZE]);
+	}
+
+	return 4 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+#else
+static inline size_t tcp_sack_options_get(struct tcp *conn, uint8_t flags, bool has_data,
+					  uint8_t *buf)
+{
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
 	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[NET_TCP_MAX_OPTS_LEN - NET_TCP_MSS_SIZE];
+	size_t opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
@@ -1464,6 +1844,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	opts_len = tcp_sack_options_get(conn, flags, data != NULL, opts);
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1471,6 +1854,11 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		/* Let the packet be split late if it is larger than a segment */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_gso_size(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1482,7 +1870,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
@@ -1496,6 +1884,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -1659,13 +2055,23 @@ static void tcp_setup_retransmission(struct tcp *conn)
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer, K_MSEC(TCP_RTO_MS));
 }
 
+/* Largest amount of data sent in one packet */
+static int tcp_send_len_max(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_GSO
+	return MIN(conn_mss(conn) * CONFIG_NET_TCP_GSO_MAX_SEGS, NET_TCP_GSO_MAX_LEN);
+#else
+	return conn_mss(conn);
+#endif
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
 	struct net_pkt *pkt;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	len = MIN(tcp_unsent_len(conn), tcp_send_len_max(conn));
 	if (len < 0) {
 		ret = len;
 		goto out;
@@ -1676,7 +2082,27 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
+	if (len > conn_mss(conn)) {
+		/* Only send several segments at once if the buffers are at hand.
+		 * The packet only carries the data, which is appended to the one
+		 * holding the headers: allocate its buffer raw, as the buffers
+		 * of IP packets are capped at the MTU without fragmentation.
+		 */
+		pkt = net_pkt_alloc(K_NO_WAIT);
+		tp_pkt_alloc(pkt, tp_basename(__FILE__), __LINE__);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len, K_NO_WAIT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+
+		if (!pkt) {
+			len = conn_mss(conn);
+			pkt = tcp_pkt_alloc(conn, len);
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
+	}
+
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
 		ret = -ENOBUFS;
@@ -1715,6 +2141,212 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Adds a range to the scoreboard, merging it with the ranges it overlaps or
+ * touches. When the scoreboard is full, the highest range is forgotten.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int i = 0;
+	int j;
+
+	while (i < conn->sacked_count && net_tcp_seq_greater(start, sacked[i].end)) {
+		i++;
+	}
+
+	for (j = i; j < conn->sacked_count && !net_tcp_seq_greater(sacked[j].start, end); j++) {
+		if (net_tcp_seq_greater(start, sacked[j].start)) {
+			start = sacked[j].start;
+		}
+
+		if (net_tcp_seq_greater(sacked[j].end, end)) {
+			end = sacked[j].end;
+		}
+	}
+
+	if (i == j) {
+		if (i == TCP_SACK_SCOREBOARD_SIZE) {
+			return;
+		}
+
+		if (conn->sacked_count == TCP_SACK_SCOREBOARD_SIZE) {
+			conn->sacked_count--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i],
+			(conn->sacked_count - i) * sizeof(sacked[0]));
+		conn->sacked_count++;
+	} else {
+		memmove(&sacked[i + 1], &sacked[j],
+			(conn->sacked_count - j) * sizeof(sacked[0]));
+		conn->sacked_count -= j - i - 1;
+	}
+
+	sacked[i].start = start;
+	sacked[i].end = end;
+}
+
+/* Adds the SACK blocks of the received segment to the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+	uint32_t start;
+	uint32_t end;
+
+	if (!conn->sack_permitted) {
+		return;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		start = conn->recv_options.sack[i].start;
+		end = conn->recv_options.sack[i].end;
+
+		/* Ignore the blocks that are invalid, or only report data that
+		 * is already acknowledged (D-SACK).
+		 */
+		if (!net_tcp_seq_greater(end, start) ||
+		    !net_tcp_seq_greater(end, conn->seq) ||
+		    net_tcp_seq_greater(end, snd_max)) {
+			continue;
+		}
+
+		if (net_tcp_seq_greater(conn->seq, start)) {
+			start = conn->seq;
+		}
+
+		tcp_sack_insert(conn, start, end);
+	}
+}
+
+/* Forgets the ranges that the cumulative ACK now covers */
+static void tcp_sack_acked(struct tcp *conn)
+{
+	int i = 0;
+
+	while (i < conn->sacked_count && !net_tcp_seq_greater(conn->sacked[i].end, conn->seq)) {
+		i++;
+	}
+
+	conn->sacked_count -= i;
+	memmove(&conn->sacked[0], &conn->sacked[i], conn->sacked_count * sizeof(conn->sacked[0]));
+
+	if (conn->sacked_count > 0 && net_tcp_seq_greater(conn->seq, conn->sacked[0].start)) {
+		conn->sacked[0].start = conn->seq;
+	}
+
+	if (conn->sack_recovery && !net_tcp_seq_greater(conn->sack_recovery_point, conn->seq)) {
+		NET_DBG("conn: %p fast recovery done", conn);
+		conn->sack_recovery = false;
+	}
+}
+
+/* Forgets everything the peer reported, as it may drop out-of-order data */
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sacked_count = 0;
+	conn->sack_recovery = false;
+}
+
+static bool tcp_sack_in_recovery(struct tcp *conn)
+{
+	return conn->sack_recovery;
+}
+
+/* Resends the first segment of the next hole in the data the peer holds, if
+ * there is any below the highest SACKed sequence number.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t seq = conn->sack_rexmit_next;
+	struct net_pkt *pkt;
+	int len;
+	int ret;
+	int i;
+
+	if (net_tcp_seq_greater(conn->seq, seq)) {
+		seq = conn->seq;
+	}
+
+	for (i = 0; i < conn->sacked_count; i++) {
+		if (!net_tcp_seq_greater(conn->sacked[i].end, seq)) {
+			continue;
+		}
+
+		if (!net_tcp_seq_greater(conn->sacked[i].start, seq)) {
+			seq = conn->sacked[i].end;
+			continue;
+		}
+
+		break;
+	}
+
+	if (i == conn->sacked_count) {
+		return false;
+	}
+
+	len = MIN(conn->sacked[i].start - seq, conn_mss(conn));
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return false;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, seq - conn->seq, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return false;
+	}
+
+	NET_DBG("conn: %p resending seq %u len %d", conn, seq, len);
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, seq);
+	if (ret == 0) {
+		conn->sack_rexmit_next = seq + len;
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+	tcp_pkt_unref(pkt);
+
+	return ret == 0;
+}
+
+/* Enters fast recovery guided by the scoreboard, if the peer reported any
+ * data, and resends the first hole.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_permitted || conn->sacked_count == 0) {
+		return false;
+	}
+
+	conn->sack_recovery_point = conn->seq + conn->unacked_len;
+	conn->sack_rexmit_next = conn->seq;
+
+	if (!tcp_sack_retransmit(conn)) {
+		return false;
+	}
+
+	conn->sack_recovery = true;
+
+	return true;
+}
+#else
+static inline void tcp_sack_update(struct tcp *conn) { }
+
+static inline void tcp_sack_acked(struct tcp *conn) { }
+
+static inline void tcp_sack_reset(struct tcp *conn) { }
+
+static inline bool tcp_sack_in_recovery(struct tcp *conn) { return false; }
+
+static inline bool tcp_sack_retransmit(struct tcp *conn) { return false; }
+
+static inline bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1815,6 +2447,7 @@ static void tcp_resend_data(struct k_work *work)
 
 		conn->data_mode = TCP_DATA_MODE_RESEND;
 		conn->unacked_len = 0;
+		tcp_sack_reset(conn);
 
 		ret = tcp_send_data(conn);
 		if (ret == -ENODATA) {
@@ -2058,6 +2691,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca_ops = tcp_ca_default();
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2479,7 +3113,7 @@ static bool check_seq_list(struct net_buf *buf)
 		NET_DBG("buf %p seq %u len %d", tmp, seq, tmp->len);
 
 		if (last != NULL) {
-			if (next_seq != seq) {
+			if (net_tcp_seq_greater(next_seq, seq)) {
 				result = false;
 			}
 		}
@@ -2494,18 +3128,67 @@ static bool check_seq_list(struct net_buf *buf)
 static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 				size_t len, uint32_t seq)
 {
-	uint32_t seq_start = seq;
-	bool inserted = false;
+	struct net_buf *prev = NULL;
+	struct net_buf *next;
 	struct net_buf *tmp;
+	uint32_t prev_end;
+	uint32_t end;
+	size_t cut;
 
 	NET_DBG("conn: %p len %zd seq %u ack %u", conn, len, seq, conn->ack);
 
-	tmp = pkt->buffer;
+	/* The queue holds runs of contiguous data, sorted by sequence number
+	 * and separated by gaps. Find the last buffer that starts before the
+	 * new data and the first one that does not. Sequence numbers are
+	 * compared as offsets from the ack, to handle the wrapping point.
+	 */
+	next = conn->queue_recv_data->buffer;
+	while (next != NULL && (tcp_get_seq(next) - conn->ack) < (seq - conn->ack)) {
+		prev = next;
+		next = next->frags;
+	}
+
+	/* Skip the head of the new data that is already queued */
+	if (prev != NULL) {
+		prev_end = tcp_get_seq(prev) + prev->len;
 
-	tcp_set_seq(tmp, seq);
-	seq += tmp->len;
-	tmp = tmp->frags;
+		if (net_tcp_seq_greater(prev_end, seq)) {
+			cut = prev_end - seq;
+			if (cut >= len) {
+				NET_DBG("Data already queued");
+				return;
+			}
+
+			tcp_pkt_pull(pkt, cut);
+			seq += cut;
+			len -= cut;
+		}
+	}
+
+	end = seq + len;
+
+	/* Drop the queued data that the new data covers */
+	while (next != NULL &&
+	       !net_tcp_seq_greater(tcp_get_seq(next) + next->len, end)) {
+		next = net_buf_frag_del(prev, next);
+		if (prev == NULL) {
+			conn->queue_recv_data->buffer = next;
+		}
+	}
+
+	/* Skip the tail of the new data that is already queued */
+	if (next != NULL && net_tcp_seq_greater(end, tcp_get_seq(next))) {
+		cut = end - tcp_get_seq(next);
+		if (cut >= len) {
+			NET_DBG("Data already queued");
+			return;
+		}
 
+		net_pkt_remove_tail(pkt, cut);
+		len -= cut;
+	}
+
+	tmp = pkt->buffer;
 	while (tmp) {
 		tcp_set_seq(tmp, seq);
 		seq += tmp->len;
@@ -2516,114 +3199,37 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 		NET_DBG("Queuing data: conn %p", conn);
 	}
 
-	if (!net_pkt_is_empty(conn->queue_recv_data)) {
-		/* Place the data to correct place in the list. If the data
-		 * would not be sequential, then drop this packet.
-		 *
-		 * Only work with subtractions between sequence numbers in uint32_t format
-		 * to proper handle cases that are around the wrapping point.
-		 */
-
-		/* Some potentential cases:
-		 * Note: MI = MAX_INT
-		 * Packet | Queued| End off1  | Start off| End off2    | Required handling
-		 * Seq|Len|Seq|Len|           |          |             |
-		 *  3 | 3 | 6 | 4 | 3+3-6=  0 | NA       | NA          | Prepend
-		 *  3 | 4 | 6 | 4 | 3+4-6 = 1 | NA       | NA          | Prepend, pull from buffer
-		 *  3 | 7 | 6 | 4 | 3+7-6 = 4 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  3 | 8 | 6 | 4 | 3+8-6 = 5 | 6-3=3    | 6+4-3=7     | Drop queued data
-		 *  6 | 5 | 6 | 4 | 6+5-6 = 5 | 6-6=0    | 6+4-6=4     | Drop queued data
-		 *  6 | 4 | 6 | 4 | 6+4-6 = 4 | 6-6=0    | 6+4-6=4     | Drop queued data / packet
-		 *  7 | 2 | 6 | 4 | 7+2-6 = 3 | 6-7=MI   | 6+4-7=3     | Drop packet
-		 * 10 | 2 | 6 | 4 | 10+2-6= 6 | 6-10=MI-3| 6+4-10=0    | Append
-		 *  7 | 4 | 6 | 4 | 7+4-6 = 5 | 6-7 =MI  | 6+4-7 =3    | Append, pull from packet
-		 * 11 | 2 | 6 | 4 | 11+2-6= 7 | 6-11=MI-6| 6+4-11=MI-1 | Drop incoming packet
-		 *  2 | 3 | 6 | 4 | 2+3-6= MI | 6-2=4    | 6+4-2=8     | Drop incoming packet
-		 */
-
-		uint32_t pending_seq;
-		uint32_t start_offset;
-		uint32_t end_offset;
-		size_t pending_len;
-
-		pending_seq = tcp_get_seq(conn->queue_recv_data->buffer);
-		end_offset = seq - pending_seq;
-		pending_len = net_pkt_get_len(conn->queue_recv_data);
-		if (end_offset < pending_len) {
-			if (end_offset < len) {
-				if (end_offset) {
-					net_pkt_remove_tail(pkt, end_offset);
-				}
-
-				/* Put new data before the pending data */
-				net_buf_frag_add(pkt->buffer,
-						 conn->queue_recv_data->buffer);
-				NET_DBG("Adding at before queue, end_offset %i, pending_len %zu",
-					end_offset, pending_len);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			}
-		} else {
-			struct net_buf *last;
-
-			last = net_buf_frag_last(conn->queue_recv_data->buffer);
-			pending_seq = tcp_get_seq(last);
-
-			start_offset = pending_seq - seq_start;
-			/* Compute the offset w.r.t. the start point of the new packet */
-			end_offset = (pending_seq + last->len) - seq_start;
+#ifdef CONFIG_NET_TCP_SACK
+	conn->sack_last_seq = tcp_get_seq(pkt->buffer);
+#endif
 
-			/* Check if queue start with within the within the new packet */
-			if ((start_offset < len) && (end_offset <= len)) {
-				/* The queued data is irrelevant since the new packet overlaps the
-				 * new packet, take the new packet as contents
-				 */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = pkt->buffer;
-				inserted = true;
-			} else {
-				if (end_offset < len) {
-					if (end_offset) {
-						net_pkt_remove_tail(conn->queue_recv_data,
-								    end_offset);
-					}
-
-					/* Put new data after pending data */
-					NET_DBG("Adding at end of queue, start %i, end %i, len %zu",
-						start_offset, end_offset, len);
-					net_buf_frag_add(conn->queue_recv_data->buffer,
-							 pkt->buffer);
-					inserted = true;
-				}
-			}
+	if (prev != NULL) {
+		net_buf_frag_insert(prev, pkt->buffer);
+	} else {
+		if (next != NULL) {
+			net_buf_frag_add(pkt->buffer, next);
 		}
 
-		if (inserted) {
-			NET_DBG("All pending data: conn %p", conn);
-			if (check_seq_list(conn->queue_recv_data->buffer) == false) {
-				NET_ERR("Incorrect order in out of order sequence for conn %p",
-					conn);
-				/* error in sequence list, drop it */
-				net_buf_unref(conn->queue_recv_data->buffer);
-				conn->queue_recv_data->buffer = NULL;
-			}
-		} else {
-			NET_DBG("Cannot add new data to queue");
-		}
-	} else {
+		conn->queue_recv_data->buffer = NULL;
 		net_pkt_append_buffer(conn->queue_recv_data, pkt->buffer);
-		inserted = true;
 	}
 
-	if (inserted) {
-		/* We need to keep the received data but free the pkt */
-		pkt->buffer = NULL;
+	/* We need to keep the received data but free the pkt */
+	pkt->buffer = NULL;
 
-		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
-			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
-				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
-		}
+	if (check_seq_list(conn->queue_recv_data->buffer) == false) {
+		NET_ERR("Incorrect order in out of order sequence for conn %p",
+			conn);
+		/* error in sequence list, drop it */
+		net_buf_unref(conn->queue_recv_data->buffer);
+		conn->queue_recv_data->buffer = NULL;
+		return;
+	}
+
+	if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
+		k_work_reschedule_for_queue(
+			&tcp_work_q, &conn->recv_queue_timer,
+			K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 	}
 }
 
@@ -2727,6 +3333,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+	uint32_t seg_seq;
 	size_t len;
 	int ret;
 	int close_status = 0;
@@ -2805,6 +3412,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_TCP_SACK
+	conn->recv_options.sack_count = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2858,6 +3469,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+#ifdef CONFIG_NET_TCP_SACK
+			conn->sack_permitted = conn->recv_options.sack_perm_found;
+#endif
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2887,6 +3501,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -2974,6 +3589,9 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			k_work_cancel_delayable(&conn->send_data_timer);
+#ifdef CONFIG_NET_TCP_SACK
+			conn->sack_permitted = conn->recv_options.sack_perm_found;
+#endif
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3047,6 +3665,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		 */
 		keep_alive_timer_restart(conn);
 
+		tcp_sack_update(conn);
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3064,18 +3684,25 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
-			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
-			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+			if (tcp_sack_in_recovery(conn)) {
+				/* Each further duplicate ACK lets the next hole be resent */
+				if (len == 0) {
+					(void)tcp_sack_retransmit(conn);
+				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Only do fast retransmit when not already in a resend state */
+				if (!tcp_sack_recovery_start(conn)) {
+					/* Apply a fast retransmit */
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
@@ -3127,6 +3754,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			tcp_sack_acked(conn);
+			if (tcp_sack_in_recovery(conn)) {
+				/* Partial ACK, resend the next hole */
+				(void)tcp_sack_retransmit(conn);
+			}
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3174,7 +3807,21 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			}
 		}
 
-		if (th_seq(th) == conn->ack) {
+		seg_seq = th_seq(th);
+
+		/* A segment that starts with data we already have, but also
+		 * brings new data, comes from a peer that repacketized its
+		 * retransmission. As tcp_data_get() takes the data from the
+		 * end of the packet, keeping the new part only needs the
+		 * length to be adjusted.
+		 */
+		if (len > 0 && net_tcp_seq_greater(conn->ack, seg_seq) &&
+		    net_tcp_seq_greater(seg_seq + len, conn->ack)) {
+			len -= conn->ack - seg_seq;
+			seg_seq = conn->ack;
+		}
+
+		if (seg_seq == conn->ack) {
 			if (len > 0) {
 				bool psh = FL(&fl, &, PSH);
 
@@ -3187,7 +3834,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 				/* ACK, no data */
 				verdict = NET_OK;
 			}
-		} else if (net_tcp_seq_greater(conn->ack, th_seq(th))) {
+		} else if (net_tcp_seq_greater(conn->ack, seg_seq)) {
 			/* This should handle the acknowledgements of keep alive
 			 * packets and retransmitted data.
 			 * RISK:
@@ -3200,7 +3847,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			net_stats_update_tcp_seg_ackerr(conn->iface);
 			verdict = NET_OK;
 		} else if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT) {
-			tcp_out_of_order_data(conn, pkt, len, th_seq(th));
+			tcp_out_of_order_data(conn, pkt, len, seg_seq);
 			/* Send out a duplicated ACK */
 			if ((len > 0) || FL(&fl, &, FIN)) {
 				tcp_out(conn, ACK);
@@ -3987,7 +4634,9 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) {
+	/* The checksum of a packet to be split is computed for each segment */
+	if ((net_if_need_calc_tx_checksum(net_pkt_iface(pkt), type) || force_chksum) &&
+	    net_pkt_gso_size(pkt) == 0U) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
 	}
@@ -4005,6 +4654,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 	    (net_if_need_calc_rx_checksum(net_pkt_iface(pkt), type) ||
 	     net_pkt_is_ip_reassembled(pkt)) &&
+	    !net_pkt_is_chksum_verified(pkt) &&
 	    net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
@@ -4453,6 +5103,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4490,6 +5143,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
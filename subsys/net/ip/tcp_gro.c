@@ -0,0 +1,244 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Merging of the consecutive TCP segments of a connection received in a
+ * burst, before they are passed to TCP.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+struct tcp_gro_seg {
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+	};
+	struct net_tcp_hdr *tcp;
+	size_t hdr_len;
+	size_t data_len;
+	uint8_t family;
+};
+
+/* Finds the headers of a data segment that can be merged with others. The
+ * headers must be in the first buffer, so that they can be updated in place.
+ */
+static int tcp_gro_parse(struct net_pkt *pkt, struct tcp_gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t len = net_pkt_get_len(pkt);
+	size_t ip_len;
+
+	if (buf == NULL || buf->len < sizeof(struct net_ipv4_hdr) ||
+	    net_pkt_is_ip_reassembled(pkt)) {
+		return -EINVAL;
+	}
+
+	seg->ipv4 = (struct net_ipv4_hdr *)buf->data;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg->ipv4->vhl == 0x45) {
+		if (seg->ipv4->proto != IPPROTO_TCP || ntohs(seg->ipv4->len) != len ||
+		    (sys_get_be16(seg->ipv4->offset) &
+		     (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) != 0U) {
+			return -EINVAL;
+		}
+
+		ip_len = sizeof(struct net_ipv4_hdr);
+		seg->family = AF_INET;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (seg->ipv4->vhl & 0xf0) == 0x60) {
+		if (buf->len < sizeof(struct net_ipv6_hdr) ||
+		    seg->ipv6->nexthdr != IPPROTO_TCP ||
+		    ntohs(seg->ipv6->len) + sizeof(struct net_ipv6_hdr) != len) {
+			return -EINVAL;
+		}
+
+		ip_len = sizeof(struct net_ipv6_hdr);
+		seg->family = AF_INET6;
+	} else {
+		return -EINVAL;
+	}
+
+	seg->hdr_len = ip_len + sizeof(struct net_tcp_hdr);
+	if (buf->len < seg->hdr_len || len <= seg->hdr_len) {
+		return -EINVAL;
+	}
+
+	seg->tcp = (struct net_tcp_hdr *)(buf->data + ip_len);
+
+	/* Segments with options, or with other flags than ACK and PSH, are
+	 * left to TCP.
+	 */
+	if ((seg->tcp->offset >> 4) * 4U != sizeof(struct net_tcp_hdr) ||
+	    (seg->tcp->flags & ~PSH) != ACK) {
+		return -EINVAL;
+	}
+
+	seg->data_len = len - seg->hdr_len;
+
+	return 0;
+}
+
+/* Verifies the checksums of the segment, as its TCP checksum is not valid
+ * anymore once other segments are appended to it.
+ */
+static int tcp_gro_check(struct net_pkt *pkt, struct tcp_gro_seg *seg)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	enum net_if_checksum_type type;
+
+	/* IP does the same when it gets the packet */
+	net_pkt_set_family(pkt, seg->family);
+	net_pkt_set_ip_hdr_len(pkt, seg->hdr_len - sizeof(struct net_tcp_hdr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg->family == AF_INET) {
+		net_pkt_set_ipv4_opts_len(pkt, 0);
+		type = NET_IF_CHECKSUM_IPV4_TCP;
+
+		if (net_if_need_calc_rx_checksum(iface, NET_IF_CHECKSUM_IPV4_HEADER) &&
+		    net_calc_chksum_ipv4(pkt) != 0U) {
+			return -EBADMSG;
+		}
+	} else {
+		net_pkt_set_ipv6_ext_len(pkt, 0);
+		type = NET_IF_CHECKSUM_IPV6_TCP;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
+	    net_if_need_calc_rx_checksum(iface, type) &&
+	    net_calc_chksum_tcp(pkt) != 0U) {
+		return -EBADMSG;
+	}
+
+	net_pkt_set_chksum_verified(pkt, true);
+
+	return 0;
+}
+
+static bool tcp_gro_same_flow(struct tcp_gro_seg *held, struct tcp_gro_seg *seg)
+{
+	if (held->family != seg->family) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && held->family == AF_INET) {
+		if (held->ipv4->tos != seg->ipv4->tos ||
+		    held->ipv4->ttl != seg->ipv4->ttl ||
+		    memcmp(held->ipv4->src, seg->ipv4->src, 2 * NET_IPV4_ADDR_SIZE) != 0) {
+			return false;
+		}
+	} else {
+		/* Version, traffic class and flow label */
+		if (memcmp(held->ipv6, seg->ipv6, 4) != 0 ||
+		    held->ipv6->hop_limit != seg->ipv6->hop_limit ||
+		    memcmp(held->ipv6->src, seg->ipv6->src, 2 * NET_IPV6_ADDR_SIZE) != 0) {
+			return false;
+		}
+	}
+
+	return held->tcp->src_port == seg->tcp->src_port &&
+	       held->tcp->dst_port == seg->tcp->dst_port &&
+	       sys_get_be32(held->tcp->ack) == sys_get_be32(seg->tcp->ack);
+}
+
+bool net_tcp_gro_hold(struct net_tcp_gro *gro, struct net_pkt *pkt)
+{
+	struct tcp_gro_seg seg;
+
+	if (tcp_gro_parse(pkt, &seg) < 0 || (seg.tcp->flags & PSH)) {
+		return false;
+	}
+
+	/* Forwarded packets must keep the size they were sent with */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg.family == AF_INET) {
+		struct in_addr *dst = (struct in_addr *)seg.ipv4->dst;
+
+		if (!net_ipv4_is_addr_loopback(dst) && !net_ipv4_is_my_addr(dst)) {
+			return false;
+		}
+	} else {
+		struct in6_addr *dst = (struct in6_addr *)seg.ipv6->dst;
+
+		if (!net_ipv6_is_addr_loopback(dst) && !net_ipv6_is_my_addr(dst)) {
+			return false;
+		}
+	}
+
+	if (tcp_gro_check(pkt, &seg) < 0) {
+		return false;
+	}
+
+	gro->pkt = pkt;
+	gro->segs = 1U;
+	gro->full = false;
+
+	return true;
+}
+
+bool net_tcp_gro_merge(struct net_tcp_gro *gro, struct net_pkt *pkt)
+{
+	struct tcp_gro_seg held;
+	struct tcp_gro_seg seg;
+	size_t len;
+
+	if (gro->full || net_pkt_iface(pkt) != net_pkt_iface(gro->pkt) ||
+	    tcp_gro_parse(gro->pkt, &held) < 0 || tcp_gro_parse(pkt, &seg) < 0 ||
+	    !tcp_gro_same_flow(&held, &seg) ||
+	    sys_get_be32(seg.tcp->seq) != (uint32_t)(sys_get_be32(held.tcp->seq) + held.data_len)) {
+		return false;
+	}
+
+	/* Both the total length of IPv4 and the payload length of IPv6 are
+	 * limited to 16 bits.
+	 */
+	len = net_pkt_get_len(gro->pkt) + seg.data_len;
+	if ((held.family == AF_INET ? len : len - sizeof(struct net_ipv6_hdr)) > UINT16_MAX) {
+		return false;
+	}
+
+	if (tcp_gro_check(pkt, &seg) < 0) {
+		return false;
+	}
+
+	/* The window and the push flag of the last segment are the ones that
+	 * apply.
+	 */
+	memcpy(held.tcp->wnd, seg.tcp->wnd, sizeof(held.tcp->wnd));
+	held.tcp->flags |= seg.tcp->flags & PSH;
+
+	/* Cannot fail as the packet is longer than its headers */
+	net_pkt_cursor_init(pkt);
+	(void)net_pkt_pull(pkt, seg.hdr_len);
+
+	net_pkt_append_buffer(gro->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && held.family == AF_INET) {
+		held.ipv4->len = htons(len);
+		held.ipv4->chksum = 0U;
+		held.ipv4->chksum = net_calc_chksum_ipv4(gro->pkt);
+	} else {
+		held.ipv6->len = htons(len - sizeof(struct net_ipv6_hdr));
+	}
+
+	NET_DBG("pkt %p: %zu bytes appended, %u segments", gro->pkt, seg.data_len,
+		gro->segs + 1U);
+
+	gro->segs++;
+	gro->full = gro->segs >= CONFIG_NET_TCP_GRO_MAX_SEGS ||
+		    (held.tcp->flags & PSH) != 0U;
+
+	return true;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Software segmentation of the TCP packets carrying several segments, for
+ * the interfaces that cannot do it in hardware.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "net_stats.h"
+#include "tcp_internal.h"
+
+static void tcp_gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_family(seg, net_pkt_family(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ip_dscp(seg, net_pkt_ip_dscp(pkt));
+	net_pkt_set_ip_ecn(seg, net_pkt_ip_ecn(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	/* The link layer addresses have already been resolved */
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt), sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt), sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_hdr_prev(seg, net_pkt_ipv6_hdr_prev(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Builds the segment carrying len bytes of data from offset, with a copy of
+ * the headers of the packet.
+ */
+static struct net_pkt *tcp_gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				       size_t offset, size_t len, bool last,
+				       k_timeout_t timeout)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	int ret;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					AF_UNSPEC, 0, timeout);
+	if (!seg) {
+		return NULL;
+	}
+
+	tcp_gso_copy_attributes(seg, pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) + net_pkt_ip_opts_len(seg))) {
+		goto fail;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		goto fail;
+	}
+
+	sys_put_be32(sys_get_be32(tcp_hdr->seq) + offset, tcp_hdr->seq);
+
+	/* Only the last segment ends the data that was pushed */
+	if (!last) {
+		tcp_hdr->flags &= ~(FIN | PSH);
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_IPV4_HDR(seg)->chksum = 0U;
+		ret = net_ipv4_finalize(seg, IPPROTO_TCP);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		ret = net_ipv6_finalize(seg, IPPROTO_TCP);
+	} else {
+		ret = -EINVAL;
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	if (last) {
+		/* The context is notified once the whole packet is sent */
+		net_pkt_set_context(seg, net_pkt_context(pkt));
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+void net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt,
+		      k_timeout_t timeout)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	struct net_pkt *seg;
+	size_t data_len;
+	size_t hdr_len;
+	size_t len;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		goto out;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		goto out;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	NET_DBG("pkt %p: %zu bytes in segments of %u bytes", pkt, data_len, mss);
+
+	for (size_t offset = 0; offset < data_len; offset += len) {
+		len = MIN(mss, data_len - offset);
+
+		seg = tcp_gso_segment(pkt, hdr_len, offset, len,
+				      offset + len == data_len, timeout);
+		if (!seg) {
+			/* TCP will send the rest again when it times out */
+			NET_DBG("pkt %p: cannot build segment at %zu", pkt, offset);
+			net_stats_update_tc_sent_dropped(iface,
+					net_tx_priority2tc(net_pkt_priority(pkt)));
+			break;
+		}
+
+		net_if_try_queue_tx(iface, seg, timeout);
+	}
+
+out:
+	net_pkt_unref(pkt);
+}
+
+int net_tcp_gso_finalize(struct net_pkt *pkt)
+{
+	net_pkt_set_gso_size(pkt, 0U);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		NET_IPV4_HDR(pkt)->chksum = 0U;
+		return net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		return net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
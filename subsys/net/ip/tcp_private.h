@@ -227,18 +227,46 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Maximum size of the TCP options, and number of SACK blocks that fit in it
+ * along with the two NOPs that keep the blocks 32-bit aligned.
+ */
+#define NET_TCP_MAX_OPTS_LEN      40
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+/* Largest payload of a packet split late in segments, leaving room for the
+ * IPv4 and TCP headers with options, which are 60 bytes at most each.
+ */
+#define NET_TCP_GSO_MAX_LEN       (UINT16_MAX - 2 * 60)
+
+/* Number of SACKed ranges remembered by the sender */
+#define TCP_SACK_SCOREBOARD_SIZE  8
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
@@ -248,6 +276,36 @@ struct tcp_collision_avoidance_reno {
 	uint16_t ssthresh;
 	uint16_t pending_fast_retransmit_bytes;
 };
+
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+/* CUBIC state, RFC 9438. Windows are in bytes, times in milliseconds. */
+struct tcp_ca_cubic {
+	uint32_t epoch_start; /* Start of the congestion avoidance epoch */
+	uint32_t k; /* Time needed to grow the window back to origin */
+	uint32_t w_max; /* Window just before the last reduction */
+	uint32_t origin; /* Window at the plateau of the cubic function */
+	uint32_t w_est; /* Window Reno would have at this point */
+};
+#endif
+
+struct tcp;
+
+/* Congestion control algorithm, selectable per connection */
+struct tcp_ca_ops {
+	const char *name;
+	/* Called when the connection is established */
+	void (*init)(struct tcp *conn);
+	/* Called when entering fast retransmit */
+	void (*fast_retransmit)(struct tcp *conn);
+	/* Called when the retransmit timer expires */
+	void (*timeout)(struct tcp *conn);
+	/* Called for every duplicate ACK in fast recovery */
+	void (*dup_ack)(struct tcp *conn);
+	/* Called when new data has been acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#define TCP_CA_NAME_MAX 16
 #endif
 
 struct tcp;
@@ -322,9 +380,23 @@ struct tcp { /* TCP connection */
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	const struct tcp_ca_ops *ca_ops;
 	struct tcp_collision_avoidance_reno ca;
+#ifdef CONFIG_NET_TCP_CA_CUBIC
+	struct tcp_ca_cubic cubic;
+#endif
 #endif
 	uint8_t send_data_retries;
+#ifdef CONFIG_NET_TCP_SACK
+	/* Ranges above seq that the peer has selectively acknowledged,
+	 * sorted and disjoint.
+	 */
+	struct tcp_sack_block sacked[TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t sack_recovery_point; /* Fast recovery ends when it is acked */
+	uint32_t sack_rexmit_next; /* Next seq to resend in fast recovery */
+	uint32_t sack_last_seq; /* Most recently queued out-of-order data */
+	uint8_t sacked_count;
+#endif
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
@@ -337,6 +409,10 @@ struct tcp { /* TCP connection */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
 	bool rst_received : 1;
+#ifdef CONFIG_NET_TCP_SACK
+	bool sack_permitted : 1;
+	bool sack_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -48,6 +48,12 @@ bool compression_value_is_valid(enum http_compression compression);
 struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
 						 const char *path, int *len, bool is_ws);
 int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t len);
+/* Sends the parts as if they were one buffer, updating them as they are sent */
+int http_server_sendall_iov(struct http_client_ctx *client, struct iovec *iov, size_t iovcnt);
+/* Buffer of the thread serving the client, to read files into before they
+ * are sent.
+ */
+uint8_t *http_server_file_buffer(struct http_client_ctx *client, size_t *len);
 void http_server_get_content_type_from_extension(char *url, char *content_type,
 						 size_t content_type_size);
 int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
@@ -56,6 +62,37 @@ void http_client_timer_restart(struct http_client_ctx *client);
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status);
 bool http_response_is_provided(struct http_response_ctx *rsp);
 
+/* Makes the client the holder of the dynamic resource, unless another client
+ * already holds it.
+ */
+bool http_server_hold_resource(struct http_resource_detail_dynamic *detail,
+			       struct http_client_ctx *client);
+/* Lets other clients hold the dynamic resource, if the client holds it.
+ * Returns whether it did.
+ */
+bool http_server_release_resource(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client);
+
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+/* Quoted CRC-32 of the cached response body, in hexadecimal */
+#define HTTP_SERVER_ETAG_LEN sizeof("\"01234567\"")
+
+/* Cache the response to the request is served from or stored in, if any */
+struct http_resource_cache *http_server_cache_get(struct http_resource_detail_dynamic *detail,
+						  struct http_client_ctx *client);
+bool http_server_cache_is_fresh(struct http_resource_cache *cache);
+/* Called before the resource callback generates the response, then with
+ * every part of the response, then once it is complete.
+ */
+void http_server_cache_start(struct http_resource_cache *cache);
+void http_server_cache_store(struct http_resource_cache *cache,
+			     const struct http_response_ctx *rsp);
+void http_server_cache_finish(struct http_resource_cache *cache);
+void http_server_cache_etag(struct http_resource_cache *cache, char *etag, size_t len);
+/* Whether the request of the client has an If-None-Match header matching the ETag */
+bool http_server_cache_not_modified(struct http_client_ctx *client, const char *etag);
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 /* TODO Could be static, but currently used in tests. */
 int parse_http_frame_header(struct http_client_ctx *client, const uint8_t *buffer, size_t buflen);
 const char *get_frame_type_name(enum http2_frame_type type);
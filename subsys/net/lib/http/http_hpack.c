@@ -6,6 +6,7 @@
  */
 #include <errno.h>
 #include <string.h>
+#include <strings.h>
 
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/hpack.h>
@@ -21,70 +22,75 @@ static inline bool http_hpack_key_is_static(uint32_t key)
 struct hpack_table_entry {
 	const char *name;
 	const char *value;
+	uint8_t name_len;
+	uint8_t value_len;
 };
 
+#define HPACK_NAME(_name) { _name, NULL, sizeof(_name) - 1, 0 }
+#define HPACK_FIELD(_name, _value) { _name, _value, sizeof(_name) - 1, sizeof(_value) - 1 }
+
 static const struct hpack_table_entry http_hpack_table_static[] = {
-	[HTTP_SERVER_HPACK_AUTHORITY] = { ":authority", NULL },
-	[HTTP_SERVER_HPACK_METHOD_GET] = { ":method", "GET" },
-	[HTTP_SERVER_HPACK_METHOD_POST] = { ":method", "POST" },
-	[HTTP_SERVER_HPACK_PATH_ROOT] = { ":path", "/" },
-	[HTTP_SERVER_HPACK_PATH_INDEX] = { ":path", "/index.html" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTP] = { ":scheme", "http" },
-	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = { ":scheme", "https" },
-	[HTTP_SERVER_HPACK_STATUS_200] = { ":status", "200" },
-	[HTTP_SERVER_HPACK_STATUS_204] = { ":status", "204" },
-	[HTTP_SERVER_HPACK_STATUS_206] = { ":status", "206" },
-	[HTTP_SERVER_HPACK_STATUS_304] = { ":status", "304" },
-	[HTTP_SERVER_HPACK_STATUS_400] = { ":status", "400" },
-	[HTTP_SERVER_HPACK_STATUS_404] = { ":status", "404" },
-	[HTTP_SERVER_HPACK_STATUS_500] = { ":status", "500" },
-	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = { "accept-charset", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = { "accept-encoding", "gzip, deflate" },
-	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = { "accept-language", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = { "accept-ranges", NULL },
-	[HTTP_SERVER_HPACK_ACCEPT] = { "accept", NULL },
-	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = { "access-control-allow-origin", NULL },
-	[HTTP_SERVER_HPACK_AGE] = { "age", NULL },
-	[HTTP_SERVER_HPACK_ALLOW] = { "allow", NULL },
-	[HTTP_SERVER_HPACK_AUTHORIZATION] = { "authorization", NULL },
-	[HTTP_SERVER_HPACK_CACHE_CONTROL] = { "cache-control", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = { "content-disposition", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = { "content-encoding", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = { "content-language", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = { "content-length", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = { "content-location", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_RANGE] = { "content-range", NULL },
-	[HTTP_SERVER_HPACK_CONTENT_TYPE] = { "content-type", NULL },
-	[HTTP_SERVER_HPACK_COOKIE] = { "cookie", NULL },
-	[HTTP_SERVER_HPACK_DATE] = { "date", NULL },
-	[HTTP_SERVER_HPACK_ETAG] = { "etag", NULL },
-	[HTTP_SERVER_HPACK_EXPECT] = { "expect", NULL },
-	[HTTP_SERVER_HPACK_EXPIRES] = { "expires", NULL },
-	[HTTP_SERVER_HPACK_FROM] = { "from", NULL },
-	[HTTP_SERVER_HPACK_HOST] = { "host", NULL },
-	[HTTP_SERVER_HPACK_IF_MATCH] = { "if-match", NULL },
-	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = { "if-modified-since", NULL },
-	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = { "if-none-match", NULL },
-	[HTTP_SERVER_HPACK_IF_RANGE] = { "if-range", NULL },
-	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = { "if-unmodified-since", NULL },
-	[HTTP_SERVER_HPACK_LAST_MODIFIED] = { "last-modified", NULL },
-	[HTTP_SERVER_HPACK_LINK] = { "link", NULL },
-	[HTTP_SERVER_HPACK_LOCATION] = { "location", NULL },
-	[HTTP_SERVER_HPACK_MAX_FORWARDS] = { "max-forwards", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = { "proxy-authenticate", NULL },
-	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = { "proxy-authorization", NULL },
-	[HTTP_SERVER_HPACK_RANGE] = { "range", NULL },
-	[HTTP_SERVER_HPACK_REFERER] = { "referer", NULL },
-	[HTTP_SERVER_HPACK_REFRESH] = { "refresh", NULL },
-	[HTTP_SERVER_HPACK_RETRY_AFTER] = { "retry-after", NULL },
-	[HTTP_SERVER_HPACK_SERVER] = { "server", NULL },
-	[HTTP_SERVER_HPACK_SET_COOKIE] = { "set-cookie", NULL },
-	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = { "strict-transport-security", NULL },
-	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = { "transfer-encoding", NULL },
-	[HTTP_SERVER_HPACK_USER_AGENT] = { "user-agent", NULL },
-	[HTTP_SERVER_HPACK_VARY] = { "vary", NULL },
-	[HTTP_SERVER_HPACK_VIA] = { "via", NULL },
-	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = { "www-authenticate", NULL },
+	[HTTP_SERVER_HPACK_AUTHORITY] = HPACK_NAME(":authority"),
+	[HTTP_SERVER_HPACK_METHOD_GET] = HPACK_FIELD(":method", "GET"),
+	[HTTP_SERVER_HPACK_METHOD_POST] = HPACK_FIELD(":method", "POST"),
+	[HTTP_SERVER_HPACK_PATH_ROOT] = HPACK_FIELD(":path", "/"),
+	[HTTP_SERVER_HPACK_PATH_INDEX] = HPACK_FIELD(":path", "/index.html"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTP] = HPACK_FIELD(":scheme", "http"),
+	[HTTP_SERVER_HPACK_SCHEME_HTTPS] = HPACK_FIELD(":scheme", "https"),
+	[HTTP_SERVER_HPACK_STATUS_200] = HPACK_FIELD(":status", "200"),
+	[HTTP_SERVER_HPACK_STATUS_204] = HPACK_FIELD(":status", "204"),
+	[HTTP_SERVER_HPACK_STATUS_206] = HPACK_FIELD(":status", "206"),
+	[HTTP_SERVER_HPACK_STATUS_304] = HPACK_FIELD(":status", "304"),
+	[HTTP_SERVER_HPACK_STATUS_400] = HPACK_FIELD(":status", "400"),
+	[HTTP_SERVER_HPACK_STATUS_404] = HPACK_FIELD(":status", "404"),
+	[HTTP_SERVER_HPACK_STATUS_500] = HPACK_FIELD(":status", "500"),
+	[HTTP_SERVER_HPACK_ACCEPT_CHARSET] = HPACK_NAME("accept-charset"),
+	[HTTP_SERVER_HPACK_ACCEPT_ENCODING] = HPACK_FIELD("accept-encoding", "gzip, deflate"),
+	[HTTP_SERVER_HPACK_ACCEPT_LANGUAGE] = HPACK_NAME("accept-language"),
+	[HTTP_SERVER_HPACK_ACCEPT_RANGES] = HPACK_NAME("accept-ranges"),
+	[HTTP_SERVER_HPACK_ACCEPT] = HPACK_NAME("accept"),
+	[HTTP_SERVER_HPACK_ACCESS_CONTROL_ALLOW_ORIGIN] = HPACK_NAME("access-control-allow-origin"),
+	[HTTP_SERVER_HPACK_AGE] = HPACK_NAME("age"),
+	[HTTP_SERVER_HPACK_ALLOW] = HPACK_NAME("allow"),
+	[HTTP_SERVER_HPACK_AUTHORIZATION] = HPACK_NAME("authorization"),
+	[HTTP_SERVER_HPACK_CACHE_CONTROL] = HPACK_NAME("cache-control"),
+	[HTTP_SERVER_HPACK_CONTENT_DISPOSITION] = HPACK_NAME("content-disposition"),
+	[HTTP_SERVER_HPACK_CONTENT_ENCODING] = HPACK_NAME("content-encoding"),
+	[HTTP_SERVER_HPACK_CONTENT_LANGUAGE] = HPACK_NAME("content-language"),
+	[HTTP_SERVER_HPACK_CONTENT_LENGTH] = HPACK_NAME("content-length"),
+	[HTTP_SERVER_HPACK_CONTENT_LOCATION] = HPACK_NAME("content-location"),
+	[HTTP_SERVER_HPACK_CONTENT_RANGE] = HPACK_NAME("content-range"),
+	[HTTP_SERVER_HPACK_CONTENT_TYPE] = HPACK_NAME("content-type"),
+	[HTTP_SERVER_HPACK_COOKIE] = HPACK_NAME("cookie"),
+	[HTTP_SERVER_HPACK_DATE] = HPACK_NAME("date"),
+	[HTTP_SERVER_HPACK_ETAG] = HPACK_NAME("etag"),
+	[HTTP_SERVER_HPACK_EXPECT] = HPACK_NAME("expect"),
+	[HTTP_SERVER_HPACK_EXPIRES] = HPACK_NAME("expires"),
+	[HTTP_SERVER_HPACK_FROM] = HPACK_NAME("from"),
+	[HTTP_SERVER_HPACK_HOST] = HPACK_NAME("host"),
+	[HTTP_SERVER_HPACK_IF_MATCH] = HPACK_NAME("if-match"),
+	[HTTP_SERVER_HPACK_IF_MODIFIED_SINCE] = HPACK_NAME("if-modified-since"),
+	[HTTP_SERVER_HPACK_IF_NONE_MATCH] = HPACK_NAME("if-none-match"),
+	[HTTP_SERVER_HPACK_IF_RANGE] = HPACK_NAME("if-range"),
+	[HTTP_SERVER_HPACK_IF_UNMODIFIED_SINCE] = HPACK_NAME("if-unmodified-since"),
+	[HTTP_SERVER_HPACK_LAST_MODIFIED] = HPACK_NAME("last-modified"),
+	[HTTP_SERVER_HPACK_LINK] = HPACK_NAME("link"),
+	[HTTP_SERVER_HPACK_LOCATION] = HPACK_NAME("location"),
+	[HTTP_SERVER_HPACK_MAX_FORWARDS] = HPACK_NAME("max-forwards"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHENTICATE] = HPACK_NAME("proxy-authenticate"),
+	[HTTP_SERVER_HPACK_PROXY_AUTHORIZATION] = HPACK_NAME("proxy-authorization"),
+	[HTTP_SERVER_HPACK_RANGE] = HPACK_NAME("range"),
+	[HTTP_SERVER_HPACK_REFERER] = HPACK_NAME("referer"),
+	[HTTP_SERVER_HPACK_REFRESH] = HPACK_NAME("refresh"),
+	[HTTP_SERVER_HPACK_RETRY_AFTER] = HPACK_NAME("retry-after"),
+	[HTTP_SERVER_HPACK_SERVER] = HPACK_NAME("server"),
+	[HTTP_SERVER_HPACK_SET_COOKIE] = HPACK_NAME("set-cookie"),
+	[HTTP_SERVER_HPACK_STRICT_TRANSPORT_SECURITY] = HPACK_NAME("strict-transport-security"),
+	[HTTP_SERVER_HPACK_TRANSFER_ENCODING] = HPACK_NAME("transfer-encoding"),
+	[HTTP_SERVER_HPACK_USER_AGENT] = HPACK_NAME("user-agent"),
+	[HTTP_SERVER_HPACK_VARY] = HPACK_NAME("vary"),
+	[HTTP_SERVER_HPACK_VIA] = HPACK_NAME("via"),
+	[HTTP_SERVER_HPACK_WWW_AUTHENTICATE] = HPACK_NAME("www-authenticate"),
 };
 
 const struct hpack_table_entry *http_hpack_table_get(uint32_t key)
@@ -106,11 +112,10 @@ static int http_hpack_find_index(struct http_hpack_header_buf *header,
 	     i <= HTTP_SERVER_HPACK_WWW_AUTHENTICATE; i++) {
 		entry = &http_hpack_table_static[i];
 
-		if (entry->name != NULL &&
-		    strlen(entry->name) == header->name_len &&
+		if (entry->name_len == header->name_len &&
 		    memcmp(entry->name, header->name, header->name_len) == 0) {
 			if (entry->value != NULL &&
-			    strlen(entry->value) == header->value_len &&
+			    entry->value_len == header->value_len &&
 			    memcmp(entry->value, header->value, header->value_len) == 0) {
 				/* Got exact match. */
 				*name_only = false;
@@ -308,9 +313,9 @@ static int hpack_handle_indexed(const uint8_t *buf, size_t datalen,
 	}
 
 	header->name = entry->name;
-	header->name_len = strlen(entry->name);
+	header->name_len = entry->name_len;
 	header->value = entry->value;
-	header->value_len = strlen(entry->value);
+	header->value_len = entry->value_len;
 
 	return ret;
 }
@@ -358,7 +363,7 @@ static int hpack_handle_literal(const uint8_t *buf, size_t datalen,
 		}
 
 		header->name = entry->name;
-		header->name_len = strlen(entry->name);
+		header->name_len = entry->name_len;
 	}
 
 	ret = hpack_string_decode(buf, datalen, HPACK_HEADER_VALUE, header);
@@ -465,7 +470,7 @@ static int hpack_integer_encode(uint8_t *buf, size_t buflen, int value,
 			return -ENOBUFS;
 		}
 
-		*buf = (uint8_t)((value % 128) + 128);
+		*buf++ = (uint8_t)((value % 128) + 128);
 		len++;
 		value /= 128;
 	}
@@ -529,23 +534,13 @@ static int hpack_string_encode(uint8_t *buf, size_t buflen,
 	return len;
 }
 
-static int hpack_encode_literal(uint8_t *buf, size_t buflen,
+static int hpack_encode_literal(uint8_t *buf, size_t buflen, int index,
+				uint8_t prefix, uint8_t prefix_len,
 				struct http_hpack_header_buf *header)
 {
 	int ret, len = 0;
 
-	ret = hpack_integer_encode(buf, buflen, 0,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
-	}
-
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+	ret = hpack_integer_encode(buf, buflen, index, prefix, prefix_len);
 	if (ret < 0) {
 		return ret;
 	}
@@ -554,32 +549,18 @@ static int hpack_encode_literal(uint8_t *buf, size_t buflen,
 	buflen -= ret;
 	len += ret;
 
-	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
-	if (ret < 0) {
-		return ret;
-	}
-
-	len += ret;
-
-	return len;
-}
-
-static int hpack_encode_literal_value(uint8_t *buf, size_t buflen, int index,
-				      struct http_hpack_header_buf *header)
-{
-	int ret, len = 0;
+	if (index == 0) {
+		/* Literal name */
+		ret = hpack_string_encode(buf, buflen, HPACK_HEADER_NAME, header);
+		if (ret < 0) {
+			return ret;
+		}
 
-	ret = hpack_integer_encode(buf, buflen, index,
-				   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
-				   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED);
-	if (ret < 0) {
-		return ret;
+		buf += ret;
+		buflen -= ret;
+		len += ret;
 	}
 
-	buf += ret;
-	buflen -= ret;
-	len += ret;
-
 	ret = hpack_string_encode(buf, buflen, HPACK_HEADER_VALUE, header);
 	if (ret < 0) {
 		return ret;
@@ -615,10 +596,16 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 	ret = http_hpack_find_index(header, &name_only);
 	if (ret < 0) {
 		/* All literal */
-		len = hpack_encode_literal(buf, buflen, header);
+		len = hpack_encode_literal(buf, buflen, 0,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else if (name_only) {
 		/* Literal value */
-		len = hpack_encode_literal_value(buf, buflen, ret, header);
+		len = hpack_encode_literal(buf, buflen, ret,
+					   HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					   HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					   header);
 	} else {
 		/* Indexed */
 		len = hpack_encode_indexed(buf, buflen, ret);
@@ -626,3 +613,286 @@ int http_hpack_encode_header(uint8_t *buf, size_t buflen,
 
 	return len;
 }
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+
+/* Initial size of the dynamic table of the peer decoder, RFC7540 ch 6.5.2 */
+#define HPACK_DEFAULT_DYNAMIC_TABLE_SIZE 4096
+#define HPACK_ENTRY_OVERHEAD             32
+
+#define HPACK_HASH_INIT                  2166136261U
+#define HPACK_HASH_PRIME                 16777619U
+
+/* The header fields which change with every response are not worth the
+ * eviction of others from the table, and cookies are sensitive.
+ */
+static const char *const hpack_unindexed_names[] = {
+	"content-length",
+	"content-range",
+	"date",
+	"set-cookie",
+};
+
+/* FNV-1a */
+static uint32_t hpack_hash(uint32_t hash, const char *str, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ (uint8_t)str[i]) * HPACK_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+static size_t hpack_entry_size(size_t name_len, size_t value_len)
+{
+	return name_len + value_len + HPACK_ENTRY_OVERHEAD;
+}
+
+static bool hpack_is_indexable(struct http_hpack_encoder *encoder,
+			       struct http_hpack_header_buf *header)
+{
+	if (hpack_entry_size(header->name_len, header->value_len) > encoder->max_size) {
+		return false;
+	}
+
+	ARRAY_FOR_EACH(hpack_unindexed_names, i) {
+		if (strlen(hpack_unindexed_names[i]) == header->name_len &&
+		    strncasecmp(hpack_unindexed_names[i], header->name,
+				header->name_len) == 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Evicts the oldest entries until the table fits in max_size. */
+static void hpack_dynamic_table_evict(struct http_hpack_encoder *encoder,
+				      size_t max_size)
+{
+	struct http_hpack_dynamic_entry *entry;
+	size_t size = encoder->size;
+	size_t data_len = 0;
+	size_t count = 0;
+
+	while (size > max_size) {
+		entry = &encoder->entries[count];
+		data_len += entry->name_len + entry->value_len;
+		size -= hpack_entry_size(entry->name_len, entry->value_len);
+		count++;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	memmove(encoder->entries, &encoder->entries[count],
+		(encoder->count - count) * sizeof(encoder->entries[0]));
+	memmove(encoder->data, encoder->data + data_len,
+		encoder->data_len - data_len);
+
+	encoder->count -= count;
+	encoder->data_len -= data_len;
+	encoder->size = size;
+}
+
+static void hpack_dynamic_table_add(struct http_hpack_encoder *encoder,
+				    struct http_hpack_header_buf *header,
+				    uint32_t name_hash, uint32_t hash)
+{
+	size_t entry_size = hpack_entry_size(header->name_len, header->value_len);
+	struct http_hpack_dynamic_entry *entry;
+
+	hpack_dynamic_table_evict(encoder, encoder->max_size - entry_size);
+
+	NET_ASSERT(encoder->count < ARRAY_SIZE(encoder->entries));
+	NET_ASSERT(encoder->data_len + header->name_len + header->value_len <=
+		   sizeof(encoder->data));
+
+	entry = &encoder->entries[encoder->count];
+	entry->name_hash = name_hash;
+	entry->hash = hash;
+	entry->name_len = header->name_len;
+	entry->value_len = header->value_len;
+
+	memcpy(encoder->data + encoder->data_len, header->name, header->name_len);
+	encoder->data_len += header->name_len;
+	memcpy(encoder->data + encoder->data_len, header->value, header->value_len);
+	encoder->data_len += header->value_len;
+
+	encoder->count++;
+	encoder->size += entry_size;
+}
+
+/* Returns the index of the newest entry matching the header field, or else
+ * of the newest one matching its name only, or 0.
+ */
+static int hpack_dynamic_table_find(struct http_hpack_encoder *encoder,
+				    struct http_hpack_header_buf *header,
+				    uint32_t name_hash, uint32_t hash,
+				    bool *name_only)
+{
+	const struct http_hpack_dynamic_entry *entry;
+	size_t offset = encoder->data_len;
+	int candidate = 0;
+	int index;
+
+	for (int i = encoder->count - 1; i >= 0; i--) {
+		entry = &encoder->entries[i];
+		offset -= entry->name_len + entry->value_len;
+
+		if (entry->name_hash != name_hash ||
+		    entry->name_len != header->name_len ||
+		    memcmp(encoder->data + offset, header->name, header->name_len) != 0) {
+			continue;
+		}
+
+		/* The newest entry comes right after the static table. */
+		index = HTTP_SERVER_HPACK_WWW_AUTHENTICATE + encoder->count - i;
+
+		if (entry->hash == hash &&
+		    entry->value_len == header->value_len &&
+		    memcmp(encoder->data + offset + entry->name_len, header->value,
+			   header->value_len) == 0) {
+			*name_only = false;
+			return index;
+		}
+
+		if (candidate == 0) {
+			candidate = index;
+		}
+	}
+
+	*name_only = true;
+
+	return candidate;
+}
+
+void http_hpack_encoder_init(struct http_hpack_encoder *encoder)
+{
+	encoder->count = 0;
+	encoder->data_len = 0;
+	encoder->size = 0;
+	encoder->max_size = MIN(HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE,
+				HPACK_DEFAULT_DYNAMIC_TABLE_SIZE);
+	encoder->min_size = encoder->max_size;
+
+	/* Let the peer know that it needs less memory than by default. */
+	encoder->size_update = encoder->max_size < HPACK_DEFAULT_DYNAMIC_TABLE_SIZE;
+}
+
+void http_hpack_encoder_set_max_size(struct http_hpack_encoder *encoder,
+				     uint32_t max_size)
+{
+	encoder->max_size = MIN(max_size, HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	encoder->min_size = MIN(encoder->min_size, encoder->max_size);
+
+	/* The peer may expect an update even if the size did not change. */
+	encoder->size_update = true;
+
+	hpack_dynamic_table_evict(encoder, encoder->max_size);
+}
+
+int http_hpack_encode_size_update(struct http_hpack_encoder *encoder,
+				  uint8_t *buf, size_t buflen)
+{
+	int ret, len = 0;
+
+	if (!encoder->size_update) {
+		return 0;
+	}
+
+	/* Based on RFC7541, ch 4.2, the smallest size since the last update
+	 * must be signaled first.
+	 */
+	if (encoder->min_size < encoder->max_size) {
+		ret = hpack_integer_encode(buf, buflen, encoder->min_size,
+					   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+					   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+		if (ret < 0) {
+			return ret;
+		}
+
+		buf += ret;
+		buflen -= ret;
+		len += ret;
+	}
+
+	ret = hpack_integer_encode(buf, buflen, encoder->max_size,
+				   HPACK_PREFIX_DYNAMIC_TABLE_SIZE_UPDATE,
+				   HPACK_PREFIX_LEN_DYNAMIC_TABLE_SIZE_UPDATE);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len += ret;
+
+	encoder->min_size = encoder->max_size;
+	encoder->size_update = false;
+
+	return len;
+}
+
+int http_hpack_encode_header_dynamic(struct http_hpack_encoder *encoder,
+				     uint8_t *buf, size_t buflen,
+				     struct http_hpack_header_buf *header)
+{
+	bool name_only, dynamic_name_only;
+	uint32_t name_hash, hash;
+	int index, dynamic_index;
+	int ret;
+
+	if (encoder == NULL || buf == NULL || header == NULL ||
+	    header->name == NULL || header->name_len == 0 ||
+	    header->value == NULL || header->value_len == 0) {
+		return -EINVAL;
+	}
+
+	if (buflen == 0) {
+		return -ENOBUFS;
+	}
+
+	/* The fields of the static table are not added to the dynamic one, so
+	 * the repeated fields are found with their hash first.
+	 */
+	name_hash = hpack_hash(HPACK_HASH_INIT, header->name, header->name_len);
+	hash = hpack_hash(name_hash, header->value, header->value_len);
+
+	dynamic_index = hpack_dynamic_table_find(encoder, header, name_hash, hash,
+						 &dynamic_name_only);
+	if (dynamic_index > 0 && !dynamic_name_only) {
+		return hpack_encode_indexed(buf, buflen, dynamic_index);
+	}
+
+	index = http_hpack_find_index(header, &name_only);
+	if (index > 0 && !name_only) {
+		return hpack_encode_indexed(buf, buflen, index);
+	}
+
+	/* A name of the static table has the smaller index. */
+	if (index < 0) {
+		index = dynamic_index;
+	}
+
+	if (!hpack_is_indexable(encoder, header)) {
+		return hpack_encode_literal(buf, buflen, index,
+					    HPACK_PREFIX_LITERAL_NEVER_INDEXED,
+					    HPACK_PREFIX_LEN_LITERAL_NEVER_INDEXED,
+					    header);
+	}
+
+	ret = hpack_encode_literal(buf, buflen, index,
+				   HPACK_PREFIX_LITERAL_INDEXING,
+				   HPACK_PREFIX_LEN_LITERAL_INDEXING,
+				   header);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The name index above refers to the table before the insertion. */
+	hpack_dynamic_table_add(encoder, header, name_hash, hash);
+
+	return ret;
+}
+
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
@@ -281,47 +281,110 @@ static const struct decode_elem eos = {
 	30,   0, { 0b11111111, 0b11111111, 0b11111111, 0b11111100 }
 };
 
-#define UINT32_BITLEN 32
+/* The Huffman code of HPACK is canonical: the codes of each length are
+ * consecutive values, following the last code of the previous length, and
+ * decode_table lists them in this order. So the symbol of the code at the
+ * start of a bit string is found from the first code and the limit of the
+ * codes of its length, instead of being compared with every code.
+ */
 
-#define MSB_MASK(len) (UINT32_MAX << (UINT32_BITLEN - len))
-#define LSB_MASK(len) ((1UL << len) - 1UL)
+/* Index in decode_table of the code of up to 8 bits starting the bit
+ * strings beginning with each byte value (0xfe and 0xff start longer codes).
+ */
+static const uint8_t short_codes[] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+	  2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,   3,   3,
+	  4,   4,   4,   4,   4,   4,   4,   4,   5,   5,   5,   5,   5,   5,   5,   5,
+	  6,   6,   6,   6,   6,   6,   6,   6,   7,   7,   7,   7,   7,   7,   7,   7,
+	  8,   8,   8,   8,   8,   8,   8,   8,   9,   9,   9,   9,   9,   9,   9,   9,
+	 10,  10,  10,  10,  11,  11,  11,  11,  12,  12,  12,  12,  13,  13,  13,  13,
+	 14,  14,  14,  14,  15,  15,  15,  15,  16,  16,  16,  16,  17,  17,  17,  17,
+	 18,  18,  18,  18,  19,  19,  19,  19,  20,  20,  20,  20,  21,  21,  21,  21,
+	 22,  22,  22,  22,  23,  23,  23,  23,  24,  24,  24,  24,  25,  25,  25,  25,
+	 26,  26,  26,  26,  27,  27,  27,  27,  28,  28,  28,  28,  29,  29,  29,  29,
+	 30,  30,  30,  30,  31,  31,  31,  31,  32,  32,  32,  32,  33,  33,  33,  33,
+	 34,  34,  34,  34,  35,  35,  35,  35,  36,  36,  37,  37,  38,  38,  39,  39,
+	 40,  40,  41,  41,  42,  42,  43,  43,  44,  44,  45,  45,  46,  46,  47,  47,
+	 48,  48,  49,  49,  50,  50,  51,  51,  52,  52,  53,  53,  54,  54,  55,  55,
+	 56,  56,  57,  57,  58,  58,  59,  59,  60,  60,  61,  61,  62,  62,  63,  63,
+	 64,  64,  65,  65,  66,  66,  67,  67,  68,  69,  70,  71,  72,  73,
+};
 
-static bool huffman_bits_compare(uint32_t bits, const struct decode_elem *entry)
-{
-	uint32_t mask = MSB_MASK(entry->bitlen);
-	uint32_t code = sys_get_be32(entry->code);
+struct long_codes_elem {
+	/* First code of the length and first code after them, left aligned */
+	uint32_t first;
+	uint32_t limit;
+	uint8_t bitlen;
+	/* Index in decode_table of the first code of the length */
+	uint8_t index;
+};
 
-	if (code == (bits & mask)) {
-		return true;
-	}
+static const struct long_codes_elem long_codes[] = {
+	{ 0xfe000000, 0xff400000, 10,  74 },
+	{ 0xff400000, 0xffa00000, 11,  79 },
+	{ 0xffa00000, 0xffc00000, 12,  82 },
+	{ 0xffc00000, 0xfff00000, 13,  84 },
+	{ 0xfff00000, 0xfff80000, 14,  90 },
+	{ 0xfff80000, 0xfffe0000, 15,  92 },
+	{ 0xfffe0000, 0xfffe6000, 19,  95 },
+	{ 0xfffe6000, 0xfffee000, 20,  98 },
+	{ 0xfffee000, 0xffff4800, 21, 106 },
+	{ 0xffff4800, 0xffffb000, 22, 119 },
+	{ 0xffffb000, 0xffffea00, 23, 145 },
+	{ 0xffffea00, 0xfffff600, 24, 174 },
+	{ 0xfffff600, 0xfffff800, 25, 186 },
+	{ 0xfffff800, 0xfffffbc0, 26, 190 },
+	{ 0xfffffbc0, 0xfffffe20, 27, 205 },
+	{ 0xfffffe20, 0xfffffff0, 28, 224 },
+	{ 0xfffffff0, 0xfffffffc, 30, 253 },
+};
 
-	return false;
-}
+/* Index in decode_table of the code of each symbol */
+static const uint8_t encode_table[] = {
+	 84, 145, 224, 225, 226, 227, 228, 229, 230, 174, 253, 231, 232, 254, 233, 234,
+	235, 236, 237, 238, 239, 240, 255, 241, 242, 243, 244, 245, 246, 247, 248, 249,
+	 10,  74,  75,  82,  85,  11,  68,  79,  76,  77,  69,  80,  70,  12,  13,  14,
+	  0,   1,   2,  15,  16,  17,  18,  19,  20,  21,  36,  71,  92,  22,  83,  78,
+	 86,  23,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,
+	 51,  52,  53,  54,  55,  56,  57,  58,  72,  59,  73,  87,  95,  88,  90,  24,
+	 93,   3,  25,   4,  26,   5,  27,  28,  29,   6,  60,  61,  30,  31,  32,   7,
+	 33,  62,  34,   8,   9,  35,  63,  64,  65,  66,  67,  94,  81,  91,  89, 250,
+	 98, 119,  99, 100, 120, 121, 122, 146, 123, 147, 148, 149, 150, 151, 175, 152,
+	176, 177, 124, 153, 178, 154, 155, 156, 157, 106, 125, 158, 126, 159, 160, 179,
+	127, 107, 101, 128, 129, 161, 162, 108, 163, 130, 131, 180, 109, 132, 164, 165,
+	110, 111, 133, 112, 166, 134, 167, 168, 102, 135, 136, 137, 169, 138, 139, 170,
+	190, 191, 103,  96, 140, 171, 141, 186, 192, 193, 194, 205, 206, 195, 181, 187,
+	 97, 113, 196, 207, 208, 197, 209, 182, 114, 115, 198, 199, 251, 210, 211, 212,
+	104, 183, 105, 116, 142, 117, 118, 172, 143, 144, 188, 189, 184, 185, 200, 173,
+	201, 213, 202, 203, 214, 215, 216, 217, 218, 252, 219, 220, 221, 222, 223, 204,
+};
+
+BUILD_ASSERT(ARRAY_SIZE(decode_table) == 256);
+BUILD_ASSERT(ARRAY_SIZE(encode_table) == 256);
+
+#define UINT32_BITLEN 32
+
+#define LSB_MASK(len) ((1UL << (len)) - 1UL)
 
 static const struct decode_elem *huffman_decode_bits(uint32_t bits)
 {
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (huffman_bits_compare(bits, &decode_table[i])) {
-			return &decode_table[i];
-		}
-	}
+	const struct long_codes_elem *entry;
 
-	if (huffman_bits_compare(bits, &eos)) {
-		return &eos;
+	if ((bits >> 24) < ARRAY_SIZE(short_codes)) {
+		return &decode_table[short_codes[bits >> 24]];
 	}
 
-	return NULL;
-}
+	for (int i = 0; i < ARRAY_SIZE(long_codes); i++) {
+		entry = &long_codes[i];
 
-static const struct decode_elem *huffman_find_entry(uint8_t symbol)
-{
-	for (int i = 0; i < ARRAY_SIZE(decode_table); i++) {
-		if (decode_table[i].symbol == symbol) {
-			return &decode_table[i];
+		if (bits < entry->limit) {
+			return &decode_table[entry->index + ((bits - entry->first) >>
+							     (UINT32_BITLEN - entry->bitlen))];
 		}
 	}
 
-	return NULL;
+	/* Only EOS starts with 30 ones. */
+	return &eos;
 }
 
 #define MAX_PADDING_LEN 7
@@ -330,57 +393,33 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 			      uint8_t *buf, size_t buflen)
 {
 	size_t encoded_bits_len = encoded_len * 8;
-	uint8_t bits_needed = UINT32_BITLEN;
 	const struct decode_elem *decoded;
-	uint8_t bits_in_byte_left = 8;
+	uint8_t bits_avail = 0;
 	size_t decoded_len = 0;
-	uint32_t bits = 0;
+	uint64_t bits = 0;
+	uint32_t code;
 
 	if (encoded_buf == NULL || buf == NULL || encoded_len == 0) {
 		return -EINVAL;
 	}
 
 	while (encoded_bits_len > 0) {
-		/* Refill the bits variable */
-		while (bits_needed > 0) {
-			if (encoded_len > 0) {
-				if (bits_in_byte_left <= bits_needed) {
-					/* Consume rest of the byte */
-					bits <<= bits_in_byte_left;
-					bits |= *encoded_buf &
-						    LSB_MASK(bits_in_byte_left);
-					bits_needed -= bits_in_byte_left;
-					bits_in_byte_left = 0;
-				} else {
-					/* Consume part of the byte */
-					bits <<= bits_needed;
-					bits |= (*encoded_buf >>
-						 (bits_in_byte_left - bits_needed)) &
-						LSB_MASK(bits_needed);
-					bits_in_byte_left -= bits_needed;
-					bits_needed = 0;
-				}
-			} else {
-				/* Pad with ones */
-				bits <<= bits_needed;
-				bits |= LSB_MASK(bits_needed);
-				bits_needed = 0;
-			}
+		/* Refill the bits variable, the next bit being the MSB */
+		while (bits_avail <= 56 && encoded_len > 0) {
+			bits |= (uint64_t)*encoded_buf << (56 - bits_avail);
+			bits_avail += 8;
+			encoded_buf++;
+			encoded_len--;
+		}
 
-			/* Move to next encoded byte */
-			if (bits_in_byte_left == 0) {
-				encoded_buf++;
-				encoded_len--;
-				bits_in_byte_left = 8;
-			}
+		/* Pad with ones */
+		code = (uint32_t)(bits >> UINT32_BITLEN);
+		if (bits_avail < UINT32_BITLEN) {
+			code |= LSB_MASK(UINT32_BITLEN - bits_avail);
 		}
 
 		/* Pass to decoder */
-		decoded = huffman_decode_bits(bits);
-		if (decoded == NULL) {
-			LOG_ERR("No symbol found");
-			return -EBADMSG;
-		}
+		decoded = huffman_decode_bits(code);
 
 		if (decoded == &eos) {
 			if (encoded_bits_len > MAX_PADDING_LEN) {
@@ -397,7 +436,8 @@ int http_hpack_huffman_decode(const uint8_t *encoded_buf, size_t encoded_len,
 		}
 
 		/* Remove consumed bits from bits variable. */
-		bits_needed += decoded->bitlen;
+		bits <<= decoded->bitlen;
+		bits_avail -= decoded->bitlen;
 		encoded_bits_len -= decoded->bitlen;
 
 		/* Store decoded symbol */
@@ -420,7 +460,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 {
 	const struct decode_elem *entry;
 	size_t buflen_bits = buflen * 8;
-	uint8_t bit_offset = 0;
+	uint8_t bits_len = 0;
+	uint64_t bits = 0;
 	int len = 0;
 
 	if (str == NULL || buf == NULL || str_len == 0) {
@@ -428,41 +469,22 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	while (str_len > 0) {
-		uint32_t code;
-		uint8_t bitlen;
-
-		entry = huffman_find_entry(*str);
-		if (entry == NULL) {
-			return -EINVAL;
-		}
+		entry = &decode_table[encode_table[*str]];
 
 		if (entry->bitlen > buflen_bits) {
 			return -ENOBUFS;
 		}
 
-		bitlen = entry->bitlen;
-		code = sys_get_be32(entry->code);
+		/* Append the code to the bits not written yet. */
+		bits = (bits << entry->bitlen) |
+		       (sys_get_be32(entry->code) >> (UINT32_BITLEN - entry->bitlen));
+		bits_len += entry->bitlen;
 
-		while (bitlen > 0) {
-			uint8_t to_copy = MIN(8 - bit_offset, bitlen);
-			uint8_t byte = (uint8_t)((code & MSB_MASK(to_copy)) >>
-						 (24 + bit_offset));
-
-			/* This is way suboptimal */
-			if (bit_offset == 0) {
-				*buf = byte;
-			} else {
-				*buf |= byte;
-			}
-
-			code <<= to_copy;
-			bitlen -= to_copy;
-			bit_offset  = (bit_offset + to_copy) % 8;
-
-			if (bit_offset == 0) {
-				buf++;
-				len++;
-			}
+		while (bits_len >= 8) {
+			bits_len -= 8;
+			*buf = (uint8_t)(bits >> bits_len);
+			buf++;
+			len++;
 		}
 
 		buflen_bits -= entry->bitlen;
@@ -471,8 +493,8 @@ int http_hpack_huffman_encode(const uint8_t *str, size_t str_len,
 	}
 
 	/* Pad with ones. */
-	if (bit_offset > 0) {
-		*buf |= LSB_MASK((8 - bit_offset));
+	if (bits_len > 0) {
+		*buf = (uint8_t)(bits << (8 - bits_len)) | LSB_MASK(8 - bits_len);
 		len++;
 	}
 
@@ -14,6 +14,7 @@
 
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_interface.h>
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net/http/service.h>
@@ -22,6 +23,7 @@
 #include <zephyr/net/tls_credentials.h>
 #include <zephyr/posix/sys/eventfd.h>
 #include <zephyr/posix/fnmatch.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util_macro.h>
 
 LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
@@ -42,6 +44,26 @@ LOG_MODULE_REGISTER(net_http_server, CONFIG_NET_HTTP_SERVER_LOG_LEVEL);
 #define HTTP_SERVER_MAX_SERVICES CONFIG_HTTP_SERVER_NUM_SERVICES
 #define HTTP_SERVER_MAX_CLIENTS  CONFIG_HTTP_SERVER_MAX_CLIENTS
 #define HTTP_SERVER_SOCK_COUNT (1 + HTTP_SERVER_MAX_SERVICES + HTTP_SERVER_MAX_CLIENTS)
+#define HTTP_SERVER_NUM_WORKERS  CONFIG_HTTP_SERVER_NUM_WORKERS
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+/* Worker w serves the clients w, w + HTTP_SERVER_NUM_WORKERS, ... */
+#define HTTP_SERVER_WORKER_CLIENTS \
+	DIV_ROUND_UP(HTTP_SERVER_MAX_CLIENTS, HTTP_SERVER_NUM_WORKERS)
+
+struct http_server_worker {
+	/* First pollfd is eventfd used to signal new clients or to stop the
+	 * worker, then we have the sockets of the clients of the worker.
+	 */
+	struct zsock_pollfd fds[1 + HTTP_SERVER_WORKER_CLIENTS];
+	struct k_thread thread;
+	struct k_sem start;
+	struct k_sem stopped;
+	int num_clients;
+	bool stop;
+	bool failed;
+};
+#endif
 
 struct http_server_ctx {
 	int listen_fds; /* max value of 1 + MAX_SERVICES */
@@ -52,12 +74,46 @@ struct http_server_ctx {
 	 */
 	struct zsock_pollfd fds[HTTP_SERVER_SOCK_COUNT];
 	struct http_client_ctx clients[HTTP_SERVER_MAX_CLIENTS];
+#if HTTP_SERVER_NUM_WORKERS > 0
+	/* The accepted sockets are served by the workers, the server thread
+	 * only polls the eventfd and the listen sockets.
+	 */
+	struct http_server_worker workers[HTTP_SERVER_NUM_WORKERS];
+#endif
 };
 
 static struct http_server_ctx server_ctx;
 static K_SEM_DEFINE(server_start, 0, 1);
 static bool server_running;
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+K_THREAD_STACK_ARRAY_DEFINE(http_server_worker_stacks, HTTP_SERVER_NUM_WORKERS,
+			    CONFIG_HTTP_SERVER_WORKER_STACK_SIZE);
+
+/* Protects the client slots, the client counts and the dynamic resource
+ * holders, which are shared between the server thread and the workers.
+ */
+static K_MUTEX_DEFINE(server_lock);
+
+static inline void http_server_lock(void)
+{
+	(void)k_mutex_lock(&server_lock, K_FOREVER);
+}
+
+static inline void http_server_unlock(void)
+{
+	(void)k_mutex_unlock(&server_lock);
+}
+#else
+static inline void http_server_lock(void)
+{
+}
+
+static inline void http_server_unlock(void)
+{
+}
+#endif
+
 #if defined(CONFIG_HTTP_SERVER_TLS_USE_ALPN)
 static const char *const alpn_list[] = {"h2", "http/1.1"};
 #endif
@@ -97,6 +153,10 @@ int http_server_init(struct http_server_ctx *ctx)
 		ctx->fds[i].fd = INVALID_SOCK;
 	}
 
+	for (i = 0; i < ARRAY_SIZE(ctx->clients); i++) {
+		ctx->clients[i].fd = INVALID_SOCK;
+	}
+
 	/* Create an eventfd that can be used to trigger events during polling */
 	fd = eventfd(0, 0);
 	if (fd < 0) {
@@ -323,15 +383,13 @@ static void client_release_resources(struct http_client_ctx *client)
 
 			dynamic_detail = (struct http_resource_detail_dynamic *)detail;
 
-			if (dynamic_detail->holder != client) {
-				continue;
-			}
-
 			/* If the client still holds the resource at this point,
 			 * it means the transaction was not complete. Release
 			 * the resource and notify application.
 			 */
-			dynamic_detail->holder = NULL;
+			if (!http_server_release_resource(dynamic_detail, client)) {
+				continue;
+			}
 
 			if (dynamic_detail->cb == NULL) {
 				continue;
@@ -345,9 +403,24 @@ static void client_release_resources(struct http_client_ctx *client)
 	}
 }
 
+#if HTTP_SERVER_NUM_WORKERS > 0
+/* Called by the worker serving the client */
+static void worker_release_client(struct http_client_ctx *client)
+{
+	int idx = ARRAY_INDEX(server_ctx.clients, client);
+	struct http_server_worker *worker =
+		&server_ctx.workers[idx % HTTP_SERVER_NUM_WORKERS];
+
+	worker->fds[1 + idx / HTTP_SERVER_NUM_WORKERS].fd = INVALID_SOCK;
+	worker->num_clients--;
+
+	/* Let the server thread accept new clients again */
+	eventfd_write(server_ctx.fds[0].fd, 1);
+}
+#endif
+
 void http_server_release_client(struct http_client_ctx *client)
 {
-	int i;
 	struct k_work_sync sync;
 
 	__ASSERT_NO_MSG(IS_ARRAY_ELEMENT(server_ctx.clients, client));
@@ -355,23 +428,31 @@ void http_server_release_client(struct http_client_ctx *client)
 	k_work_cancel_delayable_sync(&client->inactivity_timer, &sync);
 	client_release_resources(client);
 
+	http_server_lock();
+
 	client->service->data->num_clients--;
 
-	for (i = 0; i < server_ctx.listen_fds; i++) {
+#if HTTP_SERVER_NUM_WORKERS > 0
+	worker_release_client(client);
+#else
+	for (int i = 0; i < server_ctx.listen_fds; i++) {
 		if (server_ctx.fds[i].fd == *client->service->fd) {
 			server_ctx.fds[i].events = ZSOCK_POLLIN;
 			break;
 		}
 	}
-	for (i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
+	for (int i = server_ctx.listen_fds; i < ARRAY_SIZE(server_ctx.fds); i++) {
 		if (server_ctx.fds[i].fd == client->fd) {
 			server_ctx.fds[i].fd = INVALID_SOCK;
 			break;
 		}
 	}
+#endif
 
 	memset(client, 0, sizeof(struct http_client_ctx));
 	client->fd = INVALID_SOCK;
+
+	http_server_unlock();
 }
 
 static void close_client_connection(struct http_client_ctx *client)
@@ -437,6 +518,10 @@ static void init_client_ctx(struct http_client_ctx *client, const struct http_se
 	}
 
 	client->current_stream = NULL;
+
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	http_hpack_encoder_init(&client->hpack_encoder);
+#endif
 }
 
 static int handle_http_preface(struct http_client_ctx *client)
@@ -544,295 +629,944 @@ static int handle_http_request(struct http_client_ctx *client)
 	return 0;
 }
 
-static int http_server_run(struct http_server_ctx *ctx)
+static void handle_client_events(struct http_client_ctx *client, int revents)
 {
-	struct http_client_ctx *client;
-	const struct http_service_desc *service;
-	eventfd_t value;
-	bool found_slot;
-	int new_socket;
-	int ret, i, j;
-	int sock_error;
+	int idx = ARRAY_INDEX(server_ctx.clients, client);
 	socklen_t optlen = sizeof(int);
+	int sock_error;
+	int ret;
 
-	value = 0;
+	if (revents & ZSOCK_POLLHUP) {
+		LOG_DBG("Client #%d has disconnected", idx);
 
-	while (1) {
-		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
-		if (ret < 0) {
+		close_client_connection(client);
+		return;
+	}
+
+	if (revents & ZSOCK_POLLERR) {
+		(void)zsock_getsockopt(client->fd, SOL_SOCKET, SO_ERROR, &sock_error, &optlen);
+		LOG_DBG("Error on fd %d %d", client->fd, sock_error);
+
+		close_client_connection(client);
+		return;
+	}
+
+	if (!(revents & ZSOCK_POLLIN)) {
+		return;
+	}
+
+	ret = zsock_recv(client->fd, client->buffer + client->data_len,
+			 sizeof(client->buffer) - client->data_len, 0);
+	if (ret <= 0) {
+		if (ret == 0) {
+			LOG_DBG("Connection closed by peer for client #%d", idx);
+		} else {
 			ret = -errno;
-			LOG_DBG("poll failed (%d)", ret);
-			goto closing;
+			LOG_DBG("ERROR reading from socket (%d)", ret);
 		}
 
-		if (ret == 0) {
-			/* should not happen because timeout is -1 */
-			break;
+		close_client_connection(client);
+		return;
+	}
+
+	client->data_len += ret;
+
+	http_client_timer_restart(client);
+
+	ret = handle_http_request(client);
+	if (ret < 0 && ret != -EAGAIN) {
+		if (ret == -ENOTCONN) {
+			LOG_DBG("Client closed connection while handling request");
+		} else {
+			LOG_ERR("HTTP request handling error (%d)", ret);
 		}
+		close_client_connection(client);
+	} else if (client->data_len == sizeof(client->buffer)) {
+		/* If the RX buffer is still full after parsing,
+		 * it means we won't be able to handle this request
+		 * with the current buffer size.
+		 */
+		LOG_ERR("RX buffer too small to handle request");
+		close_client_connection(client);
+	}
+}
 
-		if (ret == 1 && ctx->fds[0].revents) {
-			eventfd_read(ctx->fds[0].fd, &value);
-			LOG_DBG("Received stop event. exiting ..");
-			ret = 0;
-			goto closing;
+#if HTTP_SERVER_NUM_WORKERS > 0
+static bool add_client(struct http_server_ctx *ctx, const struct http_service_desc *service,
+		       int new_socket)
+{
+	struct http_server_worker *worker = NULL;
+	int slot = 0;
+
+	http_server_lock();
+
+	/* Give the client to the least loaded worker with a free slot, which
+	 * serves it until the connection is closed.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(ctx->clients); i++) {
+		struct http_server_worker *w = &ctx->workers[i % HTTP_SERVER_NUM_WORKERS];
+
+		if (ctx->clients[i].fd != INVALID_SOCK) {
+			continue;
 		}
 
-		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
-			if (ctx->fds[i].fd < 0) {
-				continue;
-			}
+		if (worker == NULL || w->num_clients < worker->num_clients) {
+			worker = w;
+			slot = i;
+		}
+	}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
-				if (i >= ctx->listen_fds) {
-					LOG_DBG("Client #%d has disconnected",
-						i - ctx->listen_fds);
+	if (worker != NULL) {
+		service->data->num_clients++;
+		worker->num_clients++;
 
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-				}
+		LOG_DBG("Init client #%d on worker %d", slot, slot % HTTP_SERVER_NUM_WORKERS);
 
-				continue;
-			}
+		init_client_ctx(&ctx->clients[slot], service, new_socket);
+	}
 
-			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
-				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
-						       SO_ERROR, &sock_error, &optlen);
-				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+	http_server_unlock();
 
-				if (i >= ctx->listen_fds) {
-					client = &ctx->clients[i - ctx->listen_fds];
-					close_client_connection(client);
-					continue;
-				}
+	if (worker == NULL) {
+		return false;
+	}
 
-				/* Listening socket error, abort. */
-				LOG_ERR("Listening socket error, aborting.");
-				ret = -sock_error;
-				goto closing;
+	eventfd_write(worker->fds[0].fd, 1);
 
-			}
+	return true;
+}
 
-			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
-				continue;
-			}
+/* Called when the workers have released clients */
+static void resume_accepting(struct http_server_ctx *ctx)
+{
+	const struct http_service_desc *service;
 
-			/* First check if we have something to accept */
-			if (i < ctx->listen_fds) {
-				service = lookup_service(ctx->fds[i].fd);
-				__ASSERT(NULL != service, "fd not associated with a service");
+	http_server_lock();
+
+	for (int i = 1; i < ctx->listen_fds; i++) {
+		service = lookup_service(ctx->fds[i].fd);
+		if (service != NULL && service->data->num_clients < service->concurrent) {
+			ctx->fds[i].events = ZSOCK_POLLIN;
+		}
+	}
 
-				if (service->data->num_clients >= service->concurrent) {
-					ctx->fds[i].events = 0;
-					continue;
-				}
+	http_server_unlock();
+}
 
-				new_socket = accept_new_client(ctx->fds[i].fd);
-				if (new_socket < 0) {
-					ret = -errno;
-					LOG_DBG("accept: %d", ret);
-					continue;
-				}
+static void worker_update_clients(struct http_server_worker *worker, int id)
+{
+	http_server_lock();
 
-				found_slot = false;
+	for (int i = 0; i < HTTP_SERVER_WORKER_CLIENTS; i++) {
+		int slot = id + i * HTTP_SERVER_NUM_WORKERS;
 
-				for (j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
-					if (ctx->fds[j].fd != INVALID_SOCK) {
-						continue;
-					}
+		worker->fds[1 + i].fd = slot < HTTP_SERVER_MAX_CLIENTS ?
+					server_ctx.clients[slot].fd : INVALID_SOCK;
+		worker->fds[1 + i].events = ZSOCK_POLLIN;
+	}
 
-					ctx->fds[j].fd = new_socket;
-					ctx->fds[j].events = ZSOCK_POLLIN;
-					ctx->fds[j].revents = 0;
+	http_server_unlock();
+}
 
-					service->data->num_clients++;
+static void worker_run(struct http_server_worker *worker)
+{
+	int id = ARRAY_INDEX(server_ctx.workers, worker);
+	struct http_client_ctx *client;
+	eventfd_t value;
+	int ret;
 
-					LOG_DBG("Init client #%d", j - ctx->listen_fds);
+	worker_update_clients(worker, id);
 
-					init_client_ctx(&ctx->clients[j - ctx->listen_fds], service,
-							new_socket);
-					found_slot = true;
-					break;
-				}
+	while (1) {
+		ret = zsock_poll(worker->fds, ARRAY_SIZE(worker->fds), -1);
+		if (ret < 0) {
+			LOG_ERR("Worker %d poll failed (%d)", id, -errno);
 
-				if (!found_slot) {
-					LOG_DBG("No free slot found.");
-					zsock_close(new_socket);
-				}
+			/* Let the server thread restart the server */
+			worker->failed = true;
+			eventfd_write(server_ctx.fds[0].fd, 1);
 
-				continue;
+			while (!worker->stop) {
+				(void)eventfd_read(worker->fds[0].fd, &value);
 			}
 
-			/* Client sock */
-			client = &ctx->clients[i - ctx->listen_fds];
+			break;
+		}
 
-			ret = zsock_recv(client->fd, client->buffer + client->data_len,
-					 sizeof(client->buffer) - client->data_len, 0);
-			if (ret <= 0) {
-				if (ret == 0) {
-					LOG_DBG("Connection closed by peer for client #%d",
-						i - ctx->listen_fds);
-				} else {
-					ret = -errno;
-					LOG_DBG("ERROR reading from socket (%d)", ret);
-				}
+		if (worker->fds[0].revents) {
+			eventfd_read(worker->fds[0].fd, &value);
 
-				close_client_connection(client);
-				continue;
+			if (worker->stop) {
+				break;
 			}
 
-			client->data_len += ret;
-
-			http_client_timer_restart(client);
+			/* New clients were given to the worker */
+			worker_update_clients(worker, id);
+			continue;
+		}
 
-			ret = handle_http_request(client);
-			if (ret < 0 && ret != -EAGAIN) {
-				if (ret == -ENOTCONN) {
-					LOG_DBG("Client closed connection while handling request");
-				} else {
-					LOG_ERR("HTTP request handling error (%d)", ret);
-				}
-				close_client_connection(client);
-			} else if (client->data_len == sizeof(client->buffer)) {
-				/* If the RX buffer is still full after parsing,
-				 * it means we won't be able to handle this request
-				 * with the current buffer size.
-				 */
-				LOG_ERR("RX buffer too small to handle request");
-				close_client_connection(client);
+		for (int i = 1; i < ARRAY_SIZE(worker->fds); i++) {
+			if (worker->fds[i].fd < 0 || worker->fds[i].revents == 0) {
+				continue;
 			}
+
+			client = &server_ctx.clients[id + (i - 1) * HTTP_SERVER_NUM_WORKERS];
+			handle_client_events(client, worker->fds[i].revents);
 		}
 	}
 
-	return 0;
-
-closing:
-	/* Close all client connections and the server socket */
-	close_all_sockets(ctx);
-	return ret;
+	for (int i = id; i < HTTP_SERVER_MAX_CLIENTS; i += HTTP_SERVER_NUM_WORKERS) {
+		if (server_ctx.clients[i].fd != INVALID_SOCK) {
+			close_client_connection(&server_ctx.clients[i]);
+		}
+	}
 }
 
-/* Compare a path and a resource string. The path string comes from the HTTP request and may be
- * terminated by either '?' or '\0'. The resource string is registered along with the resource and
- * may only be terminated by `\0`.
- */
-static int compare_strings(const char *path, const char *resource)
+static void http_server_worker_thread(void *p1, void *p2, void *p3)
 {
-	while ((*path && *resource) && (*path == *resource) && (*path != '?')) {
-		path++;
-		resource++;
-	}
+	struct http_server_worker *worker = p1;
 
-	/* Check if both strings have reached their terminators */
-	if ((*path == '\0' || *path == '?') && (*resource == '\0')) {
-		return 0; /* Strings are equal */
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&worker->start, K_FOREVER);
+
+		worker_run(worker);
+
+		k_sem_give(&worker->stopped);
 	}
+}
 
-	return 1; /* Strings are not equal */
+static void workers_init(struct http_server_ctx *ctx)
+{
+	char name[sizeof("http_worker_xx")];
+
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		int id = ARRAY_INDEX(ctx->workers, worker);
+
+		k_sem_init(&worker->start, 0, 1);
+		k_sem_init(&worker->stopped, 0, 1);
+
+		k_thread_create(&worker->thread, http_server_worker_stacks[id],
+				K_THREAD_STACK_SIZEOF(http_server_worker_stacks[id]),
+				http_server_worker_thread, worker, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		snprintk(name, sizeof(name), "http_worker_%d", id);
+		k_thread_name_set(&worker->thread, name);
+	}
 }
 
-static int path_len_without_query(const char *path)
+static int workers_start(struct http_server_ctx *ctx)
 {
-	int len = 0;
+	int fd;
 
-	while ((path[len] != '\0') && (path[len] != '?')) {
-		len++;
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		fd = eventfd(0, 0);
+		if (fd < 0) {
+			fd = -errno;
+			LOG_ERR("eventfd failed (%d)", fd);
+
+			while (worker-- != ctx->workers) {
+				zsock_close(worker->fds[0].fd);
+			}
+
+			return fd;
+		}
+
+		for (int i = 0; i < ARRAY_SIZE(worker->fds); i++) {
+			worker->fds[i].fd = INVALID_SOCK;
+		}
+
+		worker->fds[0].fd = fd;
+		worker->fds[0].events = ZSOCK_POLLIN;
+		worker->num_clients = 0;
+		worker->stop = false;
+		worker->failed = false;
 	}
 
-	return len;
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		k_sem_give(&worker->start);
+	}
+
+	return 0;
 }
 
-static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
+static void workers_stop(struct http_server_ctx *ctx)
 {
-	struct http_resource_detail *detail;
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		worker->stop = true;
+		eventfd_write(worker->fds[0].fd, 1);
+	}
 
-	detail = (struct http_resource_detail *)resource->detail;
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		k_sem_take(&worker->stopped, K_FOREVER);
 
-	if (is_websocket) {
-		if (detail->type != HTTP_RESOURCE_TYPE_WEBSOCKET) {
-			return true;
-		}
-	} else {
-		if (detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET) {
+		zsock_close(worker->fds[0].fd);
+		worker->fds[0].fd = INVALID_SOCK;
+	}
+}
+
+static bool workers_failed(struct http_server_ctx *ctx)
+{
+	ARRAY_FOR_EACH_PTR(ctx->workers, worker) {
+		if (worker->failed) {
 			return true;
 		}
 	}
 
 	return false;
 }
-
-struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
-						 const char *path, int *path_len, bool is_websocket)
+#else
+static bool add_client(struct http_server_ctx *ctx, const struct http_service_desc *service,
+		       int new_socket)
 {
-	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
-		if (skip_this(resource, is_websocket)) {
+	for (int j = ctx->listen_fds; j < ARRAY_SIZE(ctx->fds); j++) {
+		if (ctx->fds[j].fd != INVALID_SOCK) {
 			continue;
 		}
 
-		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
-			int ret;
+		ctx->fds[j].fd = new_socket;
+		ctx->fds[j].events = ZSOCK_POLLIN;
+		ctx->fds[j].revents = 0;
 
-			ret = fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR));
-			if (ret == 0) {
-				*path_len = path_len_without_query(path);
-				return resource->detail;
-			}
-		}
+		service->data->num_clients++;
 
-		if (compare_strings(path, resource->resource) == 0) {
-			NET_DBG("Got match for %s", resource->resource);
+		LOG_DBG("Init client #%d", j - ctx->listen_fds);
 
-			*path_len = strlen(resource->resource);
-			return resource->detail;
-		}
-	}
+		init_client_ctx(&ctx->clients[j - ctx->listen_fds], service, new_socket);
 
-	if (service->res_fallback != NULL) {
-		*path_len = path_len_without_query(path);
-		return service->res_fallback;
+		return true;
 	}
 
-	NET_DBG("No match for %s", path);
+	return false;
+}
 
-	return NULL;
+static inline void resume_accepting(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
 }
 
-int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
-			  uint8_t supported_compression, enum http_compression *chosen_compression)
+static inline void workers_init(struct http_server_ctx *ctx)
 {
-	struct fs_dirent dirent;
-	size_t len;
-	int ret;
+	ARG_UNUSED(ctx);
+}
 
-	len = strlen(fname);
-	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
-		*chosen_compression = HTTP_NONE;
-		if (IS_BIT_SET(supported_compression, HTTP_BR)) {
-			snprintk(fname + len, fname_size - len, ".br");
-			ret = fs_stat(fname, &dirent);
-			if (ret == 0) {
-				*chosen_compression = HTTP_BR;
-				goto return_filename;
-			}
-		}
-		if (IS_BIT_SET(supported_compression, HTTP_GZIP)) {
-			snprintk(fname + len, fname_size - len, ".gz");
-			ret = fs_stat(fname, &dirent);
-			if (ret == 0) {
-				*chosen_compression = HTTP_GZIP;
-				goto return_filename;
-			}
-		}
-		if (IS_BIT_SET(supported_compression, HTTP_ZSTD)) {
-			snprintk(fname + len, fname_size - len, ".zst");
-			ret = fs_stat(fname, &dirent);
-			if (ret == 0) {
-				*chosen_compression = HTTP_ZSTD;
-				goto return_filename;
-			}
-		}
-		if (IS_BIT_SET(supported_compression, HTTP_COMPRESS)) {
-			snprintk(fname + len, fname_size - len, ".lzw");
-			ret = fs_stat(fname, &dirent);
+static inline int workers_start(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	return 0;
+}
+
+static inline void workers_stop(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+}
+
+static inline bool workers_failed(struct http_server_ctx *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	return false;
+}
+#endif /* HTTP_SERVER_NUM_WORKERS > 0 */
+
+static int http_server_run(struct http_server_ctx *ctx)
+{
+	const struct http_service_desc *service;
+	eventfd_t value;
+	int new_socket;
+	int ret, i;
+	int sock_error;
+	socklen_t optlen = sizeof(int);
+
+	value = 0;
+
+	ret = workers_start(ctx);
+	if (ret < 0) {
+		close_all_sockets(ctx);
+		return ret;
+	}
+
+	while (1) {
+		ret = zsock_poll(ctx->fds, HTTP_SERVER_SOCK_COUNT, -1);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_DBG("poll failed (%d)", ret);
+			goto closing;
+		}
+
+		if (ret == 0) {
+			/* should not happen because timeout is -1 */
+			break;
+		}
+
+		if (ctx->fds[0].revents) {
+			eventfd_read(ctx->fds[0].fd, &value);
+
+			if (!server_running) {
+				LOG_DBG("Received stop event. exiting ..");
+				ret = 0;
+				goto closing;
+			}
+
+			if (workers_failed(ctx)) {
+				ret = -EIO;
+				goto closing;
+			}
+
+			/* The workers have released clients */
+			resume_accepting(ctx);
+		}
+
+		for (i = 1; i < ARRAY_SIZE(ctx->fds); i++) {
+			if (ctx->fds[i].fd < 0) {
+				continue;
+			}
+
+			if (i >= ctx->listen_fds) {
+				handle_client_events(&ctx->clients[i - ctx->listen_fds],
+						     ctx->fds[i].revents);
+				continue;
+			}
+
+			if (ctx->fds[i].revents & ZSOCK_POLLHUP) {
+				continue;
+			}
+
+			if (ctx->fds[i].revents & ZSOCK_POLLERR) {
+				(void)zsock_getsockopt(ctx->fds[i].fd, SOL_SOCKET,
+						       SO_ERROR, &sock_error, &optlen);
+				LOG_DBG("Error on fd %d %d", ctx->fds[i].fd, sock_error);
+
+				/* Listening socket error, abort. */
+				LOG_ERR("Listening socket error, aborting.");
+				ret = -sock_error;
+				goto closing;
+
+			}
+
+			if (!(ctx->fds[i].revents & ZSOCK_POLLIN)) {
+				continue;
+			}
+
+			service = lookup_service(ctx->fds[i].fd);
+			__ASSERT(NULL != service, "fd not associated with a service");
+
+			if (service->data->num_clients >= service->concurrent) {
+				ctx->fds[i].events = 0;
+				continue;
+			}
+
+			new_socket = accept_new_client(ctx->fds[i].fd);
+			if (new_socket < 0) {
+				ret = -errno;
+				LOG_DBG("accept: %d", ret);
+				continue;
+			}
+
+			if (!add_client(ctx, service, new_socket)) {
+				LOG_DBG("No free slot found.");
+				zsock_close(new_socket);
+			}
+		}
+	}
+
+	workers_stop(ctx);
+
+	return 0;
+
+closing:
+	/* Close all client connections and the server socket */
+	workers_stop(ctx);
+	close_all_sockets(ctx);
+	return ret;
+}
+
+/* Compare a path and a resource string. The path string comes from the HTTP request and may be
+ * terminated by either '?' or '\0'. The resource string is registered along with the resource and
+ * may only be terminated by `\0`.
+ */
+static int compare_strings(const char *path, const char *resource)
+{
+	while ((*path && *resource) && (*path == *resource) && (*path != '?')) {
+		path++;
+		resource++;
+	}
+
+	/* Check if both strings have reached their terminators */
+	if ((*path == '\0' || *path == '?') && (*resource == '\0')) {
+		return 0; /* Strings are equal */
+	}
+
+	return 1; /* Strings are not equal */
+}
+
+static int path_len_without_query(const char *path)
+{
+	int len = 0;
+
+	while ((path[len] != '\0') && (path[len] != '?')) {
+		len++;
+	}
+
+	return len;
+}
+
+static bool skip_this(struct http_resource_desc *resource, bool is_websocket)
+{
+	struct http_resource_detail *detail;
+
+	detail = (struct http_resource_detail *)resource->detail;
+
+	if (is_websocket) {
+		if (detail->type != HTTP_RESOURCE_TYPE_WEBSOCKET) {
+			return true;
+		}
+	} else {
+		if (detail->type == HTTP_RESOURCE_TYPE_WEBSOCKET) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool resource_matches(struct http_resource_desc *resource, const char *path)
+{
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+	    fnmatch(resource->resource, path, (FNM_PATHNAME | FNM_LEADING_DIR)) == 0) {
+		return true;
+	}
+
+	if (compare_strings(path, resource->resource) == 0) {
+		NET_DBG("Got match for %s", resource->resource);
+		return true;
+	}
+
+	return false;
+}
+
+static struct http_resource_desc *find_resource(const struct http_service_desc *service,
+						const char *path, bool is_websocket)
+{
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		if (skip_this(resource, is_websocket)) {
+			continue;
+		}
+
+		if (resource_matches(resource, path)) {
+			return resource;
+		}
+	}
+
+	return NULL;
+}
+
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TRIE)
+#define ROUTE_NONE UINT16_MAX
+
+/* A node of the trie stands for a path prefix, made of whole segments, of
+ * resources of a service. Its last segment is taken from the resource string
+ * of one of these resources.
+ */
+struct http_route_node {
+	uint16_t rep;          /* Index of a resource with that prefix */
+	uint16_t seg;          /* Offset of the last segment in its string */
+	uint16_t end;          /* Length of the prefix */
+	uint16_t first_child;  /* Children, sorted by segment */
+	uint16_t num_children;
+	uint16_t first_wild;   /* Wildcard resources, sorted by index */
+	uint16_t num_wild;
+	uint16_t res[2];       /* First resource ending here, websocket in res[1] */
+};
+
+static struct http_route_node route_nodes[CONFIG_HTTP_SERVER_RESOURCE_TRIE_SIZE];
+static uint16_t route_wild[CONFIG_HTTP_SERVER_RESOURCE_TRIE_SIZE];
+static size_t route_nodes_used;
+static size_t route_wild_used;
+
+static const char *route_seg(const struct http_service_desc *service,
+			     const struct http_route_node *node, size_t *len)
+{
+	*len = node->end - node->seg;
+
+	return service->res_begin[node->rep].resource + node->seg;
+}
+
+static int route_cmp(const char *a, size_t a_len, const char *b, size_t b_len)
+{
+	if (a_len != b_len) {
+		return a_len < b_len ? -1 : 1;
+	}
+
+	return memcmp(a, b, a_len);
+}
+
+/* Segments which cannot be compared literally with the ones of a path. A
+ * question mark starts the query of a path even without wildcards, so such
+ * a resource never matches.
+ */
+static bool route_is_pattern(const char *seg, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (seg[i] == '?') {
+			return true;
+		}
+
+		if (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) &&
+		    (seg[i] == '*' || seg[i] == '[' || seg[i] == '\\')) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int route_alloc(uint16_t rep, uint16_t seg, uint16_t end)
+{
+	struct http_route_node *node;
+
+	if (route_nodes_used == ARRAY_SIZE(route_nodes)) {
+		return -ENOMEM;
+	}
+
+	node = &route_nodes[route_nodes_used];
+	node->rep = rep;
+	node->seg = seg;
+	node->end = end;
+	node->num_children = 0;
+	node->num_wild = 0;
+	node->res[0] = ROUTE_NONE;
+	node->res[1] = ROUTE_NONE;
+
+	return route_nodes_used++;
+}
+
+static const struct http_route_node *route_child(const struct http_service_desc *service,
+						 const struct http_route_node *node,
+						 const char *seg, size_t len)
+{
+	int lo = node->first_child;
+	int hi = lo + node->num_children;
+	const char *child_seg;
+	size_t child_len;
+	int mid;
+	int cmp;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		child_seg = route_seg(service, &route_nodes[mid], &child_len);
+
+		cmp = route_cmp(seg, len, child_seg, child_len);
+		if (cmp == 0) {
+			return &route_nodes[mid];
+		}
+
+		if (cmp < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
+static int route_add_wild(struct http_route_node *node, uint16_t i)
+{
+	if (route_wild_used == ARRAY_SIZE(route_wild)) {
+		return -ENOMEM;
+	}
+
+	route_wild[route_wild_used++] = i;
+	node->num_wild++;
+
+	return 0;
+}
+
+static int route_add_child(const struct http_service_desc *service, struct http_route_node *node,
+			   uint16_t i, const char *seg, size_t len)
+{
+	const char *child_seg;
+	size_t child_len;
+
+	for (int c = node->first_child; c < route_nodes_used; c++) {
+		child_seg = route_seg(service, &route_nodes[c], &child_len);
+		if (route_cmp(seg, len, child_seg, child_len) == 0) {
+			return 0;
+		}
+	}
+
+	return route_alloc(i, seg - service->res_begin[i].resource,
+			   seg - service->res_begin[i].resource + len);
+}
+
+/* Adds the children of a node, i.e. the next segments of the resources with
+ * its prefix, and the resources ending at it or with a wildcard in their
+ * next segment. The nodes are built breadth first, so that the children of
+ * a node are next to each other and can be sorted.
+ */
+static int route_build_node(const struct http_service_desc *service, int n)
+{
+	struct http_route_node *node = &route_nodes[n];
+	const char *prefix = service->res_begin[node->rep].resource;
+	struct http_route_node child;
+	const char *child_seg;
+	size_t child_len;
+	const char *str;
+	const char *seg;
+	uint16_t i;
+	size_t len;
+	int ret;
+	int c;
+	int j;
+
+	node->first_child = route_nodes_used;
+	node->first_wild = route_wild_used;
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		i = resource - service->res_begin;
+		str = resource->resource;
+
+		if (strncmp(str, prefix, node->end) != 0) {
+			continue;
+		}
+
+		if (str[node->end] == '\0' && node->end > 0) {
+			c = ((struct http_resource_detail *)resource->detail)->type ==
+			    HTTP_RESOURCE_TYPE_WEBSOCKET;
+			if (node->res[c] == ROUTE_NONE) {
+				node->res[c] = i;
+			}
+
+			continue;
+		}
+
+		if (str[node->end] == '/') {
+			seg = str + node->end + 1;
+			len = strcspn(seg, "/");
+		} else if (node->end == 0) {
+			/* Resources not starting with a slash are matched with
+			 * the whole path.
+			 */
+			seg = NULL;
+			len = 0;
+		} else {
+			continue;
+		}
+
+		if (seg == NULL || route_is_pattern(seg, len)) {
+			ret = route_add_wild(node, i);
+		} else {
+			ret = route_add_child(service, node, i, seg, len);
+		}
+
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	node->num_children = route_nodes_used - node->first_child;
+
+	/* Insertion sort, the children do not have children yet */
+	for (c = node->first_child + 1; c < route_nodes_used; c++) {
+		child = route_nodes[c];
+		seg = route_seg(service, &child, &len);
+
+		for (j = c; j > node->first_child; j--) {
+			child_seg = route_seg(service, &route_nodes[j - 1], &child_len);
+			if (route_cmp(child_seg, child_len, seg, len) <= 0) {
+				break;
+			}
+
+			route_nodes[j] = route_nodes[j - 1];
+		}
+
+		route_nodes[j] = child;
+	}
+
+	return 0;
+}
+
+static int route_build(const struct http_service_desc *service)
+{
+	size_t nodes_used = route_nodes_used;
+	size_t wild_used = route_wild_used;
+	int root;
+	int ret;
+
+	if (HTTP_SERVICE_RESOURCE_COUNT(service) == 0) {
+		return -ENOENT;
+	}
+
+	if (HTTP_SERVICE_RESOURCE_COUNT(service) >= ROUTE_NONE) {
+		return -E2BIG;
+	}
+
+	HTTP_SERVICE_FOREACH_RESOURCE(service, resource) {
+		if (strlen(resource->resource) >= UINT16_MAX) {
+			return -E2BIG;
+		}
+	}
+
+	root = route_alloc(0, 0, 0);
+
+	for (int n = root; n >= 0 && n < route_nodes_used; n++) {
+		ret = route_build_node(service, n);
+		if (ret < 0) {
+			root = ret;
+			break;
+		}
+	}
+
+	if (root < 0) {
+		route_nodes_used = nodes_used;
+		route_wild_used = wild_used;
+	}
+
+	return root;
+}
+
+static int http_server_routes_init(void)
+{
+	HTTP_SERVICE_FOREACH(svc) {
+		svc->data->route_root = route_build(svc);
+
+		if (svc->data->route_root == -ENOMEM) {
+			LOG_WRN("Resource trie full, resources of %s looked up linearly, "
+				"increase CONFIG_HTTP_SERVER_RESOURCE_TRIE_SIZE",
+				svc->host != NULL ? svc->host : "(any)");
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(http_server_routes_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+/* Follows the segments of the path down the trie, and returns the first
+ * resource in section order among the ones ending at the last node, the ones
+ * ending at the nodes above it if wildcards are allowed (as with
+ * FNM_LEADING_DIR) and the wildcard resources matching the path.
+ */
+static struct http_resource_desc *route_find(const struct http_service_desc *service,
+					     const char *path, bool is_websocket)
+{
+	const struct http_route_node *node;
+	uint16_t best = ROUTE_NONE;
+	const char *seg = path;
+	uint16_t i;
+	size_t len;
+
+	if (service->data->route_root < 0) {
+		return find_resource(service, path, is_websocket);
+	}
+
+	node = &route_nodes[service->data->route_root];
+
+	while (true) {
+		for (int w = 0; w < node->num_wild; w++) {
+			i = route_wild[node->first_wild + w];
+			if (i >= best) {
+				break;
+			}
+
+			if (!skip_this(&service->res_begin[i], is_websocket) &&
+			    resource_matches(&service->res_begin[i], path)) {
+				best = i;
+				break;
+			}
+		}
+
+		if (*seg == '\0' || *seg == '?' ||
+		    (IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD) && *seg == '/')) {
+			best = MIN(best, node->res[is_websocket]);
+		}
+
+		if (*seg != '/') {
+			break;
+		}
+
+		seg++;
+		len = strcspn(seg, "/?");
+
+		node = route_child(service, node, seg, len);
+		if (node == NULL) {
+			break;
+		}
+
+		seg += len;
+	}
+
+	return best == ROUTE_NONE ? NULL : &service->res_begin[best];
+}
+#endif /* CONFIG_HTTP_SERVER_RESOURCE_TRIE */
+
+struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+						 const char *path, int *path_len, bool is_websocket)
+{
+	struct http_resource_desc *resource;
+
+#if defined(CONFIG_HTTP_SERVER_RESOURCE_TRIE)
+	resource = route_find(service, path, is_websocket);
+#else
+	resource = find_resource(service, path, is_websocket);
+#endif
+	if (resource != NULL) {
+		*path_len = path_len_without_query(path);
+		return resource->detail;
+	}
+
+	if (service->res_fallback != NULL) {
+		*path_len = path_len_without_query(path);
+		return service->res_fallback;
+	}
+
+	NET_DBG("No match for %s", path);
+
+	return NULL;
+}
+
+int http_server_find_file(char *fname, size_t fname_size, size_t *file_size,
+			  uint8_t supported_compression, enum http_compression *chosen_compression)
+{
+	struct fs_dirent dirent;
+	size_t len;
+	int ret;
+
+	len = strlen(fname);
+	if (IS_ENABLED(CONFIG_HTTP_SERVER_COMPRESSION)) {
+		*chosen_compression = HTTP_NONE;
+		if (IS_BIT_SET(supported_compression, HTTP_BR)) {
+			snprintk(fname + len, fname_size - len, ".br");
+			ret = fs_stat(fname, &dirent);
+			if (ret == 0) {
+				*chosen_compression = HTTP_BR;
+				goto return_filename;
+			}
+		}
+		if (IS_BIT_SET(supported_compression, HTTP_GZIP)) {
+			snprintk(fname + len, fname_size - len, ".gz");
+			ret = fs_stat(fname, &dirent);
+			if (ret == 0) {
+				*chosen_compression = HTTP_GZIP;
+				goto return_filename;
+			}
+		}
+		if (IS_BIT_SET(supported_compression, HTTP_ZSTD)) {
+			snprintk(fname + len, fname_size - len, ".zst");
+			ret = fs_stat(fname, &dirent);
+			if (ret == 0) {
+				*chosen_compression = HTTP_ZSTD;
+				goto return_filename;
+			}
+		}
+		if (IS_BIT_SET(supported_compression, HTTP_COMPRESS)) {
+			snprintk(fname + len, fname_size - len, ".lzw");
+			ret = fs_stat(fname, &dirent);
 			if (ret == 0) {
 				*chosen_compression = HTTP_COMPRESS;
 				goto return_filename;
@@ -896,6 +1630,67 @@ int http_server_sendall(struct http_client_ctx *client, const void *buf, size_t
 	return 0;
 }
 
+int http_server_sendall_iov(struct http_client_ctx *client, struct iovec *iov, size_t iovcnt)
+{
+	struct msghdr msg = {
+		.msg_iov = iov,
+		.msg_iovlen = iovcnt,
+	};
+	ssize_t out_len;
+	size_t len;
+
+	while (msg.msg_iovlen > 0) {
+		if (msg.msg_iov->iov_len == 0) {
+			msg.msg_iov++;
+			msg.msg_iovlen--;
+			continue;
+		}
+
+		out_len = zsock_sendmsg(client->fd, &msg, 0);
+		if (out_len < 0) {
+			return -errno;
+		}
+
+		/* Skip what was sent */
+		while (out_len > 0) {
+			len = MIN((size_t)out_len, msg.msg_iov->iov_len);
+
+			msg.msg_iov->iov_base = (uint8_t *)msg.msg_iov->iov_base + len;
+			msg.msg_iov->iov_len -= len;
+			out_len -= len;
+
+			if (msg.msg_iov->iov_len == 0) {
+				msg.msg_iov++;
+				msg.msg_iovlen--;
+			}
+		}
+
+		http_client_timer_restart(client);
+	}
+
+	return 0;
+}
+
+#if defined(CONFIG_FILE_SYSTEM)
+/* One buffer per thread serving clients */
+static uint8_t file_buffers[MAX(HTTP_SERVER_NUM_WORKERS, 1)][CONFIG_HTTP_SERVER_FILE_CHUNK_SIZE];
+
+uint8_t *http_server_file_buffer(struct http_client_ctx *client, size_t *len)
+{
+	int thread = 0;
+
+#if HTTP_SERVER_NUM_WORKERS > 0
+	thread = ARRAY_INDEX(server_ctx.clients, client) % HTTP_SERVER_NUM_WORKERS;
+#else
+	ARG_UNUSED(client);
+#endif
+
+	*len = sizeof(file_buffers[thread]);
+
+	return file_buffers[thread];
+}
+#endif /* CONFIG_FILE_SYSTEM */
+
 bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status status)
 {
 	if (status != HTTP_SERVER_DATA_FINAL) {
@@ -910,6 +1705,166 @@ bool http_response_is_final(struct http_response_ctx *rsp, enum http_data_status
 	return false;
 }
 
+bool http_server_hold_resource(struct http_resource_detail_dynamic *detail,
+			       struct http_client_ctx *client)
+{
+	bool held;
+
+	http_server_lock();
+
+	held = detail->holder == NULL || detail->holder == client;
+	if (held) {
+		detail->holder = client;
+	}
+
+	http_server_unlock();
+
+	return held;
+}
+
+bool http_server_release_resource(struct http_resource_detail_dynamic *detail,
+				  struct http_client_ctx *client)
+{
+	bool held;
+
+	http_server_lock();
+
+	held = detail->holder == client;
+	if (held) {
+		detail->holder = NULL;
+	}
+
+	http_server_unlock();
+
+	return held;
+}
+
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+/* Clients send back the ETag of the cached responses in this header. */
+HTTP_SERVER_REGISTER_HEADER_CAPTURE(http_server_if_none_match, "If-None-Match");
+
+static int http_server_caches_init(void)
+{
+	HTTP_SERVICE_FOREACH(svc) {
+		HTTP_SERVICE_FOREACH_RESOURCE(svc, resource) {
+			struct http_resource_detail_dynamic *detail = resource->detail;
+
+			if (detail->common.type == HTTP_RESOURCE_TYPE_DYNAMIC &&
+			    detail->cache != NULL) {
+				detail->cache->path = resource->resource;
+			}
+		}
+	}
+
+	return 0;
+}
+
+SYS_INIT(http_server_caches_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+struct http_resource_cache *http_server_cache_get(struct http_resource_detail_dynamic *detail,
+						  struct http_client_ctx *client)
+{
+	struct http_resource_cache *cache = detail->cache;
+
+	/* The response to a request with a query depends on it, so it is
+	 * neither served from the cache nor stored in it.
+	 */
+	if (cache == NULL || client->method != HTTP_GET ||
+	    client->url_buffer[client->path_len] != '\0') {
+		return NULL;
+	}
+
+	/* Nor is the response for other paths than the one of the resource,
+	 * which resources with wildcards and the fallback resource answer.
+	 */
+	if (cache->path == NULL || strcmp(cache->path, (const char *)client->url_buffer) != 0) {
+		return NULL;
+	}
+
+	return cache;
+}
+
+/* The cache is only accessed by the holder of its resource, apart from
+ * the generation.
+ */
+bool http_server_cache_is_fresh(struct http_resource_cache *cache)
+{
+	return cache->valid &&
+	       cache->response_generation == atomic_get(&cache->generation) &&
+	       k_uptime_get() < cache->expiry;
+}
+
+void http_server_cache_start(struct http_resource_cache *cache)
+{
+	cache->valid = false;
+	cache->storing = true;
+	cache->len = 0;
+	cache->response_generation = atomic_get(&cache->generation);
+}
+
+void http_server_cache_store(struct http_resource_cache *cache,
+			     const struct http_response_ctx *rsp)
+{
+	size_t body_len = rsp->body != NULL ? rsp->body_len : 0;
+
+	if (!cache->storing) {
+		return;
+	}
+
+	/* The headers of the application are not kept */
+	if ((rsp->status != 0 && rsp->status != HTTP_200_OK) || rsp->header_count > 0 ||
+	    body_len > cache->buf_len - cache->len) {
+		LOG_DBG("Response not cacheable");
+		cache->storing = false;
+		return;
+	}
+
+	if (body_len > 0) {
+		memcpy(cache->buf + cache->len, rsp->body, body_len);
+		cache->len += body_len;
+	}
+}
+
+void http_server_cache_finish(struct http_resource_cache *cache)
+{
+	if (!cache->storing) {
+		return;
+	}
+
+	cache->storing = false;
+	cache->etag = crc32_ieee(cache->buf, cache->len);
+	cache->expiry = k_uptime_get() + cache->ttl_ms;
+	cache->valid = true;
+}
+
+void http_server_cache_etag(struct http_resource_cache *cache, char *etag, size_t len)
+{
+	snprintk(etag, len, "\"%08x\"", cache->etag);
+}
+
+bool http_server_cache_not_modified(struct http_client_ctx *client, const char *etag)
+{
+	const struct http_header_capture_ctx *ctx = &client->header_capture_ctx;
+
+	for (size_t i = 0; i < ctx->count; i++) {
+		if (strcasecmp(ctx->headers[i].name, "If-None-Match") != 0) {
+			continue;
+		}
+
+		/* A list of ETags, possibly marked as weak, or any ETag */
+		return strcmp(ctx->headers[i].value, "*") == 0 ||
+		       strstr(ctx->headers[i].value, etag) != NULL;
+	}
+
+	return false;
+}
+
+void http_resource_cache_invalidate(struct http_resource_cache *cache)
+{
+	atomic_inc(&cache->generation);
+}
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 bool http_response_is_provided(struct http_response_ctx *rsp)
 {
 	if (rsp->status != 0 || rsp->header_count > 0 || rsp->body_len > 0) {
@@ -975,6 +1930,8 @@ static void http_server_thread(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
+	workers_init(&server_ctx);
+
 	while (true) {
 		k_sem_take(&server_start, K_FOREVER);
 
@@ -132,6 +132,7 @@ static int handle_http1_static_resource(
 			   sizeof("Content-Type: \r\n") + HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
 			   sizeof("xxxx") +
 			   sizeof("\r\n")];
+	struct iovec iov[2];
 	const char *data;
 	int len;
 	int ret;
@@ -160,18 +161,19 @@ static int handle_http1_static_resource(
 			 len);
 	}
 
-	ret = http_server_sendall(client, http_response, strlen(http_response));
+	/* The data is sent from where it is stored along with the headers */
+	iov[0].iov_base = http_response;
+	iov[0].iov_len = strlen(http_response);
+	iov[1].iov_base = (void *)data;
+	iov[1].iov_len = len;
+
+	ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 	if (ret < 0) {
 		return ret;
 	}
 
 	client->http1_headers_sent = true;
 
-	ret = http_server_sendall(client, data, len);
-	if (ret < 0) {
-		return ret;
-	}
-
 	return 0;
 }
 
@@ -337,6 +339,52 @@ static int http1_dynamic_response(struct http_client_ctx *client, struct http_re
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+#define RESPONSE_TEMPLATE_CACHED                                                                   \
+	"HTTP/1.1 200 OK\r\n"                                                                      \
+	"Content-Type: %s\r\n"                                                                     \
+	"Content-Length: %zu\r\n"                                                                  \
+	"ETag: %s\r\n\r\n"
+
+#define RESPONSE_TEMPLATE_NOT_MODIFIED                                                             \
+	"HTTP/1.1 304 Not Modified\r\n"                                                            \
+	"ETag: %s\r\n\r\n"
+
+static int http1_send_cached(struct http_client_ctx *client,
+			     struct http_resource_detail_dynamic *dynamic_detail)
+{
+	struct http_resource_cache *cache = dynamic_detail->cache;
+	const char *content_type = dynamic_detail->common.content_type;
+	char http_response[sizeof(RESPONSE_TEMPLATE_CACHED) +
+			   HTTP_SERVER_MAX_CONTENT_TYPE_LEN +
+			   sizeof("4294967295") +
+			   HTTP_SERVER_ETAG_LEN];
+	char etag[HTTP_SERVER_ETAG_LEN];
+	struct iovec iov[2];
+
+	http_server_cache_etag(cache, etag, sizeof(etag));
+	client->http1_headers_sent = true;
+
+	if (http_server_cache_not_modified(client, etag)) {
+		snprintk(http_response, sizeof(http_response),
+			 RESPONSE_TEMPLATE_NOT_MODIFIED, etag);
+
+		return http_server_sendall(client, http_response, strlen(http_response));
+	}
+
+	snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_CACHED,
+		 content_type == NULL ? "text/html" : content_type, cache->len, etag);
+
+	/* The body is sent from the cache along with the headers */
+	iov[0].iov_base = http_response;
+	iov[0].iov_len = strlen(http_response);
+	iov[1].iov_base = cache->buf;
+	iov[1].iov_len = cache->len;
+
+	return http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
+}
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 static int dynamic_get_del_req(struct http_resource_detail_dynamic *dynamic_detail,
 			       struct http_client_ctx *client)
 {
@@ -345,9 +393,23 @@ static int dynamic_get_del_req(struct http_resource_detail_dynamic *dynamic_deta
 	enum http_data_status status;
 	struct http_request_ctx request_ctx;
 	struct http_response_ctx response_ctx;
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	struct http_resource_cache *cache = http_server_cache_get(dynamic_detail, client);
+
+	if (cache != NULL) {
+		if (http_server_cache_is_fresh(cache)) {
+			ret = http1_send_cached(client, dynamic_detail);
+			(void)http_server_release_resource(dynamic_detail, client);
+
+			return ret < 0 ? ret : 0;
+		}
+
+		http_server_cache_start(cache);
+	}
+#endif
 
 	/* Start of GET params */
-	ptr = &client->url_buffer[dynamic_detail->common.path_len];
+	ptr = &client->url_buffer[client->path_len];
 	len = strlen(ptr);
 	status = HTTP_SERVER_DATA_FINAL;
 
@@ -361,6 +423,12 @@ static int dynamic_get_del_req(struct http_resource_detail_dynamic *dynamic_deta
 			return ret;
 		}
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+		if (cache != NULL) {
+			http_server_cache_store(cache, &response_ctx);
+		}
+#endif
+
 		ret = http1_dynamic_response(client, &response_ctx, dynamic_detail);
 		if (ret < 0) {
 			return ret;
@@ -370,7 +438,13 @@ static int dynamic_get_del_req(struct http_resource_detail_dynamic *dynamic_deta
 		len = 0;
 	} while (!http_response_is_final(&response_ctx, status));
 
-	dynamic_detail->holder = NULL;
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	if (cache != NULL) {
+		http_server_cache_finish(cache);
+	}
+#endif
+
+	(void)http_server_release_resource(dynamic_detail, client);
 
 	ret = http_server_sendall(client, final_chunk,
 				  sizeof(final_chunk) - 1);
@@ -458,7 +532,7 @@ static int dynamic_post_put_req(struct http_resource_detail_dynamic *dynamic_det
 			return ret;
 		}
 
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 	return 0;
@@ -497,6 +571,9 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 	char fname[HTTP_SERVER_MAX_URL_LENGTH];
 	char content_type[HTTP_SERVER_MAX_CONTENT_TYPE_LEN] = "text/html";
 	char http_response[STATIC_FS_RESPONSE_SIZE];
+	struct iovec iov[2];
+	size_t chunk_size;
+	uint8_t *chunk;
 
 	if (client->method != HTTP_GET) {
 		return send_http1_405(client);
@@ -546,29 +623,39 @@ int handle_http1_static_fs_resource(struct http_resource_detail_static_fs *stati
 		len = snprintk(http_response, sizeof(http_response), RESPONSE_TEMPLATE_STATIC_FS,
 			       file_size, content_type, "", "");
 	}
-	ret = http_server_sendall(client, http_response, len);
-	if (ret < 0) {
-		goto close;
-	}
 
-	client->http1_headers_sent = true;
+	/* read and send file, the headers along with the first chunk */
+	iov[0].iov_base = http_response;
+	iov[0].iov_len = len;
+
+	chunk = http_server_file_buffer(client, &chunk_size);
 
-	/* read and send file */
 	remaining = file_size;
-	while (remaining > 0) {
-		len = fs_read(&file, http_response, sizeof(http_response));
+	do {
+		len = fs_read(&file, chunk, MIN((size_t)remaining, chunk_size));
 		if (len < 0) {
 			LOG_ERR("Filesystem read error (%d)", len);
+			ret = len;
 			goto close;
 		}
 
-		ret = http_server_sendall(client, http_response, len);
+		iov[1].iov_base = chunk;
+		iov[1].iov_len = len;
+
+		ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 		if (ret < 0) {
 			goto close;
 		}
+
+		client->http1_headers_sent = true;
+
+		/* Stop there if the file got shorter */
+		if (len == 0) {
+			break;
+		}
+
 		remaining -= len;
-	}
-	ret = http_server_sendall(client, "\r\n\r\n", 4);
+	} while (remaining > 0);
 
 close:
 	/* close file */
@@ -595,7 +682,7 @@ static int handle_http1_dynamic_resource(
 		return send_http1_405(client);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_hold_resource(dynamic_detail, client)) {
 		ret = send_http1_409(client);
 		if (ret < 0) {
 			return ret;
@@ -604,8 +691,6 @@ static int handle_http1_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_HEAD:
 		if (user_method & BIT(HTTP_HEAD)) {
@@ -616,7 +701,7 @@ static int handle_http1_dynamic_resource(
 			}
 
 			client->http1_headers_sent = true;
-			dynamic_detail->holder = NULL;
+			(void)http_server_release_resource(dynamic_detail, client);
 
 			return 0;
 		}
@@ -908,7 +993,7 @@ int enter_http1_request(struct http_client_ctx *client)
 
 int handle_http1_request(struct http_client_ctx *client)
 {
-	int ret, path_len = 0;
+	int ret;
 	struct http_resource_detail *detail;
 	bool skip_headers = (client->parser_state < HTTP1_RECEIVING_DATA_STATE);
 	size_t parsed;
@@ -971,12 +1056,11 @@ int handle_http1_request(struct http_client_ctx *client)
 		if (client->websocket_upgrade) {
 			if (IS_ENABLED(CONFIG_HTTP_SERVER_WEBSOCKET)) {
 				detail = get_resource_detail(client->service, client->url_buffer,
-							     &path_len, true);
+							     &client->path_len, true);
 				if (detail == NULL) {
 					goto not_found;
 				}
 
-				detail->path_len = path_len;
 				client->current_detail = detail;
 
 				ret = handle_http1_to_websocket_upgrade(client);
@@ -1024,10 +1108,9 @@ upgrade_not_found:
 		}
 	}
 
-	detail = get_resource_detail(client->service, client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->service, client->url_buffer, &client->path_len,
+				     false);
 	if (detail != NULL) {
-		detail->path_len = path_len;
-
 		if (detail->type == HTTP_RESOURCE_TYPE_STATIC) {
 			ret = handle_http1_static_resource(
 				(struct http_resource_detail_static *)detail,
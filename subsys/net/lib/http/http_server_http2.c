@@ -117,7 +117,12 @@ static int add_header_field(struct http_client_ctx *client, uint8_t **buf,
 	client->header_field.value = value;
 	client->header_field.value_len = strlen(value);
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_encode_header_dynamic(&client->hpack_encoder, *buf, *buflen,
+					       &client->header_field);
+#else
 	ret = http_hpack_encode_header(*buf, *buflen, &client->header_field);
+#endif
 	if (ret < 0) {
 		LOG_DBG("Failed to encode header, err %d", ret);
 		return ret;
@@ -158,6 +163,16 @@ static int send_headers_frame(struct http_client_ctx *client, enum http_status s
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	ret = http_hpack_encode_size_update(&client->hpack_encoder, buf, buflen);
+	if (ret < 0) {
+		return ret;
+	}
+
+	buf += ret;
+	buflen -= ret;
+#endif
+
 	ret = add_header_field(client, &buf, &buflen, ":status", status_str);
 	if (ret < 0) {
 		return ret;
@@ -218,6 +233,7 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			   size_t length, uint32_t stream_id, uint8_t flags)
 {
 	uint8_t frame_header[HTTP2_FRAME_HEADER_SIZE];
+	struct iovec iov[2];
 	int ret;
 
 	encode_frame_header(frame_header, length, HTTP2_DATA_FRAME,
@@ -225,16 +241,15 @@ static int send_data_frame(struct http_client_ctx *client, const char *payload,
 			    HTTP2_FLAG_END_STREAM : 0,
 			    stream_id);
 
-	ret = http_server_sendall(client, frame_header, sizeof(frame_header));
+	/* The payload is sent from where it is along with the frame header */
+	iov[0].iov_base = frame_header;
+	iov[0].iov_len = sizeof(frame_header);
+	iov[1].iov_base = (void *)payload;
+	iov[1].iov_len = payload != NULL ? length : 0;
+
+	ret = http_server_sendall_iov(client, iov, ARRAY_SIZE(iov));
 	if (ret < 0) {
 		LOG_DBG("Cannot write to socket (%d)", ret);
-	} else {
-		if (payload != NULL && length > 0) {
-			ret = http_server_sendall(client, payload, length);
-			if (ret < 0) {
-				LOG_DBG("Cannot write to socket (%d)", ret);
-			}
-		}
 	}
 
 	return ret;
@@ -463,13 +478,14 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		.bitmask_of_supported_http_methods =
 			static_fs_detail->common.bitmask_of_supported_http_methods,
 		.content_type = content_type,
-		.path_len = static_fs_detail->common.path_len,
 		.type = static_fs_detail->common.type,
 	};
 	enum http_compression chosen_compression = 0;
+	size_t chunk_size;
+	size_t file_size;
+	size_t remaining;
+	uint8_t *chunk;
 	int len;
-	int remaining;
-	char tmp[64];
 
 	if (client->method != HTTP_GET) {
 		return send_http2_405(client, frame);
@@ -493,10 +509,10 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 
 	/* open file, if it exists */
 #ifdef CONFIG_HTTP_SERVER_COMPRESSION
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len,
+	ret = http_server_find_file(fname, sizeof(fname), &file_size,
 					client->supported_compression, &chosen_compression);
 #else
-	ret = http_server_find_file(fname, sizeof(fname), &client->data_len, 0, NULL);
+	ret = http_server_find_file(fname, sizeof(fname), &file_size, 0, NULL);
 #endif /* CONFIG_HTTP_SERVER_COMPRESSION */
 	if (ret < 0) {
 		LOG_ERR("fs_stat %s: %d", fname, ret);
@@ -528,23 +544,28 @@ static int handle_http2_static_fs_resource(struct http_resource_detail_static_fs
 		goto out;
 	}
 
-	/* read and send file */
-	remaining = client->data_len;
-	while (remaining > 0) {
-		len = fs_read(&file, tmp, sizeof(tmp));
+	/* read and send file, a frame per chunk */
+	chunk = http_server_file_buffer(client, &chunk_size);
+
+	remaining = file_size;
+	do {
+		len = fs_read(&file, chunk, MIN(remaining, chunk_size));
 		if (len < 0) {
 			LOG_ERR("Filesystem read error (%d)", len);
+			ret = len;
 			goto out;
 		}
 
-		remaining -= len;
-		ret = send_data_frame(client, tmp, len, frame->stream_identifier,
+		/* Stop there if the file got shorter */
+		remaining = len > 0 ? remaining - len : 0;
+
+		ret = send_data_frame(client, (const char *)chunk, len, frame->stream_identifier,
 				      (remaining > 0) ? 0 : HTTP2_FLAG_END_STREAM);
 		if (ret < 0) {
 			LOG_DBG("Cannot write to socket (%d)", ret);
 			goto out;
 		}
-	}
+	} while (remaining > 0);
 
 	client->current_stream->end_stream_sent = true;
 
@@ -616,6 +637,57 @@ static int http2_dynamic_response(struct http_client_ctx *client, struct http2_f
 	return 0;
 }
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+/* Initial SETTINGS_MAX_FRAME_SIZE, which the server does not track changes of */
+#define HTTP2_DEFAULT_MAX_FRAME_SIZE 16384
+
+static int http2_send_cached(struct http_client_ctx *client,
+			     struct http_resource_detail_dynamic *dynamic_detail)
+{
+	struct http_resource_cache *cache = dynamic_detail->cache;
+	uint32_t stream_id = client->current_frame.stream_identifier;
+	char etag[HTTP_SERVER_ETAG_LEN];
+	const struct http_header etag_header = {
+		.name = "etag",
+		.value = etag,
+	};
+	const uint8_t *body = cache->buf;
+	size_t remaining = cache->len;
+	size_t len;
+	int ret;
+
+	http_server_cache_etag(cache, etag, sizeof(etag));
+	client->current_stream->end_stream_sent = true;
+
+	if (http_server_cache_not_modified(client, etag)) {
+		return send_headers_frame(client, HTTP_304_NOT_MODIFIED, stream_id, NULL,
+					  HTTP2_FLAG_END_STREAM, &etag_header, 1);
+	}
+
+	ret = send_headers_frame(client, HTTP_200_OK, stream_id,
+				 (struct http_resource_detail *)dynamic_detail,
+				 remaining == 0 ? HTTP2_FLAG_END_STREAM : 0, &etag_header, 1);
+	if (ret < 0) {
+		return ret;
+	}
+
+	while (remaining > 0) {
+		len = MIN(remaining, HTTP2_DEFAULT_MAX_FRAME_SIZE);
+		remaining -= len;
+
+		ret = send_data_frame(client, (const char *)body, len, stream_id,
+				      remaining == 0 ? HTTP2_FLAG_END_STREAM : 0);
+		if (ret < 0) {
+			return ret;
+		}
+
+		body += len;
+	}
+
+	return 0;
+}
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_detail,
 				  struct http_client_ctx *client)
 {
@@ -625,13 +697,30 @@ static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_d
 	enum http_data_status status;
 	struct http_request_ctx request_ctx;
 	struct http_response_ctx response_ctx;
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	struct http_resource_cache *cache;
+#endif
 
 	if (client->current_stream == NULL) {
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	cache = http_server_cache_get(dynamic_detail, client);
+	if (cache != NULL) {
+		if (http_server_cache_is_fresh(cache)) {
+			ret = http2_send_cached(client, dynamic_detail);
+			(void)http_server_release_resource(dynamic_detail, client);
+
+			return ret;
+		}
+
+		http_server_cache_start(cache);
+	}
+#endif
+
 	/* Start of GET params */
-	ptr = &client->url_buffer[dynamic_detail->common.path_len];
+	ptr = &client->url_buffer[client->path_len];
 	len = strlen(ptr);
 	status = HTTP_SERVER_DATA_FINAL;
 
@@ -645,6 +734,12 @@ static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_d
 			return ret;
 		}
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+		if (cache != NULL) {
+			http_server_cache_store(cache, &response_ctx);
+		}
+#endif
+
 		ret = http2_dynamic_response(client, frame, &response_ctx, status, dynamic_detail);
 		if (ret < 0) {
 			return ret;
@@ -654,6 +749,12 @@ static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_d
 		len = 0;
 	} while (!http_response_is_final(&response_ctx, status));
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	if (cache != NULL) {
+		http_server_cache_finish(cache);
+	}
+#endif
+
 	if (!client->current_stream->end_stream_sent) {
 		client->current_stream->end_stream_sent = true;
 		ret = send_data_frame(client, NULL, 0, frame->stream_identifier,
@@ -663,7 +764,7 @@ static int dynamic_get_del_req_v2(struct http_resource_detail_dynamic *dynamic_d
 		}
 	}
 
-	dynamic_detail->holder = NULL;
+	(void)http_server_release_resource(dynamic_detail, client);
 
 	return ret;
 }
@@ -759,7 +860,7 @@ static int dynamic_post_put_req_v2(struct http_resource_detail_dynamic *dynamic_
 		}
 
 		client->current_stream->end_stream_sent = true;
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 	}
 
 	return ret;
@@ -782,7 +883,7 @@ static int handle_http2_dynamic_resource(
 		return send_http2_405(client, frame);
 	}
 
-	if (dynamic_detail->holder != NULL && dynamic_detail->holder != client) {
+	if (!http_server_hold_resource(dynamic_detail, client)) {
 		ret = send_http2_409(client, frame);
 		if (ret < 0) {
 			return ret;
@@ -791,8 +892,6 @@ static int handle_http2_dynamic_resource(
 		return enter_http_done_state(client);
 	}
 
-	dynamic_detail->holder = client;
-
 	switch (client->method) {
 	case HTTP_GET:
 	case HTTP_DELETE:
@@ -1043,7 +1142,6 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 	struct http2_frame *frame = &client->current_frame;
 	struct http_resource_detail *detail;
 	struct http2_stream_ctx *stream;
-	int path_len;
 	int ret;
 
 	/* Create an artificial Data frame, so that we can proceed with HTTP2
@@ -1091,10 +1189,9 @@ int handle_http1_to_http2_upgrade(struct http_client_ctx *client)
 		client->preface_sent = true;
 	}
 
-	detail = get_resource_detail(client->service, client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->service, client->url_buffer, &client->path_len,
+				     false);
 	if (detail != NULL) {
-		detail->path_len = path_len;
-
 		if (detail->type == HTTP_RESOURCE_TYPE_STATIC) {
 			ret = handle_http2_static_resource(
 				(struct http_resource_detail_static *)detail,
@@ -1495,7 +1592,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 		ret = dynamic_detail->cb(client, HTTP_SERVER_DATA_FINAL, &request_ctx,
 					 &response_ctx, dynamic_detail->user_data);
 		if (ret < 0) {
-			dynamic_detail->holder = NULL;
+			(void)http_server_release_resource(dynamic_detail, client);
 			goto out;
 		}
 
@@ -1504,7 +1601,7 @@ static int handle_http_frame_headers_end_stream(struct http_client_ctx *client)
 
 		ret = http2_dynamic_response(client, frame, &response_ctx, HTTP_SERVER_DATA_FINAL,
 					     dynamic_detail);
-		dynamic_detail->holder = NULL;
+		(void)http_server_release_resource(dynamic_detail, client);
 
 		if (ret < 0) {
 			goto out;
@@ -1539,7 +1636,7 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 {
 	struct http2_frame *frame = &client->current_frame;
 	struct http_resource_detail *detail;
-	int ret, path_len;
+	int ret;
 
 	LOG_DBG("HTTP_SERVER_FRAME_HEADERS");
 
@@ -1601,10 +1698,9 @@ int handle_http_frame_headers(struct http_client_ctx *client)
 		return 0;
 	}
 
-	detail = get_resource_detail(client->service, client->url_buffer, &path_len, false);
+	detail = get_resource_detail(client->service, client->url_buffer, &client->path_len,
+				     false);
 	if (detail != NULL) {
-		detail->path_len = path_len;
-
 		if (detail->type == HTTP_RESOURCE_TYPE_STATIC) {
 			ret = handle_http2_static_resource(
 				(struct http_resource_detail_static *)detail,
@@ -1736,6 +1832,20 @@ int handle_http_frame_settings(struct http_client_ctx *client)
 		return -EAGAIN;
 	}
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+	if (!is_header_flag_set(frame->flags, HTTP2_FLAG_SETTINGS_ACK)) {
+		for (size_t i = 0; i + sizeof(struct http2_settings_field) <= frame->length;
+		     i += sizeof(struct http2_settings_field)) {
+			if (sys_get_be16(client->cursor + i) ==
+			    HTTP2_SETTINGS_HEADER_TABLE_SIZE) {
+				http_hpack_encoder_set_max_size(
+					&client->hpack_encoder,
+					sys_get_be32(client->cursor + i + sizeof(uint16_t)));
+			}
+		}
+	}
+#endif
+
 	bytes_consumed = client->current_frame.length;
 	client->data_len -= bytes_consumed;
 	client->cursor += bytes_consumed;
@@ -710,6 +710,172 @@ fail:
 #include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+ssize_t zsock_recv_buf(int sock, struct net_buf **buf, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	ssize_t bytes_received;
+
+	*buf = NULL;
+
+	bytes_received = VTABLE_CALL(recvbuf, sock, buf, flags, src_addr, addrlen);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = vtable->recvmsg(obj, &msgvec[count].msg_hdr,
+				      flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_recv_stats(sock, ret);
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after some messages were received is not reported, the
+	 * next call will run into it again.
+	 */
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	/* Every message needs its buffers copied from and to user memory, so
+	 * only the system call is batched here, not the socket lock.
+	 */
+	for (count = 0; count < vlen; count++) {
+		ret = z_vrfy_zsock_recvmsg(sock, &msgvec[count].msg_hdr,
+					   flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int count;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (count = 0; count < vlen; count++) {
+		ret = vtable->sendmsg(obj, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+		sock_obj_core_update_send_stats(sock, ret);
+	}
+
+	k_mutex_unlock(lock);
+
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int count;
+	ssize_t ret = 0;
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen, sizeof(*msgvec)));
+
+	for (count = 0; count < vlen; count++) {
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[count].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[count].msg_len = ret;
+	}
+
+	if (count == 0 && ret < 0) {
+		return -1;
+	}
+
+	return count;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
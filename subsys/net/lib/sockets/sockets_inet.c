@@ -1077,6 +1077,40 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
+static int sock_get_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+			     struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int ret;
+
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		ret = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
+			return ret;
+		}
+	} else {
+		ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
+		if (ret < 0) {
+			NET_DBG("sock_get_pkt_src_addr %d", ret);
+			return ret;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
 static ssize_t zsock_recv_dgram(struct net_context *ctx,
 				struct msghdr *msg,
 				void *buf,
@@ -1128,37 +1162,11 @@ static ssize_t zsock_recv_dgram(struct net_context *ctx,
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			int ret;
-
-			ret  = sock_get_offload_pkt_src_addr(pkt, ctx, src_addr,
-								*addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_offload_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		} else {
-			int ret;
-
-			ret = sock_get_pkt_src_addr(ctx, pkt, src_addr, *addrlen);
-			if (ret < 0) {
-				errno = -ret;
-				NET_DBG("sock_get_pkt_src_addr %d", ret);
-				goto fail;
-			}
-		}
+		int ret;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			errno = -ret;
 			goto fail;
 		}
 	}
@@ -1530,6 +1538,127 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+/* Hands the data of a received packet, starting at its cursor, over to the
+ * caller. The buffers are detached from the packet rather than copied, the
+ * headers the cursor went past are released with the packet.
+ */
+static struct net_buf *sock_pkt_take_data(struct net_pkt *pkt)
+{
+	struct net_buf *data = pkt->cursor.buf;
+	uint8_t *pos = pkt->cursor.pos;
+	struct net_buf *buf;
+
+	/* The cursor may sit at the very end of a header buffer */
+	if (data != NULL && pos == data->data + data->len) {
+		data = data->frags;
+		pos = (data != NULL) ? data->data : NULL;
+	}
+
+	if (data == NULL || pos == NULL) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	if (data == pkt->buffer) {
+		pkt->buffer = NULL;
+	} else {
+		for (buf = pkt->buffer; buf->frags != data; buf = buf->frags) {
+		}
+
+		buf->frags = NULL;
+	}
+
+	(void)net_buf_pull(data, pos - data->data);
+
+	net_pkt_unref(pkt);
+
+	return data;
+}
+
+static ssize_t zsock_recv_buf_ctx(struct net_context *ctx, struct net_buf **buf,
+				  int flags, struct sockaddr *src_addr,
+				  socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t len;
+	int ret;
+
+	if (flags & (ZSOCK_MSG_PEEK | ZSOCK_MSG_WAITALL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	} else if (sock_type != SOCK_DGRAM && sock_type != SOCK_RAW) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (pkt == NULL) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (src_addr && addrlen && sock_type != SOCK_STREAM) {
+		ret = sock_get_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+		sock_set_eof(ctx);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) ||
+	    IS_ENABLED(CONFIG_TRACING_NET_CORE)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	len = net_pkt_remaining_data(pkt);
+	*buf = sock_pkt_take_data(pkt);
+
+	if (sock_type == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	return len;
+}
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1897,6 +2026,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -2526,6 +2669,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
 
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case TCP_KEEPIDLE:
 			__fallthrough;
 		case TCP_KEEPINTVL:
@@ -3049,6 +3206,12 @@ static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
 	return zsock_recvmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvbuf_vmeth(void *obj, struct net_buf **buf, int flags,
+				  struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	return zsock_recv_buf_ctx(obj, buf, flags, src_addr, addrlen);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -3101,6 +3264,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvmsg = sock_recvmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvbuf = sock_recvbuf_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getpeername = sock_getpeername_vmeth,
@@ -75,6 +75,8 @@ struct socket_op_vtable {
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
+	ssize_t (*recvbuf)(void *obj, struct net_buf **buf, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen);
 };
 
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg);
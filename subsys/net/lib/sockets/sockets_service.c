@@ -10,7 +10,7 @@ LOG_MODULE_REGISTER(net_sock_svc, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/net/socket_service.h>
-#include <zephyr/zvfs/eventfd.h>
+#include <zephyr/zvfs/epoll.h>
 
 static int init_socket_service(void);
 
@@ -28,13 +28,16 @@ static K_CONDVAR_DEFINE(wait_start);
 STRUCT_SECTION_START_EXTERN(net_socket_service_desc);
 STRUCT_SECTION_END_EXTERN(net_socket_service_desc);
 
+/* Events handled per wakeup, the rest stay queued in the epoll instance */
+#define SOCKET_SERVICE_EVENTS 8
+
 static struct service {
-	struct zsock_pollfd events[CONFIG_ZVFS_POLL_MAX];
-	int count;
+	struct zvfs_epoll_event events[SOCKET_SERVICE_EVENTS];
+	/* Service event of each registered fd, protected by the lock */
+	struct net_socket_service_event *fds[CONFIG_ZVFS_OPEN_MAX];
+	int epfd;
 } ctx;
 
-#define get_idx(svc) (*(svc->idx))
-
 void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 {
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
@@ -45,8 +48,19 @@ void net_socket_service_foreach(net_socket_service_cb_t cb, void *user_data)
 static void cleanup_svc_events(const struct net_socket_service_desc *svc)
 {
 	for (int i = 0; i < svc->pev_len; i++) {
-		svc->pev[i].event.fd = -1;
-		svc->pev[i].event.events = 0;
+		struct net_socket_service_event *pev = &svc->pev[i];
+		int fd = pev->event.fd;
+
+		/* The fd might have been closed and reused by another
+		 * service since, so only remove it if it is still ours.
+		 */
+		if (fd >= 0 && fd < ARRAY_SIZE(ctx.fds) && ctx.fds[fd] == pev) {
+			(void)zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_DEL, fd, NULL);
+			ctx.fds[fd] = NULL;
+		}
+
+		pev->event.fd = -1;
+		pev->event.events = 0;
 	}
 }
 
@@ -60,7 +74,9 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 
 	if (thread_status == SOCKET_SERVICE_THREAD_UNINITIALIZED) {
 		(void)k_condvar_wait(&wait_start, &lock, K_FOREVER);
-	} else if (thread_status != SOCKET_SERVICE_THREAD_RUNNING) {
+	}
+
+	if (thread_status != SOCKET_SERVICE_THREAD_RUNNING) {
 		NET_ERR("Socket service thread not running, service %p register fails.", svc);
 		ret = -EIO;
 		goto out;
@@ -83,13 +99,32 @@ int z_impl_net_socket_service_register(const struct net_socket_service_desc *svc
 		}
 
 		for (i = 0; i < len; i++) {
+			struct zvfs_epoll_event ev = {
+				.events = fds[i].events &
+					  (ZVFS_EPOLLIN | ZVFS_EPOLLPRI | ZVFS_EPOLLOUT),
+				.data.fd = fds[i].fd,
+			};
+
 			svc->pev[i].event = fds[i];
 			svc->pev[i].user_data = user_data;
+
+			if (fds[i].fd < 0) {
+				continue;
+			}
+
+			if (zvfs_epoll_ctl(ctx.epfd, ZVFS_EPOLL_CTL_ADD, fds[i].fd, &ev) < 0) {
+				ret = -errno;
+				NET_ERR("Cannot monitor socket %d for service %p (%d)",
+					fds[i].fd, svc, ret);
+				svc->pev[i].event.fd = -1;
+				cleanup_svc_events(svc);
+				goto out;
+			}
+
+			ctx.fds[fds[i].fd] = &svc->pev[i];
 		}
 	}
 
-	/* Tell the thread to re-read the variables */
-	zvfs_eventfd_write(ctx.events[0].fd, 1);
 	ret = 0;
 
 out:
@@ -98,26 +133,9 @@ out:
 	return ret;
 }
 
-static struct net_socket_service_desc *find_svc_and_event(
-	struct zsock_pollfd *pev,
-	struct net_socket_service_event **event)
-{
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int i = 0; i < svc->pev_len; i++) {
-			if (svc->pev[i].event.fd == pev->fd) {
-				*event = &svc->pev[i];
-				return svc;
-			}
-		}
-	}
-
-	return NULL;
-}
-
 /* We do not set the user callback to our work struct because we need to
- * hook into the flow and restore the global poll array so that the next poll
- * round will not notice it and call the callback again while we are
- * servicing the callback.
+ * hook into the flow and hand the callback a copy of the event, so that the
+ * service can be registered again from the callback.
  */
 void net_socket_service_callback(struct net_socket_service_event *pev)
 {
@@ -126,49 +144,38 @@ void net_socket_service_callback(struct net_socket_service_event *pev)
 	ev.callback(&ev);
 }
 
-static int call_work(struct zsock_pollfd *pev, struct net_socket_service_event *event)
+static int trigger_work(struct zvfs_epoll_event *ev)
 {
-	int ret = 0;
-	int fd = pev->fd;
+	struct net_socket_service_event event;
+	int fd = ev->data.fd;
 
-	/* Mark the global fd non pollable so that we do not
-	 * call the callback second time.
-	 */
-	pev->fd = -1;
-
-	/* Synchronous call */
-	net_socket_service_callback(event);
-
-	/* Restore the fd so that new data can be re-triggered */
-	pev->fd = fd;
-
-	return ret;
-}
-
-static int trigger_work(struct zsock_pollfd *pev)
-{
-	struct net_socket_service_event *event;
-	struct net_socket_service_desc *svc;
+	k_mutex_lock(&lock, K_FOREVER);
 
-	svc = find_svc_and_event(pev, &event);
-	if (svc == NULL) {
+	/* The socket might have been unregistered after it was reported */
+	if (ctx.fds[fd] == NULL) {
+		k_mutex_unlock(&lock);
 		return -ENOENT;
 	}
 
-	event->svc = svc;
-
 	/* Copy the triggered event to our event so that we know what
 	 * was actually causing the event.
 	 */
-	event->event = *pev;
+	ctx.fds[fd]->event.revents = ev->events;
+	event = *ctx.fds[fd];
+
+	k_mutex_unlock(&lock);
 
-	return call_work(pev, event);
+	/* Synchronous call, the level-triggered epoll instance reports the
+	 * socket again afterwards if the callback left it ready.
+	 */
+	net_socket_service_callback(&event);
+
+	return 0;
 }
 
 static void socket_service_thread(void)
 {
-	int ret, i, fd, count = 0;
-	zvfs_eventfd_t value;
+	int ret, count = 0;
 
 	STRUCT_SECTION_COUNT(net_socket_service_desc, &ret);
 	if (ret == 0) {
@@ -176,103 +183,65 @@ static void socket_service_thread(void)
 		goto fail;
 	}
 
-	/* Create contiguous poll event array to enable socket polling */
 	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
 		NET_DBG("Service %s has %d pollable sockets",
 			COND_CODE_1(CONFIG_NET_SOCKETS_LOG_LEVEL_DBG,
 				    (svc->owner), ("")),
 			svc->pev_len);
-		get_idx(svc) = count + 1;
-		count += svc->pev_len;
-	}
 
-	if ((count + 1) > ARRAY_SIZE(ctx.events)) {
-		NET_ERR("You have %d services to monitor but "
-			"%zd poll entries configured.",
-			count + 1, ARRAY_SIZE(ctx.events));
-		NET_ERR("Please increase value of %s to at least %d",
-			"CONFIG_ZVFS_POLL_MAX", count + 1);
-		goto fail;
-	}
+		for (int i = 0; i < svc->pev_len; i++) {
+			svc->pev[i].svc = svc;
+		}
 
-	NET_DBG("Monitoring %d socket entries", count);
+		count += svc->pev_len;
+	}
 
-	ctx.count = count + 1;
+	NET_DBG("Monitoring up to %d socket entries", count);
 
-	/* Create an zvfs_eventfd that can be used to trigger events during polling */
-	fd = zvfs_eventfd(0, 0);
-	if (fd < 0) {
-		fd = -errno;
-		NET_ERR("zvfs_eventfd failed (%d)", fd);
-		goto out;
+	/* The sockets are added to the epoll instance when registered, so
+	 * that waiting does not depend on the number of monitored sockets.
+	 */
+	ctx.epfd = zvfs_epoll_create();
+	if (ctx.epfd < 0) {
+		NET_ERR("zvfs_epoll_create failed (%d)", -errno);
+		goto fail;
 	}
 
+	k_mutex_lock(&lock, K_FOREVER);
 	thread_status = SOCKET_SERVICE_THREAD_RUNNING;
 	k_condvar_broadcast(&wait_start);
-
-	ctx.events[0].fd = fd;
-	ctx.events[0].events = ZSOCK_POLLIN;
-
-restart:
-	i = 1;
-
-	k_mutex_lock(&lock, K_FOREVER);
-
-	/* Copy individual events to the big array */
-	STRUCT_SECTION_FOREACH(net_socket_service_desc, svc) {
-		for (int j = 0; j < svc->pev_len; j++) {
-			ctx.events[get_idx(svc) + j] = svc->pev[j].event;
-		}
-	}
-
 	k_mutex_unlock(&lock);
 
 	while (true) {
-		ret = zsock_poll(ctx.events, count + 1, -1);
+		ret = zvfs_epoll_wait(ctx.epfd, ctx.events, ARRAY_SIZE(ctx.events), -1);
 		if (ret < 0) {
 			ret = -errno;
-			NET_ERR("poll failed (%d)", ret);
+			NET_ERR("epoll wait failed (%d)", ret);
 			goto out;
 		}
 
-		if (ret == 0) {
-			/* should not happen because timeout is -1 */
-			break;
-		}
-
 		/* Process work here */
-		for (i = 1; i < (count + 1); i++) {
-			if (ctx.events[i].fd < 0) {
-				continue;
+		for (int i = 0; i < ret; i++) {
+			if (trigger_work(&ctx.events[i]) < 0) {
+				NET_DBG("Socket %d no longer monitored",
+					ctx.events[i].data.fd);
 			}
-
-			if (ctx.events[i].revents > 0) {
-				ret = trigger_work(&ctx.events[i]);
-				if (ret < 0) {
-					NET_DBG("Triggering work failed (%d)", ret);
-					goto restart;
-				}
-			}
-		}
-
-		/* Relocate after trigger work so the work gets done before restarting */
-		if (ret > 0 && ctx.events[0].revents) {
-			zvfs_eventfd_read(ctx.events[0].fd, &value);
-			ctx.events[0].revents = 0;
-			NET_DBG("Received restart event.");
-			goto restart;
 		}
 	}
 
 out:
 	NET_DBG("Socket service thread stopped");
+	k_mutex_lock(&lock, K_FOREVER);
 	thread_status = SOCKET_SERVICE_THREAD_STOPPED;
+	k_mutex_unlock(&lock);
 
 	return;
 
 fail:
+	k_mutex_lock(&lock, K_FOREVER);
 	thread_status = SOCKET_SERVICE_THREAD_FAILED;
 	k_condvar_broadcast(&wait_start);
+	k_mutex_unlock(&lock);
 }
 
 static int init_socket_service(void)
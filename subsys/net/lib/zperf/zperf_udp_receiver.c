@@ -36,6 +36,7 @@ static struct sockaddr_in *in4_addr_my;
 #define SOCK_ID_MAX 2
 
 #define UDP_RECEIVER_BUF_SIZE 1500
+#define UDP_RECEIVER_BATCH CONFIG_NET_ZPERF_UDP_RX_BATCH
 #define POLL_TIMEOUT_MS 100
 
 static zperf_callback udp_session_cb;
@@ -314,12 +315,13 @@ static void udp_receiver_cleanup(void)
 
 static int udp_recv_data(struct net_socket_service_event *pev)
 {
-	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	static uint8_t buf[UDP_RECEIVER_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addr[UDP_RECEIVER_BATCH];
+	static struct iovec iov[UDP_RECEIVER_BATCH];
+	static struct mmsghdr msgvec[UDP_RECEIVER_BATCH];
 	int ret = 1;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -342,8 +344,19 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 	}
 
 	while (ret > 0) {
-		ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
-				     &addr, &addrlen);
+		for (int i = 0; i < UDP_RECEIVER_BATCH; i++) {
+			iov[i].iov_base = buf[i];
+			iov[i].iov_len = sizeof(buf[i]);
+			msgvec[i].msg_hdr = (struct msghdr) {
+				.msg_name = &addr[i],
+				.msg_namelen = sizeof(addr[i]),
+				.msg_iov = &iov[i],
+				.msg_iovlen = 1,
+			};
+		}
+
+		ret = zsock_recvmmsg(pev->event.fd, msgvec, UDP_RECEIVER_BATCH,
+				     ZSOCK_MSG_DONTWAIT);
 		if ((ret < 0) && (errno == EAGAIN)) {
 			ret = 0;
 			break;
@@ -358,7 +371,9 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 			goto error;
 		}
 
-		udp_received(pev->event.fd, &addr, buf, ret);
+		for (int i = 0; i < ret; i++) {
+			udp_received(pev->event.fd, &addr[i], buf[i], msgvec[i].msg_len);
+		}
 	}
 	return ret;
 
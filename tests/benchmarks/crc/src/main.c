@@ -0,0 +1,119 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to
+ * compute the CRC32-IEEE, CRC32C and CRC16-CCITT of buffers of various sizes.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+
+#define MAX_SIZE 4096
+
+static const unsigned int sizes[] = {64, 512, MAX_SIZE};
+
+/* Start one byte past an aligned address to include the unaligned head */
+static uint8_t buf[MAX_SIZE + 1] __aligned(8);
+static const uint8_t *const data = &buf[1];
+
+static volatile uint32_t sink;
+
+static void report(const char *tag, const char *str, unsigned int size, uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	uint32_t ns = (uint32_t)timing_cycles_to_ns(average);
+	char description[64];
+
+	/* bytes per microsecond is MB/s */
+	snprintk(description, sizeof(description), "%s (%u bytes, %u MB/s)", str, size,
+		 (ns != 0) ? (uint32_t)((uint64_t)size * 1000U / ns) : 0U);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: crc.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag, size,
+	       (int)(12 - strlen(tag)), "", description, average, ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average, ns);
+#endif
+}
+
+static void measure(unsigned int size)
+{
+	uint64_t ieee_cycles = 0;
+	uint64_t c_cycles = 0;
+	uint64_t ccitt_cycles = 0;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		sink = crc32_ieee(data, size);
+		finish = timing_counter_get();
+		ieee_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		sink = crc32_c(0, data, size, true, true);
+		finish = timing_counter_get();
+		c_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		sink = crc16_ccitt(0xffff, data, size);
+		finish = timing_counter_get();
+		ccitt_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	report("crc32_ieee", "crc32_ieee()", size, ieee_cycles);
+	report("crc32_c", "crc32_c()", size, c_cycles);
+	report("crc16_ccitt", "crc16_ccitt()", size, ccitt_cycles);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for CRC computations (%s%s)\n",
+	       IS_ENABLED(CONFIG_CRC_TABLE_SLICE_BY_8)   ? "slice-by-8"
+	       : IS_ENABLED(CONFIG_CRC_TABLE_SLICE_BY_4) ? "slice-by-4"
+							 : "nibble",
+	       IS_ENABLED(CONFIG_CRC_HW_INSTRUCTIONS) ? ", hardware" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	for (unsigned int i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 151U + 7U);
+	}
+
+	/* check value of the CRC32 catalogue, fails if an engine is broken */
+	if (crc32_ieee((const uint8_t *)"123456789", 9) != 0xcbf43926U) {
+		printk("crc32_ieee() returned a wrong result\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		measure(sizes[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
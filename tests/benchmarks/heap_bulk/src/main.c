@@ -0,0 +1,152 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to
+ * allocate and free a batch of equally sized blocks from a k_heap, either one
+ * block at a time or with the bulk API.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+#define BLOCK_SIZE     64
+#define MAX_BATCH_SIZE 64
+
+/* Blocks used to fragment the heap before measuring */
+#define NUM_FILLERS    64
+
+K_HEAP_DEFINE(heap, CONFIG_BENCHMARK_HEAP_SIZE);
+
+static void *blocks[MAX_BATCH_SIZE];
+static void *fillers[NUM_FILLERS];
+
+static const unsigned int batch_sizes[] = {4, 16, MAX_BATCH_SIZE};
+
+static bool failed;
+
+/* Leaves every other one of a series of variously sized blocks allocated */
+static void fragment_heap(void)
+{
+	for (unsigned int i = 0; i < NUM_FILLERS; i++) {
+		fillers[i] = k_heap_alloc(&heap, 16 + (i % 8) * 24, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < NUM_FILLERS; i += 2) {
+		k_heap_free(&heap, fillers[i]);
+		fillers[i] = NULL;
+	}
+}
+
+static void report(const char *tag, const char *str, unsigned int batch_size,
+		   uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u blocks)", str, batch_size);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: heap.%s.%02u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag,
+	       batch_size, (int)(24 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure(unsigned int batch_size)
+{
+	uint64_t alloc_cycles = 0;
+	uint64_t free_cycles = 0;
+	uint64_t alloc_bulk_cycles = 0;
+	uint64_t free_bulk_cycles = 0;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		for (unsigned int j = 0; j < batch_size; j++) {
+			blocks[j] = k_heap_alloc(&heap, BLOCK_SIZE, K_NO_WAIT);
+		}
+		finish = timing_counter_get();
+		alloc_cycles += timing_cycles_get(&start, &finish);
+
+		for (unsigned int j = 0; j < batch_size; j++) {
+			failed |= (blocks[j] == NULL);
+		}
+
+		start = timing_counter_get();
+		for (unsigned int j = 0; j < batch_size; j++) {
+			k_heap_free(&heap, blocks[j]);
+		}
+		finish = timing_counter_get();
+		free_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		int ret = k_heap_alloc_bulk(&heap, BLOCK_SIZE, blocks, batch_size, K_NO_WAIT);
+
+		finish = timing_counter_get();
+		alloc_bulk_cycles += timing_cycles_get(&start, &finish);
+
+		if (ret != 0) {
+			failed = true;
+			continue;
+		}
+
+		start = timing_counter_get();
+		k_heap_free_bulk(&heap, blocks, batch_size);
+		finish = timing_counter_get();
+		free_bulk_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	report("alloc", "Allocate block by block", batch_size, alloc_cycles);
+	report("alloc_bulk", "Allocate in bulk", batch_size, alloc_bulk_cycles);
+	report("free", "Free block by block", batch_size, free_cycles);
+	report("free_bulk", "Free in bulk", batch_size, free_bulk_cycles);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for k_heap bulk allocations%s\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES) ? " (size classes)" : "");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	fragment_heap();
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		measure(batch_sizes[i]);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("Some allocations failed, heap too small\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
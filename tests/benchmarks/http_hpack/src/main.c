@@ -0,0 +1,259 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to
+ * encode the HTTP/2 header block of a response with HPACK, and its size,
+ * with and without the dynamic table, and the length of time required to
+ * decode the header block of a request.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/http/hpack.h>
+#include <string.h>
+
+struct field {
+	const char *name;
+	const char *value;
+};
+
+/* The content length, with no value here, changes with every response. */
+static const struct field response_fields[] = {
+	{ ":status", "200" },
+	{ "content-type", "text/html" },
+	{ "content-encoding", "gzip" },
+	{ "cache-control", "max-age=3600" },
+	{ "access-control-allow-origin", "*" },
+	{ "server", "Zephyr" },
+	{ "content-length", NULL },
+};
+
+static const struct field request_fields[] = {
+	{ ":method", "GET" },
+	{ ":scheme", "https" },
+	{ ":authority", "192.0.2.1:8443" },
+	{ ":path", "/api/v1/items/42?fields=name,price" },
+	{ "user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0" },
+	{ "accept", "text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8" },
+	{ "accept-language", "en-US,en;q=0.5" },
+	{ "accept-encoding", "gzip, deflate, br, zstd" },
+};
+
+static struct http_hpack_header_buf header;
+static struct http_hpack_encoder encoder;
+static uint8_t block[512];
+
+static uint32_t seed = 1;
+
+static bool failed;
+
+static uint32_t next_random(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void report(const char *tag, const char *str, uint64_t cycles, uint64_t bytes)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u bytes)", str,
+		 (uint32_t)(bytes / CONFIG_BENCHMARK_NUM_ITERATIONS));
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: http.hpack.%s.avg%-*s - %-50s : %7llu cycles , %7u ns :\n",
+	       tag, (int)(16 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static int encode_field(bool dynamic, const char *name, const char *value,
+			uint8_t *buf, size_t buflen)
+{
+	header.name = name;
+	header.name_len = strlen(name);
+	header.value = value;
+	header.value_len = strlen(value);
+
+	if (dynamic) {
+		return http_hpack_encode_header_dynamic(&encoder, buf, buflen, &header);
+	}
+
+	return http_hpack_encode_header(buf, buflen, &header);
+}
+
+static int encode_response(bool dynamic, const char *content_length)
+{
+	int ret, len = 0;
+
+	if (dynamic) {
+		ret = http_hpack_encode_size_update(&encoder, block, sizeof(block));
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	}
+
+	ARRAY_FOR_EACH(response_fields, i) {
+		const char *value = response_fields[i].value;
+
+		ret = encode_field(dynamic, response_fields[i].name,
+				   value != NULL ? value : content_length,
+				   block + len, sizeof(block) - len);
+		if (ret < 0) {
+			return ret;
+		}
+
+		len += ret;
+	}
+
+	return len;
+}
+
+static void measure_encode(const char *tag, const char *str, bool dynamic)
+{
+	char content_length[sizeof("65535")];
+	uint64_t cycles = 0;
+	uint64_t bytes = 0;
+	timing_t start;
+	timing_t finish;
+	int ret;
+
+	/* A new connection */
+	http_hpack_encoder_init(&encoder);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		snprintk(content_length, sizeof(content_length), "%u",
+			 next_random() % 65536);
+
+		start = timing_counter_get();
+		ret = encode_response(dynamic, content_length);
+		finish = timing_counter_get();
+
+		if (ret < 0) {
+			failed = true;
+			return;
+		}
+
+		cycles += timing_cycles_get(&start, &finish);
+		bytes += ret;
+	}
+
+	report(tag, str, cycles, bytes);
+}
+
+static int decode_request(size_t len, bool check)
+{
+	size_t count = 0;
+	size_t offset = 0;
+	int ret;
+
+	while (offset < len) {
+		ret = http_hpack_decode_header(block + offset, len - offset, &header);
+		if (ret <= 0) {
+			return -EBADMSG;
+		}
+
+		if (check &&
+		    (count >= ARRAY_SIZE(request_fields) ||
+		     header.value_len != strlen(request_fields[count].value) ||
+		     memcmp(header.value, request_fields[count].value, header.value_len) != 0)) {
+			return -EBADMSG;
+		}
+
+		offset += ret;
+		count++;
+	}
+
+	return count == ARRAY_SIZE(request_fields) ? 0 : -EBADMSG;
+}
+
+static void measure_decode(const char *tag, const char *str)
+{
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+	int ret, len = 0;
+
+	/* Literal fields with Huffman coded values, like web browsers send
+	 * on a new connection.
+	 */
+	ARRAY_FOR_EACH(request_fields, i) {
+		ret = encode_field(false, request_fields[i].name, request_fields[i].value,
+				   block + len, sizeof(block) - len);
+		if (ret < 0) {
+			failed = true;
+			return;
+		}
+
+		len += ret;
+	}
+
+	if (decode_request(len, true) < 0) {
+		failed = true;
+		return;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		ret = decode_request(len, false);
+		finish = timing_counter_get();
+
+		if (ret < 0) {
+			failed = true;
+			return;
+		}
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	report(tag, str, cycles, (uint64_t)len * CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for HTTP/2 header compression (%d bytes dynamic table)\n",
+	       CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE_SIZE);
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	measure_encode("encode.static", "Response headers, static table", false);
+	measure_encode("encode.dynamic", "Response headers, dynamic table", true);
+	measure_decode("decode.huffman", "Request headers, Huffman coded");
+
+	timing_stop();
+
+	if (failed) {
+		printk("A header block could not be encoded or decoded\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
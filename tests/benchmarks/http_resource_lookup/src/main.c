@@ -0,0 +1,150 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by the
+ * HTTP server to find the resource of a request path, depending on the
+ * number of resources of the service.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <string.h>
+
+extern struct http_resource_detail *get_resource_detail(const struct http_service_desc *service,
+							const char *path,
+							int *path_len,
+							bool is_websocket);
+
+static struct http_resource_detail item_detail = {
+	.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+static struct http_resource_detail static_detail = {
+	.type = HTTP_RESOURCE_TYPE_STATIC_FS,
+	.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+};
+
+#define ITEM_RESOURCE_DEFINE(n, _service)                                                          \
+	HTTP_RESOURCE_DEFINE(_service##_item_##n, _service, "/api/v1/items/" STRINGIFY(n),         \
+			     &item_detail)
+
+#define BENCH_SERVICE_DEFINE(_service, _count)                                                     \
+	static uint16_t _service##_port = 8080;                                                    \
+	HTTP_SERVICE_DEFINE(_service, NULL, &_service##_port, 1, 1, NULL, NULL);                   \
+	LISTIFY(_count, ITEM_RESOURCE_DEFINE, (;), _service);                                      \
+	HTTP_RESOURCE_DEFINE(_service##_static, _service, "/static/*", &static_detail)
+
+BENCH_SERVICE_DEFINE(bench_service_16, 16);
+BENCH_SERVICE_DEFINE(bench_service_64, 64);
+BENCH_SERVICE_DEFINE(bench_service_256, 256);
+
+static const struct {
+	const struct http_service_desc *service;
+	unsigned int count;
+} services[] = {
+	{&bench_service_16, 16},
+	{&bench_service_64, 64},
+	{&bench_service_256, 256},
+};
+
+static uint32_t seed = 1;
+
+static bool failed;
+
+static uint32_t next_random(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void report(const char *tag, const char *str, unsigned int count, uint64_t cycles,
+		   unsigned int lookups)
+{
+	uint64_t average = cycles / lookups;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u resources)", str, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: http.resource.lookup.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n",
+	       tag, count, (int)(8 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure(const char *tag, const char *str, unsigned int index, bool hit)
+{
+	const struct http_service_desc *service = services[index].service;
+	unsigned int count = services[index].count;
+	struct http_resource_detail *detail;
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+	char path[32];
+	int path_len;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		unsigned int n = next_random() % count;
+
+		snprintk(path, sizeof(path), "/api/v1/%s/%u?id=%u", hit ? "items" : "users", n, i);
+
+		start = timing_counter_get();
+		detail = get_resource_detail(service, path, &path_len, false);
+		finish = timing_counter_get();
+		cycles += timing_cycles_get(&start, &finish);
+
+		failed |= (detail != (hit ? &item_detail : NULL));
+	}
+
+	report(tag, str, count, cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for HTTP resource lookups (%s)\n",
+	       IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_TRIE) ? "trie" : "linear scan");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(services); i++) {
+		measure("hit", "Path of a resource", i, true);
+		measure("miss", "Path of no resource", i, false);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("A resource lookup returned the wrong resource\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
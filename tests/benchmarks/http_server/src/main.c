@@ -0,0 +1,242 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the time required by the HTTP server
+ * to answer the requests of several concurrent clients over the loopback
+ * interface, when the resource handlers take some time.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/http/server.h>
+#include <zephyr/net/http/service.h>
+#include <string.h>
+
+#define SERVER_PORT 8080
+#define CLIENT_STACK_SIZE 2048
+#define FINAL_CHUNK "0\r\n\r\n"
+
+static uint16_t bench_http_service_port = SERVER_PORT;
+
+HTTP_SERVICE_DEFINE(bench_http_service, "127.0.0.1", &bench_http_service_port,
+		    CONFIG_HTTP_SERVER_MAX_CLIENTS, 10, NULL, NULL);
+
+static int slow_cb(struct http_client_ctx *client, enum http_data_status status,
+		   const struct http_request_ctx *request_ctx,
+		   struct http_response_ctx *response_ctx, void *user_data)
+{
+	static const uint8_t body[] = "ok";
+
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	k_msleep(CONFIG_BENCHMARK_HANDLER_DELAY);
+
+	response_ctx->body = body;
+	response_ctx->body_len = sizeof(body) - 1;
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+/* A dynamic resource only serves one client at a time, so that every client
+ * gets its own.
+ */
+#define SLOW_RESOURCE_DEFINE(n)                                                                    \
+	static struct http_resource_detail_dynamic slow_detail_##n = {                             \
+		.common = {                                                                        \
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,                                        \
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),                        \
+			.content_type = "text/plain",                                              \
+		},                                                                                 \
+		.cb = slow_cb,                                                                     \
+	};                                                                                         \
+	HTTP_RESOURCE_DEFINE(slow_resource_##n, bench_http_service, "/slow_" #n,                   \
+			     &slow_detail_##n)
+
+SLOW_RESOURCE_DEFINE(0);
+SLOW_RESOURCE_DEFINE(1);
+SLOW_RESOURCE_DEFINE(2);
+SLOW_RESOURCE_DEFINE(3);
+
+K_THREAD_STACK_ARRAY_DEFINE(client_stacks, CONFIG_BENCHMARK_CLIENTS, CLIENT_STACK_SIZE);
+static struct k_thread client_threads[CONFIG_BENCHMARK_CLIENTS];
+static K_SEM_DEFINE(done_sem, 0, CONFIG_BENCHMARK_CLIENTS);
+
+static bool failed;
+
+static int send_all(int sock, const char *buf, size_t len)
+{
+	ssize_t sent;
+
+	while (len > 0) {
+		sent = zsock_send(sock, buf, len, 0);
+		if (sent < 0) {
+			return -errno;
+		}
+
+		buf += sent;
+		len -= sent;
+	}
+
+	return 0;
+}
+
+/* Reads a chunked response until its final chunk */
+static int recv_response(int sock)
+{
+	char buf[256];
+	size_t total = 0;
+	ssize_t recved;
+
+	while (total < sizeof(buf)) {
+		recved = zsock_recv(sock, buf + total, sizeof(buf) - total, 0);
+		if (recved <= 0) {
+			return -EIO;
+		}
+
+		total += recved;
+
+		if (total >= sizeof(FINAL_CHUNK) - 1 &&
+		    memcmp(buf + total - (sizeof(FINAL_CHUNK) - 1), FINAL_CHUNK,
+			   sizeof(FINAL_CHUNK) - 1) == 0) {
+			return strncmp(buf, "HTTP/1.1 200", strlen("HTTP/1.1 200")) == 0 ? 0 : -EIO;
+		}
+	}
+
+	return -ENOBUFS;
+}
+
+static void client_entry(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	int id = POINTER_TO_INT(p1);
+	char request[64];
+	int len;
+	int sock;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	len = snprintk(request, sizeof(request),
+		       "GET /slow_%d HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n", id);
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		failed = true;
+		goto out;
+	}
+
+	if (zsock_connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		failed = true;
+		goto out;
+	}
+
+	for (int i = 0; i < CONFIG_BENCHMARK_REQUESTS; i++) {
+		if (send_all(sock, request, len) < 0 || recv_response(sock) < 0) {
+			failed = true;
+			break;
+		}
+	}
+
+out:
+	if (sock >= 0) {
+		(void)zsock_close(sock);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void report(uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint32_t requests = CONFIG_BENCHMARK_CLIENTS * CONFIG_BENCHMARK_REQUESTS;
+	uint32_t rate = (uint32_t)((uint64_t)requests * NSEC_PER_SEC / MAX(ns, 1));
+	char description[64];
+
+	snprintk(description, sizeof(description), "%u requests (%u req/s)", requests, rate);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: http.server.workers_%d.requests - %-50s : %7llu cycles , %7llu ns :\n",
+	       CONFIG_HTTP_SERVER_NUM_WORKERS, description, cycles, ns);
+#else
+	printk("%-50s: %7llu cycles (%7llu nsec)\n", description, cycles, ns);
+#endif
+}
+
+int main(void)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for HTTP requests of %d clients (%d workers, %d ms handlers)\n",
+	       CONFIG_BENCHMARK_CLIENTS, CONFIG_HTTP_SERVER_NUM_WORKERS,
+	       CONFIG_BENCHMARK_HANDLER_DELAY);
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	if (http_server_start() < 0) {
+		printk("Cannot start the HTTP server\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	/* Let the server thread set up the listening socket */
+	k_msleep(100);
+
+	timing_start();
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < CONFIG_BENCHMARK_CLIENTS; i++) {
+		k_thread_create(&client_threads[i], client_stacks[i],
+				K_THREAD_STACK_SIZEOF(client_stacks[i]), client_entry,
+				INT_TO_POINTER(i), NULL, NULL,
+				k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < CONFIG_BENCHMARK_CLIENTS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	report(timing_cycles_get(&start, &finish));
+
+	timing_stop();
+
+	(void)http_server_stop();
+
+	if (failed) {
+		printk("The responses were not received correctly\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by
+ * json_obj_parse() to decode an object with many fields, depending on the
+ * order in which its keys appear in the document.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/data/json.h>
+#include <string.h>
+
+#define FIELDS(X)                                                                                  \
+	X(id) X(name) X(type) X(value) X(unit) X(timestamp) X(min) X(max) X(avg) X(count)          \
+	X(status) X(error) X(version) X(serial) X(model) X(vendor) X(uptime) X(rssi) X(snr)        \
+	X(channel) X(battery) X(voltage) X(current) X(power) X(energy) X(temperature)              \
+	X(humidity) X(pressure) X(latitude) X(longitude) X(altitude) X(speed) X(heading)           \
+	X(accuracy) X(interval) X(timeout) X(retries) X(state) X(mode) X(level) X(threshold)       \
+	X(hysteresis) X(offset) X(gain) X(period) X(duty) X(enabled) X(flags)
+
+#define FIELD_MEMBER(name) int name;
+#define FIELD_DESCR(name)  JSON_OBJ_DESCR_PRIM(struct record, name, JSON_TOK_NUMBER),
+#define FIELD_NAME(name)   #name,
+
+struct record {
+	FIELDS(FIELD_MEMBER)
+};
+
+static const struct json_obj_descr record_descr[] = {
+	FIELDS(FIELD_DESCR)
+};
+
+static const char *const field_names[] = {
+	FIELDS(FIELD_NAME)
+};
+
+#define NUM_FIELDS ARRAY_SIZE(record_descr)
+
+static char document[1024];
+static char scratch[sizeof(document)];
+static size_t document_len;
+
+static struct record rec;
+
+static bool failed;
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: json.decode.%s.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag,
+	       (int)(12 - strlen(tag)), "", str, average, (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", str, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+/* Writes the object with its keys in the order given by field(i) */
+static void build_document(size_t (*field)(size_t i))
+{
+	size_t len = 0;
+
+	document[len++] = '{';
+	for (size_t i = 0; i < NUM_FIELDS; i++) {
+		size_t f = field(i);
+
+		len += snprintk(&document[len], sizeof(document) - len, "%s\"%s\":%u",
+				(i > 0) ? "," : "", field_names[f], (unsigned int)f);
+	}
+	document[len++] = '}';
+	document_len = len;
+}
+
+static size_t in_order(size_t i)
+{
+	return i;
+}
+
+static size_t reversed(size_t i)
+{
+	return NUM_FIELDS - 1 - i;
+}
+
+static size_t shuffled(size_t i)
+{
+	/* 7 and the number of fields are coprime, so this is a permutation */
+	return (i * 7) % NUM_FIELDS;
+}
+
+static void measure(const char *tag, const char *str, size_t (*field)(size_t i))
+{
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+	int64_t ret;
+
+	build_document(field);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		/* json_obj_parse() may modify the document */
+		memcpy(scratch, document, document_len);
+
+		start = timing_counter_get();
+		ret = json_obj_parse(scratch, document_len, record_descr, NUM_FIELDS, &rec);
+		finish = timing_counter_get();
+		cycles += timing_cycles_get(&start, &finish);
+
+		failed |= (ret != (int64_t)BIT64_MASK(NUM_FIELDS));
+	}
+
+	failed |= (rec.flags != NUM_FIELDS - 1);
+
+	report(tag, str, cycles);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for decoding a %u field JSON object\n",
+	       (unsigned int)NUM_FIELDS);
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	measure("in_order", "Keys in descriptor order", in_order);
+	measure("reversed", "Keys in reverse order", reversed);
+	measure("shuffled", "Keys shuffled", shuffled);
+
+	timing_stop();
+
+	if (failed) {
+		printk("Some fields were not decoded\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
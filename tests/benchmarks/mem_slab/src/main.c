@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This benchmark has a cooperative worker thread on every CPU but one
+ * allocate a burst of blocks from a memory slab shared by all of them and
+ * free them again, as fast as it can. The main thread periodically reports
+ * how many blocks each worker allocated and freed, which highlights how much
+ * the CPUs contend on the memory slab.
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#if CONFIG_MP_MAX_NUM_CPUS <= 1
+#error "Test requires a system with more than 1 CPU"
+#endif
+
+#define NUM_WORK_THREADS (CONFIG_MP_MAX_NUM_CPUS - 1)
+#define WORK_STACK_SIZE  4096
+
+#define BLOCK_SIZE 64
+
+BUILD_ASSERT(CONFIG_BENCHMARK_NUM_BLOCKS >= NUM_WORK_THREADS * CONFIG_BENCHMARK_BURST_SIZE);
+
+K_MEM_SLAB_DEFINE_STATIC(slab, BLOCK_SIZE, CONFIG_BENCHMARK_NUM_BLOCKS, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(work_stack, NUM_WORK_THREADS, WORK_STACK_SIZE);
+
+static struct k_thread work_thread[NUM_WORK_THREADS];
+static volatile unsigned long work_counter[NUM_WORK_THREADS];
+static volatile unsigned long work_failures;
+
+static void work_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int index = POINTER_TO_UINT(p1);
+	void *blocks[CONFIG_BENCHMARK_BURST_SIZE];
+	unsigned int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		for (i = 0; i < CONFIG_BENCHMARK_BURST_SIZE; i++) {
+			if (k_mem_slab_alloc(&slab, &blocks[i], K_NO_WAIT) != 0) {
+				work_failures++;
+				break;
+			}
+		}
+
+		while (i > 0) {
+			i--;
+			k_mem_slab_free(&slab, blocks[i]);
+			work_counter[index]++;
+		}
+	}
+}
+
+static void report(void)
+{
+	unsigned int elapsed_time = CONFIG_BENCHMARK_INTERVAL_DURATION;
+	unsigned int i;
+	unsigned long total;
+	unsigned long counter[NUM_WORK_THREADS];
+	unsigned long last_counter[NUM_WORK_THREADS] = {};
+
+	while (1) {
+		k_sleep(K_SECONDS(CONFIG_BENCHMARK_INTERVAL_DURATION));
+
+		total = 0;
+
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			counter[i] = work_counter[i] - last_counter[i];
+			total += counter[i];
+			last_counter[i] = work_counter[i];
+		}
+
+		printf("**** Mem-Slab %s Test **** Elapsed Time: %u\n",
+		       IS_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE) ? "CPU Cache" : "Locked",
+		       elapsed_time);
+
+		printf("  Total Alloc/Free Pairs: %lu\n", total);
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			printf("   - Worker #%u: %lu\n", i, counter[i]);
+		}
+		printf("  Allocation Failures: %lu\n", work_failures);
+
+		elapsed_time += CONFIG_BENCHMARK_INTERVAL_DURATION;
+	}
+}
+
+int main(void)
+{
+	for (unsigned int i = 0; i < NUM_WORK_THREADS; i++) {
+		k_thread_create(&work_thread[i], work_stack[i],
+				WORK_STACK_SIZE, work_entry,
+				UINT_TO_POINTER(i), NULL, NULL,
+				-1, 0, K_NO_WAIT);
+	}
+
+	report();
+
+	return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This benchmark has pairs of cooperative threads, one per CPU but one,
+ * wake each other up through k_poll() as fast as they can. Every pair
+ * uses its own kernel objects, so any contention between the pairs comes
+ * from the locks of the poll subsystem and of the scheduler. The main
+ * thread periodically reports how many wakeups each pair completed.
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#if CONFIG_MP_MAX_NUM_CPUS <= 1
+#error "Test requires a system with more than 1 CPU"
+#endif
+
+#define NUM_PAIRS       (CONFIG_MP_MAX_NUM_CPUS - 1)
+#define NUM_EVENTS      (CONFIG_BENCHMARK_IDLE_EVENTS + 2)
+#define WORK_STACK_SIZE 4096
+
+static K_THREAD_STACK_ARRAY_DEFINE(poller_stack, NUM_PAIRS, WORK_STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(signaler_stack, NUM_PAIRS, WORK_STACK_SIZE);
+
+static struct k_thread poller_thread[NUM_PAIRS];
+static struct k_thread signaler_thread[NUM_PAIRS];
+
+static struct k_sem data_sem[NUM_PAIRS];
+static struct k_sem ack_sem[NUM_PAIRS];
+static struct k_sem idle_sem[NUM_PAIRS][CONFIG_BENCHMARK_IDLE_EVENTS];
+static struct k_poll_signal poll_signal[NUM_PAIRS];
+static struct k_poll_event events[NUM_PAIRS][NUM_EVENTS];
+
+static volatile unsigned long work_counter[NUM_PAIRS];
+
+static void poller_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int index = POINTER_TO_UINT(p1);
+	struct k_poll_event *ev = events[index];
+	unsigned int signaled;
+	int result;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_poll_event_init(&ev[0], K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+			  &data_sem[index]);
+	k_poll_event_init(&ev[1], K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &poll_signal[index]);
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_IDLE_EVENTS; i++) {
+		k_poll_event_init(&ev[i + 2], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &idle_sem[index][i]);
+	}
+
+	while (1) {
+		(void)k_poll(ev, NUM_EVENTS, K_FOREVER);
+
+		if (ev[0].state == K_POLL_STATE_SEM_AVAILABLE) {
+			(void)k_sem_take(&data_sem[index], K_NO_WAIT);
+		}
+
+		k_poll_signal_check(&poll_signal[index], &signaled, &result);
+		if (signaled != 0U) {
+			k_poll_signal_reset(&poll_signal[index]);
+		}
+
+		ev[0].state = K_POLL_STATE_NOT_READY;
+		ev[1].state = K_POLL_STATE_NOT_READY;
+
+		work_counter[index]++;
+		k_sem_give(&ack_sem[index]);
+	}
+}
+
+static void signaler_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int index = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned long n = 0; ; n++) {
+		if ((n & 1) != 0) {
+			(void)k_poll_signal_raise(&poll_signal[index], 0);
+		} else {
+			k_sem_give(&data_sem[index]);
+		}
+
+		(void)k_sem_take(&ack_sem[index], K_FOREVER);
+	}
+}
+
+static void report(void)
+{
+	unsigned int elapsed_time = CONFIG_BENCHMARK_INTERVAL_DURATION;
+	unsigned int i;
+	unsigned long total;
+	unsigned long counter[NUM_PAIRS];
+	unsigned long last_counter[NUM_PAIRS] = {};
+
+	while (1) {
+		k_sleep(K_SECONDS(CONFIG_BENCHMARK_INTERVAL_DURATION));
+
+		total = 0;
+
+		for (i = 0; i < NUM_PAIRS; i++) {
+			counter[i] = work_counter[i] - last_counter[i];
+			total += counter[i];
+			last_counter[i] = work_counter[i];
+		}
+
+		printf("**** Poll-SMP %u Lock(s) Test **** Elapsed Time: %u\n",
+		       CONFIG_POLL_LOCK_STRIPES, elapsed_time);
+
+		printf("  Total Wakeups: %lu\n", total);
+		for (i = 0; i < NUM_PAIRS; i++) {
+			printf("   - Pair #%u: %lu\n", i, counter[i]);
+		}
+
+		elapsed_time += CONFIG_BENCHMARK_INTERVAL_DURATION;
+	}
+}
+
+int main(void)
+{
+	for (unsigned int i = 0; i < NUM_PAIRS; i++) {
+		k_sem_init(&data_sem[i], 0, 1);
+		k_sem_init(&ack_sem[i], 0, 1);
+		for (unsigned int j = 0; j < CONFIG_BENCHMARK_IDLE_EVENTS; j++) {
+			k_sem_init(&idle_sem[i][j], 0, 1);
+		}
+		k_poll_signal_init(&poll_signal[i]);
+	}
+
+	for (unsigned int i = 0; i < NUM_PAIRS; i++) {
+		k_thread_create(&poller_thread[i], poller_stack[i],
+				WORK_STACK_SIZE, poller_entry,
+				UINT_TO_POINTER(i), NULL, NULL,
+				-1, 0, K_NO_WAIT);
+		k_thread_create(&signaler_thread[i], signaler_stack[i],
+				WORK_STACK_SIZE, signaler_entry,
+				UINT_TO_POINTER(i), NULL, NULL,
+				-1, 0, K_NO_WAIT);
+	}
+
+	report();
+
+	return 0;
+}
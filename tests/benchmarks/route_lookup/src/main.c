@@ -0,0 +1,194 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by
+ * net_route_lookup() to find the route to a destination, depending on the
+ * number of routes in the routing table.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+#include <string.h>
+
+#include "ipv6.h"
+#include "nbr.h"
+#include "route.h"
+
+#define NUM_NEXTHOPS 4
+
+static const unsigned int counts[] = {16, 64, CONFIG_NET_MAX_ROUTES};
+static const uint8_t prefix_lens[] = {48, 56, 64, 128};
+
+static struct in6_addr nexthops[NUM_NEXTHOPS];
+static struct in6_addr prefixes[CONFIG_NET_MAX_ROUTES];
+static struct net_route_entry *routes[CONFIG_NET_MAX_ROUTES];
+
+static struct net_if *iface;
+
+static uint32_t seed = 1;
+
+static bool failed;
+
+static const struct dummy_api bench_if_api;
+
+NET_DEVICE_INIT(bench_route, "bench_route",
+		NULL, NULL,
+		NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 1280);
+
+static uint32_t next_random(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static void report(const char *tag, const char *str, unsigned int count, uint64_t cycles,
+		   unsigned int lookups)
+{
+	uint64_t average = cycles / lookups;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u routes)", str, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: route.lookup.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag,
+	       count, (int)(8 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+/* Every route gets its own 2001:db8:<n>::/48, so that no route covers another */
+static void make_prefix(struct in6_addr *addr, unsigned int n)
+{
+	addr->s6_addr32[0] = htonl(0x20010db8);
+	addr->s6_addr32[1] = htonl(n << 16 | (next_random() >> 16));
+	addr->s6_addr32[2] = next_random();
+	addr->s6_addr32[3] = next_random();
+}
+
+/* A destination within the prefix of the route, but another host */
+static void make_destination(struct in6_addr *dst, unsigned int n)
+{
+	net_ipaddr_copy(dst, &prefixes[n]);
+
+	if (routes[n]->prefix_len < 128) {
+		dst->s6_addr[15] ^= 0x01;
+	}
+}
+
+static void measure(const char *tag, const char *str, unsigned int count, bool hit)
+{
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+	struct in6_addr dst;
+	struct net_route_entry *route;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		unsigned int n = next_random() % count;
+
+		if (hit) {
+			make_destination(&dst, n);
+		} else {
+			net_ipv6_addr_create(&dst, 0x2001, 0x0db9, n, 0, 0, 0, 0, 1);
+		}
+
+		start = timing_counter_get();
+		route = net_route_lookup(iface, &dst);
+		finish = timing_counter_get();
+		cycles += timing_cycles_get(&start, &finish);
+
+		failed |= (route != (hit ? routes[n] : NULL));
+	}
+
+	report(tag, str, count, cycles, CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+static void add_routes(unsigned int from, unsigned int to)
+{
+	for (unsigned int n = from; n < to; n++) {
+		make_prefix(&prefixes[n], n);
+
+		routes[n] = net_route_add(iface, &prefixes[n],
+					  prefix_lens[next_random() % ARRAY_SIZE(prefix_lens)],
+					  &nexthops[n % NUM_NEXTHOPS],
+					  NET_IPV6_ND_INFINITE_LIFETIME,
+					  NET_ROUTE_PREFERENCE_MEDIUM);
+		failed |= (routes[n] == NULL);
+	}
+}
+
+static void add_nexthops(void)
+{
+	struct net_linkaddr lladdr = {
+		.type = NET_LINK_DUMMY,
+		.len = 6,
+	};
+
+	for (unsigned int i = 0; i < NUM_NEXTHOPS; i++) {
+		net_ipv6_addr_create(&nexthops[i], 0xfe80, 0, 0, 0, 0, 0, 0, i + 1);
+		lladdr.addr[5] = i + 1;
+
+		failed |= (net_ipv6_nbr_add(iface, &nexthops[i], &lladdr, true,
+					    NET_IPV6_NBR_STATE_REACHABLE) == NULL);
+	}
+}
+
+int main(void)
+{
+	unsigned int freq;
+	unsigned int routes_added = 0;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for IPv6 route lookups (%s)\n",
+	       IS_ENABLED(CONFIG_NET_ROUTE_TRIE) ? "prefix trie" : "linear scan");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	add_nexthops();
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(counts); i++) {
+		add_routes(routes_added, counts[i]);
+		routes_added = counts[i];
+
+		measure("hit", "Destination with a route", counts[i], true);
+		measure("miss", "Destination without a route", counts[i], false);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("A route lookup returned the wrong route\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
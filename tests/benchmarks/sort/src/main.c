@@ -0,0 +1,188 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by
+ * qsort() to sort arrays of various sizes and initial orders.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_COUNT 2048
+
+static const unsigned int counts[] = {16, 256, MAX_COUNT};
+
+struct record {
+	uint32_t key;
+	uint32_t id;
+	uint32_t value;
+};
+
+static uint32_t input[MAX_COUNT];
+static uint32_t ints[MAX_COUNT];
+static struct record records_input[MAX_COUNT];
+static struct record records[MAX_COUNT];
+
+static uint32_t seed = 1;
+
+static bool failed;
+
+static uint32_t next_random(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed;
+}
+
+static int compare_ints(const void *a, const void *b)
+{
+	uint32_t aa = *(const uint32_t *)a;
+	uint32_t bb = *(const uint32_t *)b;
+
+	return (aa > bb) - (aa < bb);
+}
+
+static int compare_records(const void *a, const void *b)
+{
+	const struct record *ra = a;
+	const struct record *rb = b;
+
+	return (ra->key > rb->key) - (ra->key < rb->key);
+}
+
+static void report(const char *tag, const char *str, unsigned int count, uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u elements)", str, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: sort.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag, count,
+	       (int)(12 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure_ints(const char *tag, const char *str, unsigned int count)
+{
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		memcpy(ints, input, count * sizeof(ints[0]));
+
+		start = timing_counter_get();
+		qsort(ints, count, sizeof(ints[0]), compare_ints);
+		finish = timing_counter_get();
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	for (unsigned int i = 1; i < count; i++) {
+		failed |= (ints[i - 1] > ints[i]);
+	}
+
+	report(tag, str, count, cycles);
+}
+
+static void measure_records(unsigned int count)
+{
+	uint64_t cycles = 0;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < count; i++) {
+		records_input[i].key = next_random();
+		records_input[i].id = i;
+		records_input[i].value = ~i;
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		memcpy(records, records_input, count * sizeof(records[0]));
+
+		start = timing_counter_get();
+		qsort(records, count, sizeof(records[0]), compare_records);
+		finish = timing_counter_get();
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	for (unsigned int i = 0; i < count; i++) {
+		failed |= (records[i].value != ~records[i].id);
+		failed |= (i > 0) && (records[i - 1].key > records[i].key);
+	}
+
+	report("records", "12-byte records", count, cycles);
+}
+
+static void measure(unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		input[i] = next_random();
+	}
+	measure_ints("random", "Random integers", count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		input[i] = i;
+	}
+	measure_ints("sorted", "Sorted integers", count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		input[i] = count - i;
+	}
+	measure_ints("reversed", "Reversed integers", count);
+
+	for (unsigned int i = 0; i < count; i++) {
+		input[i] = next_random() % 4;
+	}
+	measure_ints("few_unique", "Integers with 4 distinct values", count);
+
+	measure_records(count);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for qsort() (%s)\n",
+	       IS_ENABLED(CONFIG_MINIMAL_LIBC_QSORT_INTROSORT) ? "introsort" : "heap sort");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(counts); i++) {
+		measure(counts[i]);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("qsort() returned an unsorted array\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
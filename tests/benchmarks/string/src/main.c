@@ -0,0 +1,143 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by the
+ * string scanning functions of the C library for strings of various lengths.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+#define MAX_LENGTH 1024
+
+static const unsigned int lengths[] = {7, 64, 255, MAX_LENGTH};
+
+/*
+ * The strings start one byte past an aligned address so that the unaligned
+ * head of block based implementations is part of the measurement.
+ */
+static char buf1[MAX_LENGTH + 2] __aligned(16);
+static char buf2[MAX_LENGTH + 2] __aligned(16);
+
+/* Hides the strings from the compiler so the calls cannot be folded */
+static const char *volatile str1 = &buf1[1];
+static const char *volatile str2 = &buf2[1];
+
+static volatile uintptr_t sink;
+
+static bool failed;
+
+static void report(const char *tag, const char *str, unsigned int length, uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u bytes)", str, length);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: string.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag,
+	       length, (int)(12 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void prepare(unsigned int length)
+{
+	for (unsigned int i = 0; i < length; i++) {
+		buf1[1 + i] = (char)('a' + (i % 26));
+	}
+	buf1[1 + length] = '\0';
+	memcpy(buf2, buf1, sizeof(buf2));
+}
+
+static void measure(unsigned int length)
+{
+	uint64_t strlen_cycles = 0;
+	uint64_t strchr_cycles = 0;
+	uint64_t strcmp_cycles = 0;
+	uint64_t memchr_cycles = 0;
+	timing_t start;
+	timing_t finish;
+
+	prepare(length);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		sink = strlen(str1);
+		finish = timing_counter_get();
+		strlen_cycles += timing_cycles_get(&start, &finish);
+		failed |= (sink != length);
+
+		/* '#' does not occur in the string, so the whole of it is scanned */
+		start = timing_counter_get();
+		sink = (uintptr_t)strchr(str1, '#');
+		finish = timing_counter_get();
+		strchr_cycles += timing_cycles_get(&start, &finish);
+		failed |= (sink != 0);
+
+		start = timing_counter_get();
+		sink = (uintptr_t)strcmp(str1, str2);
+		finish = timing_counter_get();
+		strcmp_cycles += timing_cycles_get(&start, &finish);
+		failed |= (sink != 0);
+
+		start = timing_counter_get();
+		sink = (uintptr_t)memchr(str1, '#', length);
+		finish = timing_counter_get();
+		memchr_cycles += timing_cycles_get(&start, &finish);
+		failed |= (sink != 0);
+	}
+
+	report("strlen", "strlen()", length, strlen_cycles);
+	report("strchr", "strchr() without match", length, strchr_cycles);
+	report("strcmp", "strcmp() of equal strings", length, strcmp_cycles);
+	report("memchr", "memchr() without match", length, memchr_cycles);
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for string functions (%s)\n",
+	       IS_ENABLED(CONFIG_MINIMAL_LIBC_STRING_ARCH)      ? "arch"
+	       : IS_ENABLED(CONFIG_MINIMAL_LIBC_STRING_WORDWISE) ? "word at a time"
+							       : "byte at a time");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		measure(lengths[i]);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("Some string functions returned wrong results\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the time required to deliver a block
+ * of data through a TCP connection over the loopback interface, while the
+ * interface drops a given ratio of the packets.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/loopback.h>
+#include <string.h>
+
+#define SERVER_PORT 4242
+#define CHUNK_SIZE 1024
+#define RECEIVER_STACK_SIZE 2048
+
+static const struct {
+	const char *tag;
+	const char *str;
+	float ratio;
+} losses[] = {
+	{"0pct", "No packet loss", 0.0f},
+	{"1pct", "1% packet loss", 0.01f},
+	{"2pct", "2% packet loss", 0.02f},
+	{"5pct", "5% packet loss", 0.05f},
+};
+
+K_THREAD_STACK_DEFINE(receiver_stack, RECEIVER_STACK_SIZE);
+static struct k_thread receiver_thread;
+static K_SEM_DEFINE(received_sem, 0, 1);
+
+static uint8_t tx_buf[CHUNK_SIZE];
+static uint8_t rx_buf[CHUNK_SIZE];
+
+static bool failed;
+
+static void report(const char *tag, const char *str, uint64_t cycles, int dropped)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint32_t goodput = (uint32_t)((uint64_t)CONFIG_BENCHMARK_TRANSFER_SIZE *
+				      NSEC_PER_SEC / 1024U / MAX(ns, 1));
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%d dropped, %u kB/s)", str, dropped,
+		 goodput);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: tcp.loss.%s.transfer%-*s - %-50s : %7llu cycles , %7llu ns :\n", tag,
+	       (int)(8 - strlen(tag)), "", description, cycles, ns);
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7llu nsec)\n", description, cycles, ns);
+#endif
+}
+
+/* Accepts one connection and reads everything from it, checking the data */
+static void receiver_entry(void *p1, void *p2, void *p3)
+{
+	int s_sock = POINTER_TO_INT(p1);
+	size_t total = 0;
+	ssize_t recved;
+	int sock;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = zsock_accept(s_sock, NULL, NULL);
+	if (sock < 0) {
+		failed = true;
+		k_sem_give(&received_sem);
+		return;
+	}
+
+	while (total < CONFIG_BENCHMARK_TRANSFER_SIZE) {
+		recved = zsock_recv(sock, rx_buf, sizeof(rx_buf), 0);
+		if (recved <= 0) {
+			failed = true;
+			break;
+		}
+
+		for (ssize_t i = 0; i < recved; i++) {
+			failed |= (rx_buf[i] != (uint8_t)(total + i));
+		}
+
+		total += recved;
+	}
+
+	k_sem_give(&received_sem);
+
+	(void)zsock_close(sock);
+}
+
+static int send_all(int sock)
+{
+	size_t total = 0;
+	size_t len;
+	ssize_t sent;
+
+	while (total < CONFIG_BENCHMARK_TRANSFER_SIZE) {
+		len = MIN(sizeof(tx_buf), CONFIG_BENCHMARK_TRANSFER_SIZE - total);
+
+		for (size_t i = 0; i < len; i++) {
+			tx_buf[i] = (uint8_t)(total + i);
+		}
+
+		sent = zsock_send(sock, tx_buf, len, 0);
+		if (sent < 0) {
+			return -errno;
+		}
+
+		/* Keep the pattern aligned on what was actually sent */
+		total += sent;
+	}
+
+	return 0;
+}
+
+static void measure(unsigned int index)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT + index),
+		.sin_addr = INADDR_LOOPBACK_INIT,
+	};
+	timing_t start;
+	timing_t finish;
+	int dropped;
+	int s_sock;
+	int c_sock;
+
+	s_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	c_sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (s_sock < 0 || c_sock < 0 ||
+	    zsock_bind(s_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_listen(s_sock, 1) < 0) {
+		failed = true;
+		goto out;
+	}
+
+	k_thread_create(&receiver_thread, receiver_stack, K_THREAD_STACK_SIZEOF(receiver_stack),
+			receiver_entry, INT_TO_POINTER(s_sock), NULL, NULL,
+			k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+
+	if (zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, CONFIG_BENCHMARK_CONGESTION,
+			     strlen(CONFIG_BENCHMARK_CONGESTION)) < 0 ||
+	    zsock_connect(c_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		failed = true;
+		(void)zsock_close(s_sock);
+		s_sock = -1;
+		k_thread_join(&receiver_thread, K_FOREVER);
+		goto out;
+	}
+
+	/* Only lose data and ACKs, not the handshake */
+	dropped = loopback_get_num_dropped_packets();
+	loopback_set_packet_drop_ratio(losses[index].ratio);
+
+	start = timing_counter_get();
+
+	if (send_all(c_sock) < 0) {
+		failed = true;
+	}
+
+	k_sem_take(&received_sem, K_FOREVER);
+
+	finish = timing_counter_get();
+
+	loopback_set_packet_drop_ratio(0.0f);
+	dropped = loopback_get_num_dropped_packets() - dropped;
+
+	k_thread_join(&receiver_thread, K_FOREVER);
+
+	report(losses[index].tag, losses[index].str, timing_cycles_get(&start, &finish),
+	       dropped);
+
+out:
+	if (c_sock >= 0) {
+		(void)zsock_close(c_sock);
+	}
+
+	if (s_sock >= 0) {
+		(void)zsock_close(s_sock);
+	}
+}
+
+int main(void)
+{
+	unsigned int freq;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for sending %u bytes over TCP with packet loss (%s, %s)\n",
+	       CONFIG_BENCHMARK_TRANSFER_SIZE, CONFIG_BENCHMARK_CONGESTION,
+	       IS_ENABLED(CONFIG_NET_TCP_SACK) ? "SACK" : "no SACK");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(losses); i++) {
+		measure(i);
+	}
+
+	timing_stop();
+
+	if (failed) {
+		printk("The data was not received correctly\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to add,
+ * abort and expire a kernel timeout while a varying number of other timeouts
+ * are outstanding. The outstanding timeouts are armed far enough in the future
+ * that they never expire while the measurements are taken.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timestamp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+#include <string.h>
+
+/* Outstanding timeouts expire somewhere in this window (in ticks) */
+#define FILLER_BASE_TICKS   (1 << 24)
+#define FILLER_WINDOW_TICKS (1 << 16)
+
+/* Ticks announced to expire the probe timeout armed with K_TICKS(0) */
+#define PROBE_ANNOUNCE_TICKS 16
+
+static struct _timeout filler[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static struct _timeout probe;
+static uint32_t probe_count;
+
+static const unsigned int queue_sizes[] = {10, 100, CONFIG_BENCHMARK_NUM_TIMEOUTS};
+
+static uint32_t rand_state = 1;
+
+/* Deterministic pseudo-random sequence so both backends see the same load */
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 8;
+}
+
+static void filler_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	__ASSERT(false, "filler timeout expired");
+}
+
+static void probe_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	probe_count++;
+}
+
+static k_timeout_t random_timeout(void)
+{
+	return K_TICKS(FILLER_BASE_TICKS + (next_rand() % FILLER_WINDOW_TICKS));
+}
+
+static void fill_queue(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		z_init_timeout(&filler[i]);
+		z_add_timeout(&filler[i], filler_handler, random_timeout());
+	}
+}
+
+static void drain_queue(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		z_abort_timeout(&filler[i]);
+	}
+}
+
+static void report(const char *tag, const char *str, unsigned int num_timeouts,
+		   uint64_t cycles)
+{
+	uint64_t average = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+	char description[64];
+
+	snprintk(description, sizeof(description), "%s (%u outstanding)", str,
+		 num_timeouts);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: timeout.%s.%04u.avg%-*s - %-50s : %7llu cycles , %7u ns :\n", tag,
+	       num_timeouts, (int)(24 - strlen(tag)), "", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%-50s: %7llu cycles (%7u nsec)\n", description, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+}
+
+static void measure(unsigned int num_timeouts)
+{
+	uint64_t add_cycles = 0;
+	uint64_t abort_cycles = 0;
+	uint64_t announce_cycles = 0;
+	timing_t start;
+	timing_t finish;
+	unsigned int key;
+
+	fill_queue(num_timeouts);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t timeout = random_timeout();
+
+		z_init_timeout(&probe);
+
+		start = timing_counter_get();
+		z_add_timeout(&probe, probe_handler, timeout);
+		finish = timing_counter_get();
+		add_cycles += timing_cycles_get(&start, &finish);
+
+		start = timing_counter_get();
+		z_abort_timeout(&probe);
+		finish = timing_counter_get();
+		abort_cycles += timing_cycles_get(&start, &finish);
+
+		/*
+		 * Expire the probe from the head of the queue the same way the
+		 * system timer driver would from its interrupt handler.
+		 */
+		z_add_timeout(&probe, probe_handler, K_TICKS(0));
+
+		key = irq_lock();
+		start = timing_counter_get();
+		sys_clock_announce(PROBE_ANNOUNCE_TICKS);
+		finish = timing_counter_get();
+		irq_unlock(key);
+		announce_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	drain_queue(num_timeouts);
+
+	report("add", "Add timeout", num_timeouts, add_cycles);
+	report("abort", "Abort timeout", num_timeouts, abort_cycles);
+	report("announce", "Announce expiring timeout", num_timeouts, announce_cycles);
+}
+
+int main(void)
+{
+	unsigned int freq;
+	uint32_t expected = 0;
+
+	timing_init();
+
+	bench_test_init();
+
+	freq = timing_freq_get_mhz();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SIMPLE) ? "simple" : "scalable");
+	printk("Timing results: Clock frequency: %u MHz\n", freq);
+
+	timing_start();
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(queue_sizes); i++) {
+		if ((queue_sizes[i] > CONFIG_BENCHMARK_NUM_TIMEOUTS) ||
+		    ((i > 0) && (queue_sizes[i] == queue_sizes[i - 1]))) {
+			continue;
+		}
+
+		measure(queue_sizes[i]);
+		expected += CONFIG_BENCHMARK_NUM_ITERATIONS;
+	}
+
+	timing_stop();
+
+	if (probe_count != expected) {
+		printk("Probe timeout expired %u times, expected %u\n", probe_count, expected);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
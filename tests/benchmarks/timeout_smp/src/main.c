@@ -0,0 +1,110 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This benchmark has a cooperative worker thread on every CPU but one start
+ * and stop a timer, and read the uptime, as fast as it can while keeping a
+ * number of other timers armed. The main thread periodically reports how
+ * many of these operations each worker completed, which highlights how much
+ * the CPUs contend on the timeout queue(s).
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#if CONFIG_MP_MAX_NUM_CPUS <= 1
+#error "Test requires a system with more than 1 CPU"
+#endif
+
+#define NUM_WORK_THREADS (CONFIG_MP_MAX_NUM_CPUS - 1)
+#define WORK_STACK_SIZE  4096
+
+static K_THREAD_STACK_ARRAY_DEFINE(work_stack, NUM_WORK_THREADS, WORK_STACK_SIZE);
+
+static struct k_thread work_thread[NUM_WORK_THREADS];
+static struct k_timer probe_timer[NUM_WORK_THREADS];
+static struct k_timer load_timer[NUM_WORK_THREADS][CONFIG_BENCHMARK_TIMERS_PER_THREAD];
+static volatile unsigned long work_counter[NUM_WORK_THREADS];
+
+static void work_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int index = POINTER_TO_UINT(p1);
+	struct k_timer *probe = &probe_timer[index];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_TIMERS_PER_THREAD; i++) {
+		k_timer_init(&load_timer[index][i], NULL, NULL);
+		k_timer_start(&load_timer[index][i], K_SECONDS(3600 + i), K_NO_WAIT);
+	}
+
+	k_timer_init(probe, NULL, NULL);
+
+	while (1) {
+		k_timer_start(probe, K_SECONDS(60), K_NO_WAIT);
+		(void)k_timer_remaining_ticks(probe);
+		k_timer_stop(probe);
+		(void)k_uptime_ticks();
+
+		work_counter[index]++;
+	}
+}
+
+static const char *queue_type(void)
+{
+	if (IS_ENABLED(CONFIG_TIMEOUT_QUEUE_PER_CPU)) {
+		return "Per-CPU";
+	}
+
+	return IS_ENABLED(CONFIG_TIMEOUT_QUEUE_SCALABLE) ? "Scalable" : "Simple";
+}
+
+static void report(void)
+{
+	unsigned int elapsed_time = CONFIG_BENCHMARK_INTERVAL_DURATION;
+	unsigned int i;
+	unsigned long total;
+	unsigned long counter[NUM_WORK_THREADS];
+	unsigned long last_counter[NUM_WORK_THREADS] = {};
+
+	while (1) {
+		k_sleep(K_SECONDS(CONFIG_BENCHMARK_INTERVAL_DURATION));
+
+		total = 0;
+
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			counter[i] = work_counter[i] - last_counter[i];
+			total += counter[i];
+			last_counter[i] = work_counter[i];
+		}
+
+		printf("**** Timeout-SMP %s Queue Test **** Elapsed Time: %u\n",
+		       queue_type(), elapsed_time);
+
+		printf("  Total Timeout Ops: %lu\n", total);
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			printf("   - Worker #%u: %lu\n", i, counter[i]);
+		}
+
+		elapsed_time += CONFIG_BENCHMARK_INTERVAL_DURATION;
+	}
+}
+
+int main(void)
+{
+	for (unsigned int i = 0; i < NUM_WORK_THREADS; i++) {
+		k_thread_create(&work_thread[i], work_stack[i],
+				WORK_STACK_SIZE, work_entry,
+				UINT_TO_POINTER(i), NULL, NULL,
+				-1, 0, K_NO_WAIT);
+	}
+
+	report();
+
+	return 0;
+}
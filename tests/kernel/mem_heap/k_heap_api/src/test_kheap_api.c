@@ -6,6 +6,7 @@
 
 #include <zephyr/ztest.h>
 #include <zephyr/irq_offload.h>
+#include <string.h>
 #include "test_kheap.h"
 
 #define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
@@ -19,6 +20,8 @@ K_HEAP_DEFINE(k_heap_test, HEAP_SIZE);
 #define ALLOC_SIZE_3 2049
 #define CALLOC_NUM   256
 #define CALLOC_SIZE  sizeof(uint32_t)
+#define BULK_NUM     8
+#define BULK_SIZE    128
 
 static void tIsr_kheap_alloc_nowait(void *data)
 {
@@ -291,3 +294,46 @@ ZTEST(k_heap_api, test_k_heap_calloc)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Test to demonstrate k_heap_alloc_bulk() and k_heap_free_bulk() API usage
+ *
+ * @ingroup k_heap_api_tests
+ *
+ * @details The test allocates 8 blocks of 128 bytes from the 2048 byte heap
+ * in one call and checks that they are distinct and usable. It then checks
+ * that a batch too large for the heap fails as a whole, leaving enough room
+ * for a 1536 byte allocation after the first batch has been freed.
+ *
+ * @see k_heap_alloc_bulk(), k_heap_free_bulk()
+ */
+ZTEST(k_heap_api, test_k_heap_alloc_bulk)
+{
+	k_timeout_t timeout = Z_TIMEOUT_US(TIMEOUT);
+	void *blocks[BULK_NUM];
+	char *p;
+	int ret;
+
+	ret = k_heap_alloc_bulk(&k_heap_test, BULK_SIZE, blocks, BULK_NUM, timeout);
+	zassert_equal(ret, 0, "k_heap_alloc_bulk operation failed");
+
+	for (int i = 0; i < BULK_NUM; i++) {
+		zassert_not_null(blocks[i], "block %d not allocated", i);
+		memset(blocks[i], i, BULK_SIZE);
+	}
+
+	for (int i = 0; i < BULK_NUM; i++) {
+		for (int j = 0; j < BULK_SIZE; j++) {
+			zassert_equal(((uint8_t *)blocks[i])[j], i, "block %d overwritten", i);
+		}
+	}
+
+	k_heap_free_bulk(&k_heap_test, blocks, BULK_NUM);
+
+	ret = k_heap_alloc_bulk(&k_heap_test, ALLOC_SIZE_1, blocks, 2, K_NO_WAIT);
+	zassert_equal(ret, -ENOMEM, "k_heap_alloc_bulk should fail but did not");
+
+	p = (char *)k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "failed bulk allocation leaked memory");
+	k_heap_free(&k_heap_test, p);
+}
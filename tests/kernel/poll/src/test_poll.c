@@ -876,3 +876,67 @@ ZTEST(poll_api_1cpu, test_poll_zero_events)
 
 	zassert_equal(k_poll(&event, 0, K_MSEC(50)), -EAGAIN);
 }
+
+static struct k_sem watch_sem;
+static struct k_poll_signal watch_signal;
+static struct k_poll_event *watch_fired[4];
+static int watch_num_fired;
+
+static void watch_cb(struct k_poll_watch *watch, struct k_poll_event *event)
+{
+	ARG_UNUSED(watch);
+
+	watch_fired[watch_num_fired++] = event;
+}
+
+/**
+ * @brief Test that a poll watch reports events that are ready when added,
+ * events that become ready later, and nothing for removed events
+ *
+ * @ingroup kernel_poll_tests
+ */
+ZTEST(poll_api_1cpu, test_poll_watch)
+{
+	struct k_poll_watch watch;
+	struct k_poll_event events[2];
+
+	k_sem_init(&watch_sem, 1, 1);
+	k_poll_signal_init(&watch_signal);
+	watch_num_fired = 0;
+
+	k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &watch_sem);
+	k_poll_event_init(&events[1], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &watch_signal);
+
+	k_poll_watch_init(&watch, watch_cb);
+
+	/* the semaphore is available, so it fires right away */
+	k_poll_watch_add(&watch, events, ARRAY_SIZE(events));
+	zassert_equal(watch_num_fired, 1);
+	zassert_equal_ptr(watch_fired[0], &events[0]);
+	zassert_equal(events[0].state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* the signal fires once, when raised */
+	zassert_ok(k_poll_signal_raise(&watch_signal, 0x1337));
+	zassert_equal(watch_num_fired, 2);
+	zassert_equal_ptr(watch_fired[1], &events[1]);
+	zassert_equal(events[1].state, K_POLL_STATE_SIGNALED);
+
+	k_poll_signal_reset(&watch_signal);
+	zassert_ok(k_poll_signal_raise(&watch_signal, 0x1337));
+	zassert_equal(watch_num_fired, 2, "event fired twice");
+
+	/* removed events do not fire */
+	k_sem_reset(&watch_sem);
+	k_poll_signal_reset(&watch_signal);
+	events[0].state = K_POLL_STATE_NOT_READY;
+	events[1].state = K_POLL_STATE_NOT_READY;
+	k_poll_watch_add(&watch, events, ARRAY_SIZE(events));
+	zassert_equal(watch_num_fired, 2);
+	k_poll_watch_remove(&watch, events, ARRAY_SIZE(events));
+
+	k_sem_give(&watch_sem);
+	zassert_ok(k_poll_signal_raise(&watch_signal, 0x1337));
+	zassert_equal(watch_num_fired, 2, "removed event fired");
+}
@@ -546,6 +546,68 @@ ZTEST(libc_common, test_memchr)
 	zassert_is_null(memchr(str, '\0', strlen(str)), "memchr scope error");
 }
 
+/**
+ * @brief Test string scanning at every alignment and length
+ *
+ * Implementations that scan a word or more at a time have separate
+ * paths for the unaligned head, the aligned blocks and the tail, so
+ * check all combinations against the obvious byte loop.
+ *
+ * @see strlen(), strchr(), strcmp(), memchr().
+ */
+ZTEST(libc_common, test_str_scan_alignment)
+{
+	static char s1[80] __aligned(16);
+	static char s2[80] __aligned(16);
+
+	for (size_t off = 0; off < 16; off++) {
+		for (size_t len = 0; len < 48; len++) {
+			char *s = &s1[off];
+			char *t = &s2[off];
+
+			(void)memset(s1, 0x7f, sizeof(s1));
+			for (size_t i = 0; i < len; i++) {
+				s[i] = (char)('a' + (i % 26));
+			}
+			s[len] = '\0';
+
+			zassert_equal(strlen(s), len, "strlen off %zu len %zu", off, len);
+			zassert_equal(strchr(s, '\0'), &s[len], "strchr NUL off %zu", off);
+			zassert_is_null(strchr(s, 0x7f), "strchr past NUL off %zu", off);
+			zassert_is_null(memchr(s, 0x7f, len), "memchr past end off %zu", off);
+
+			if (len > 0) {
+				char c = s[len - 1];
+				size_t first = (len - 1) % 26;
+
+				zassert_equal(strchr(s, c), &s[first], "strchr off %zu len %zu",
+					      off, len);
+				zassert_equal(memchr(s, c, len), &s[first],
+					      "memchr off %zu len %zu", off, len);
+			}
+
+			/* mutually misaligned strings */
+			(void)memcpy(&s2[15 - off], s, len + 1);
+			zassert_equal(strcmp(s, &s2[15 - off]), 0,
+				      "strcmp misaligned off %zu len %zu", off, len);
+
+			(void)memcpy(t, s, len + 1);
+			zassert_equal(strcmp(s, t), 0, "strcmp equal off %zu len %zu", off, len);
+
+			if (len > 0) {
+				t[len - 1]++;
+				zassert_true(strcmp(s, t) < 0, "strcmp less off %zu len %zu",
+					     off, len);
+				zassert_true(strcmp(t, s) > 0, "strcmp greater off %zu len %zu",
+					     off, len);
+				t[len - 1] = '\0';
+				zassert_true(strcmp(s, t) > 0, "strcmp shorter off %zu len %zu",
+					     off, len);
+			}
+		}
+	}
+}
+
 /**
  * @brief Test memcpy operation
  *
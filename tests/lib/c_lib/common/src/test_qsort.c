@@ -7,6 +7,7 @@
 #define _GNU_SOURCE
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <zephyr/ztest.h>
 
 static int compare_ints(const void *a, const void *b)
@@ -151,3 +152,97 @@ ZTEST(libc_common, test_qsort_r)
 	zassert_mem_equal(actual_int, expect_int, sizeof(expect_int), "array not sorted");
 	zassert_true(arg, "arg not modified");
 }
+
+struct qsort_record {
+	int key;
+	int id;
+	char tag[5];
+};
+
+static int compare_records(const void *a, const void *b)
+{
+	const struct qsort_record *ra = a;
+	const struct qsort_record *rb = b;
+
+	return (ra->key > rb->key) - (ra->key < rb->key);
+}
+
+static int compare_triplets(const void *a, const void *b, void *argp)
+{
+	ARG_UNUSED(argp);
+
+	return memcmp(a, b, 3);
+}
+
+#define QSORT_PATTERN_MAX 600
+
+static int qsort_pattern(unsigned int pattern, unsigned int i, unsigned int n, uint32_t *seed)
+{
+	switch (pattern) {
+	case 0: /* random */
+		*seed = *seed * 1103515245U + 12345U;
+		return (int)(*seed >> 8);
+	case 1: /* sorted */
+		return i;
+	case 2: /* reversed */
+		return n - i;
+	case 3: /* few distinct keys */
+		return i % 4;
+	case 4: /* all equal */
+		return 7;
+	case 5: /* organ pipe */
+		return (i < n / 2) ? i : n - i;
+	default: /* sorted but for one element */
+		return (i == n / 2) ? -1 : (int)i;
+	}
+}
+
+/**
+ *
+ * @brief Test qsort with inputs that are known to be hard for quicksort, and
+ * with element sizes that are not a multiple of the word size
+ *
+ */
+ZTEST(libc_common, test_qsort_patterns)
+{
+	static struct qsort_record records[QSORT_PATTERN_MAX];
+	static uint8_t triplets[QSORT_PATTERN_MAX][3];
+	static int ints[QSORT_PATTERN_MAX];
+	uint32_t seed = 1;
+
+	for (unsigned int pattern = 0; pattern < 7; pattern++) {
+		for (unsigned int n = 0; n <= QSORT_PATTERN_MAX; n = (n < 40) ? n + 1 : n * 2) {
+			unsigned int sum = 0;
+
+			for (unsigned int i = 0; i < n; i++) {
+				ints[i] = qsort_pattern(pattern, i, n, &seed);
+				records[i].key = ints[i];
+				records[i].id = i;
+				records[i].tag[0] = (char)ints[i];
+				(void)memcpy(triplets[i], &ints[i], sizeof(triplets[i]));
+				sum += i;
+			}
+
+			qsort(ints, n, sizeof(ints[0]), compare_ints);
+			qsort(records, n, sizeof(records[0]), compare_records);
+			qsort_r(triplets, n, sizeof(triplets[0]), compare_triplets, NULL);
+
+			for (unsigned int i = 0; i < n; i++) {
+				/* every record must still be present and intact */
+				sum -= records[i].id;
+				zassert_equal(records[i].tag[0], (char)records[i].key,
+					      "record corrupted, pattern %u size %u", pattern, n);
+				if (i == 0) {
+					continue;
+				}
+				zassert_true(ints[i - 1] <= ints[i],
+					     "ints not sorted, pattern %u size %u", pattern, n);
+				zassert_true(records[i - 1].key <= records[i].key,
+					     "records not sorted, pattern %u size %u", pattern, n);
+				zassert_true(memcmp(triplets[i - 1], triplets[i], 3) <= 0,
+					     "triplets not sorted, pattern %u size %u", pattern, n);
+			}
+			zassert_equal(sum, 0, "records lost, pattern %u size %u", pattern, n);
+		}
+	}
+}
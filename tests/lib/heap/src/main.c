@@ -158,6 +158,20 @@ static void log_result(size_t sz, struct z_heap_stress_result *r)
 		 "  avg usage: %d/%d (%d%%)\n",
 		 r->successful_allocs, r->total_allocs, succ_pct,
 		 r->total_frees, avg, (int) sz, avg_pct);
+
+	/* Fragmentation is the share of the memory not held by the rig
+	 * at the end of the run that can't be handed out as one block.
+	 * Chunk headers count as unusable, so this never quite gets to
+	 * zero.
+	 */
+	size_t unused = sz - r->final_in_use_bytes;
+	uint32_t frag_pct = 100U - (uint32_t)((100ULL * r->largest_free_bytes) / unused);
+	uint64_t ops_per_sec = r->elapsed_cycles == 0U ? 0U :
+		(tot * (uint64_t)sys_clock_hw_cycles_per_sec()) / r->elapsed_cycles;
+
+	TC_PRINT("ops/sec: %u, largest free block: %d/%d (fragmentation %d%%)\n",
+		 (uint32_t)ops_per_sec, (int)r->largest_free_bytes, (int)unused,
+		 frag_pct);
 }
 
 /* Do a heavy test over a small heap, with many iterations that need
@@ -211,6 +225,39 @@ ZTEST(lib_heap, test_fragmentation)
 	log_result(SMALL_HEAP_SZ, &result);
 }
 
+static void *rawalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void rawfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+/* Same workload as test_small_heap on a bigger heap, but without the
+ * per-operation validation so that the reported ops/sec reflect the
+ * allocator itself.  Run with and without CONFIG_SYS_HEAP_SIZE_CLASSES
+ * to compare both modes.
+ */
+ZTEST(lib_heap, test_throughput)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+	size_t sz = MIN(BIG_HEAP_SZ, 16 * 1024);
+
+	TC_PRINT("Testing throughput on a %d byte heap\n", (int) sz);
+
+	sys_heap_init(&heap, heapmem, sz);
+	sys_heap_stress(rawalloc, rawfree, &heap,
+			sz, 8 * ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			50, &result);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	log_result(sz, &result);
+}
+
 /* The heap block format changes for heaps with more than 2^15 chunks,
  * so test that case too.  This can be too large to iterate over
  * exhaustively with good performance, so the relative operation count
@@ -2048,6 +2048,100 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+ZTEST(lib_json_test, test_large_descriptor_key_order)
+{
+	struct key_order_struct {
+		int a;
+		int bb;
+		int id;
+		int ccc;
+		int name;
+		int x;
+		int yy;
+		int zzz;
+		int type;
+		int value;
+		int v;
+		int vv;
+		int unit;
+		int time;
+		int ts;
+		int min;
+		int max;
+		int avg;
+	};
+
+	static const struct json_obj_descr key_order_descr[] = {
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, a, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, bb, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, id, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, ccc, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, name, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, x, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, yy, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, zzz, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, type, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, value, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, v, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, vv, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, unit, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, time, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, ts, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, min, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, max, JSON_TOK_NUMBER),
+		JSON_OBJ_DESCR_PRIM(struct key_order_struct, avg, JSON_TOK_NUMBER),
+	};
+	/* Reverse order, unknown keys and a repeated key, which is skipped */
+	char encoded[] = "{"
+		"\"avg\": 18,"
+		"\"max\": 17,"
+		"\"min\": 16,"
+		"\"ts\": 15,"
+		"\"time\": 14,"
+		"\"unit\": 13,"
+		"\"vv\": 12,"
+		"\"v\": 11,"
+		"\"value\": 10,"
+		"\"unknown\": 100,"
+		"\"type\": 9,"
+		"\"zzz\": 8,"
+		"\"yy\": 7,"
+		"\"x\": 6,"
+		"\"name\": 5,"
+		"\"ccc\": 4,"
+		"\"id\": 3,"
+		"\"bb\": 2,"
+		"\"a\": 1,"
+		"\"ccc\": 200,"
+		"\"xyz\": 300"
+		"}";
+	struct key_order_struct s;
+
+	int64_t ret = json_obj_parse(encoded, sizeof(encoded) - 1, key_order_descr,
+				     ARRAY_SIZE(key_order_descr), &s);
+
+	zassert_equal(ret, BIT64_MASK(ARRAY_SIZE(key_order_descr)),
+		      "Not all fields decoded: %llx", ret);
+	zassert_equal(s.a, 1, "Field a decoded wrongly");
+	zassert_equal(s.bb, 2, "Field bb decoded wrongly");
+	zassert_equal(s.id, 3, "Field id decoded wrongly");
+	zassert_equal(s.ccc, 4, "Field ccc decoded wrongly");
+	zassert_equal(s.name, 5, "Field name decoded wrongly");
+	zassert_equal(s.x, 6, "Field x decoded wrongly");
+	zassert_equal(s.yy, 7, "Field yy decoded wrongly");
+	zassert_equal(s.zzz, 8, "Field zzz decoded wrongly");
+	zassert_equal(s.type, 9, "Field type decoded wrongly");
+	zassert_equal(s.value, 10, "Field value decoded wrongly");
+	zassert_equal(s.v, 11, "Field v decoded wrongly");
+	zassert_equal(s.vv, 12, "Field vv decoded wrongly");
+	zassert_equal(s.unit, 13, "Field unit decoded wrongly");
+	zassert_equal(s.time, 14, "Field time decoded wrongly");
+	zassert_equal(s.ts, 15, "Field ts decoded wrongly");
+	zassert_equal(s.min, 16, "Field min decoded wrongly");
+	zassert_equal(s.max, 17, "Field max decoded wrongly");
+	zassert_equal(s.avg, 18, "Field avg decoded wrongly");
+}
+
 ZTEST(lib_json_test, test_json_encoded_object_tok_encoding)
 {
 	static const char encoded[] =
@@ -2178,4 +2272,162 @@ ZTEST(lib_json_test, test_json_enums)
 		     "Enums not decoded correctly");
 }
 
+struct stream_nested {
+	int32_t a;
+	char s[8];
+	bool b;
+};
+
+struct stream_struct {
+	char name[12];
+	int32_t num;
+	int64_t big;
+	uint8_t small;
+	bool flag;
+	struct stream_nested nested;
+	int32_t arr[4];
+	size_t arr_len;
+	struct stream_nested objs[3];
+	size_t objs_len;
+};
+
+static const struct json_obj_descr stream_nested_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct stream_nested, a, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct stream_nested, s, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct stream_nested, b, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr stream_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct stream_struct, name, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct stream_struct, num, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct stream_struct, big, JSON_TOK_INT64),
+	JSON_OBJ_DESCR_PRIM(struct stream_struct, small, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_PRIM(struct stream_struct, flag, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_OBJECT(struct stream_struct, nested, stream_nested_descr),
+	JSON_OBJ_DESCR_ARRAY(struct stream_struct, arr, 4, arr_len, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct stream_struct, objs, 3, objs_len,
+				 stream_nested_descr, ARRAY_SIZE(stream_nested_descr)),
+};
+
+static const char stream_doc[] =
+	"{\"name\":\"st\\u0041m\","
+	"\"unknown\":{\"deep\":[1,[2,{\"x\":\"a string longer than the token buffer\"}]],"
+	"\"s\":\"}]\"},"
+	"\"num\":-12345,\"big\":-9007199254740993,\"small\":200,\"flag\":true,"
+	"\"nested\":{\"a\":7,\"s\":\"ab\\\"c\",\"b\":false},"
+	"\"arr\":[1, 2 ,3],"
+	"\"objs\":[{\"a\":1},{\"s\":\"x\",\"b\":true},{}]}";
+
+/**
+ * @brief Test the streaming parser against json_obj_parse() for every
+ * chunk size, down to one byte at a time
+ */
+ZTEST(lib_json_test, test_json_stream_chunks)
+{
+	static struct stream_struct expected;
+	static struct stream_struct decoded;
+	char doc[sizeof(stream_doc)];
+	char token_buf[32];
+	struct json_stream stream;
+	int64_t expected_ret;
+
+	(void)memset(&expected, 0, sizeof(expected));
+	(void)memcpy(doc, stream_doc, sizeof(doc));
+	expected_ret = json_obj_parse(doc, sizeof(doc) - 1, stream_descr,
+				      ARRAY_SIZE(stream_descr), &expected);
+	zassert_equal(expected_ret, BIT64_MASK(ARRAY_SIZE(stream_descr)),
+		      "json_obj_parse returned %lld", expected_ret);
+
+	for (size_t chunk = 1; chunk < sizeof(stream_doc); chunk++) {
+		(void)memset(&decoded, 0, sizeof(decoded));
+		zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf),
+					    stream_descr, ARRAY_SIZE(stream_descr), &decoded));
+
+		for (size_t pos = 0; pos < sizeof(stream_doc) - 1; pos += chunk) {
+			size_t len = MIN(chunk, sizeof(stream_doc) - 1 - pos);
+
+			zassert_ok(json_stream_feed(&stream, &stream_doc[pos], len),
+				   "feed failed at %zu, chunk size %zu", pos, chunk);
+		}
+
+		zassert_equal(json_stream_finish(&stream), expected_ret,
+			      "wrong fields decoded, chunk size %zu", chunk);
+		zassert_mem_equal(&decoded, &expected, sizeof(decoded),
+				  "values differ, chunk size %zu", chunk);
+	}
+
+	zassert_str_equal(decoded.name, "st\\u0041m");
+	zassert_equal(decoded.big, -9007199254740993LL);
+	zassert_equal(decoded.arr_len, 3);
+	zassert_equal(decoded.objs_len, 3);
+	zassert_true(decoded.objs[1].b);
+}
+
+/**
+ * @brief Test that unknown keys longer than the token buffer are skipped
+ * with their value
+ */
+ZTEST(lib_json_test, test_json_stream_long_unknown_key)
+{
+	static const char doc[] = "{\"num\":1,\"an unknown key\\u0041 too long\":{\"num\":2},"
+				  "\"small\":3}";
+	static struct stream_struct decoded;
+	char token_buf[8];
+	struct json_stream stream;
+
+	for (size_t chunk = 1; chunk < sizeof(doc); chunk++) {
+		(void)memset(&decoded, 0, sizeof(decoded));
+		zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf),
+					    stream_descr, ARRAY_SIZE(stream_descr), &decoded));
+
+		for (size_t pos = 0; pos < sizeof(doc) - 1; pos += chunk) {
+			size_t len = MIN(chunk, sizeof(doc) - 1 - pos);
+
+			zassert_ok(json_stream_feed(&stream, &doc[pos], len),
+				   "feed failed at %zu, chunk size %zu", pos, chunk);
+		}
+
+		zassert_equal(json_stream_finish(&stream), BIT(1) | BIT(3),
+			      "wrong fields decoded, chunk size %zu", chunk);
+		zassert_equal(decoded.num, 1);
+		zassert_equal(decoded.small, 3);
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_errors)
+{
+	static struct stream_struct decoded;
+	char token_buf[8];
+	struct json_stream stream;
+
+	/* "name" value does not fit the token buffer */
+	zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf), stream_descr,
+				    ARRAY_SIZE(stream_descr), &decoded));
+	zassert_equal(json_stream_feed(&stream, "{\"name\":\"too long\"}", 19), -ENOMEM);
+	zassert_equal(json_stream_finish(&stream), -ENOMEM, "error is not sticky");
+
+	/* Incomplete object */
+	zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf), stream_descr,
+				    ARRAY_SIZE(stream_descr), &decoded));
+	zassert_ok(json_stream_feed(&stream, "{\"num\":1", 8));
+	zassert_equal(json_stream_finish(&stream), -EINVAL);
+
+	/* Whitespace may follow the object, nothing else */
+	zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf), stream_descr,
+				    ARRAY_SIZE(stream_descr), &decoded));
+	zassert_ok(json_stream_feed(&stream, "{\"num\":1} \n", 11));
+	zassert_equal(json_stream_finish(&stream), BIT(1));
+	zassert_equal(json_stream_feed(&stream, "{", 1), -EINVAL);
+
+	/* Too many array elements */
+	zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf), stream_descr,
+				    ARRAY_SIZE(stream_descr), &decoded));
+	zassert_equal(json_stream_feed(&stream, "{\"arr\":[1,2,3,4,5]}", 19), -ENOSPC);
+
+	/* String pointers cannot refer to the input */
+	zassert_ok(json_stream_init(&stream, token_buf, sizeof(token_buf), elt_descr,
+				    ARRAY_SIZE(elt_descr), &decoded));
+	zassert_equal(json_stream_feed(&stream, "{\"name\":\"x\"}", 12), -ENOTSUP);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,269 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/zvfs/epoll.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <zephyr/ztest.h>
+
+static int epfd = -1;
+static int efd[2] = {-1, -1};
+
+static void add(int fd, uint32_t events, uint32_t data)
+{
+	struct zvfs_epoll_event ev = {
+		.events = events,
+		.data.u32 = data,
+	};
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, fd, &ev), "errno %d", errno);
+}
+
+static int wait_events(struct zvfs_epoll_event *events, int maxevents, int timeout)
+{
+	int ret = zvfs_epoll_wait(epfd, events, maxevents, timeout);
+
+	zassert_true(ret >= 0, "zvfs_epoll_wait() failed: %d", errno);
+
+	return ret;
+}
+
+static void drain(int fd)
+{
+	zvfs_eventfd_t value;
+
+	zassert_ok(zvfs_eventfd_read(fd, &value));
+}
+
+ZTEST(zvfs_epoll, test_level_triggered)
+{
+	struct zvfs_epoll_event events[2];
+
+	add(efd[0], ZVFS_EPOLLIN, 42);
+
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 0);
+
+	zassert_ok(zvfs_eventfd_write(efd[0], 1));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].events, ZVFS_EPOLLIN);
+	zassert_equal(events[0].data.u32, 42);
+
+	/* still readable, so reported again */
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].data.u32, 42);
+
+	drain(efd[0]);
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 0);
+}
+
+ZTEST(zvfs_epoll, test_oneshot)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN | ZVFS_EPOLLONESHOT,
+		.data.u32 = 7,
+	};
+	struct zvfs_epoll_event events[2];
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd[0], &ev));
+	zassert_ok(zvfs_eventfd_write(efd[0], 1));
+
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].data.u32, 7);
+
+	/* disabled after being reported once */
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 0);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd[0], &ev));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].data.u32, 7);
+}
+
+ZTEST(zvfs_epoll, test_ctl)
+{
+	struct zvfs_epoll_event ev = {
+		.events = ZVFS_EPOLLIN,
+	};
+	struct zvfs_epoll_event events[2];
+
+	add(efd[0], ZVFS_EPOLLIN, 1);
+
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, efd[0], &ev), -1);
+	zassert_equal(errno, EEXIST);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd[1], &ev), -1);
+	zassert_equal(errno, ENOENT);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_ADD, CONFIG_ZVFS_OPEN_MAX, &ev), -1);
+	zassert_equal(errno, EBADF);
+	zassert_equal(zvfs_epoll_ctl(efd[1], ZVFS_EPOLL_CTL_ADD, efd[0], &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	/* switch interest from input to output, which an empty eventfd always has */
+	ev.events = ZVFS_EPOLLOUT;
+	ev.data.u32 = 2;
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_MOD, efd[0], &ev));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].events, ZVFS_EPOLLOUT);
+	zassert_equal(events[0].data.u32, 2);
+
+	zassert_ok(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd[0], NULL));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 0);
+	zassert_equal(zvfs_epoll_ctl(epfd, ZVFS_EPOLL_CTL_DEL, efd[0], NULL), -1);
+	zassert_equal(errno, ENOENT);
+}
+
+ZTEST(zvfs_epoll, test_maxevents)
+{
+	struct zvfs_epoll_event events[2];
+
+	add(efd[0], ZVFS_EPOLLIN, 0);
+	add(efd[1], ZVFS_EPOLLIN, 1);
+	zassert_ok(zvfs_eventfd_write(efd[0], 1));
+	zassert_ok(zvfs_eventfd_write(efd[1], 1));
+
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 2);
+
+	/* descriptors left over are reported first by the next call */
+	zassert_equal(wait_events(events, 1, 0), 1);
+	zassert_equal(events[0].data.u32, 0);
+	zassert_equal(wait_events(events, 1, 0), 1);
+	zassert_equal(events[0].data.u32, 1);
+	zassert_equal(wait_events(events, 1, 0), 1);
+	zassert_equal(events[0].data.u32, 0);
+}
+
+static void write_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	zassert_ok(zvfs_eventfd_write(efd[1], 1));
+}
+
+static K_WORK_DELAYABLE_DEFINE(write_work, write_handler);
+
+ZTEST(zvfs_epoll, test_wait)
+{
+	struct zvfs_epoll_event events[2];
+	int64_t start;
+
+	add(efd[0], ZVFS_EPOLLIN, 0);
+	add(efd[1], ZVFS_EPOLLIN, 1);
+
+	start = k_uptime_get();
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 50), 0);
+	zassert_true(k_uptime_get() - start >= 50, "returned before the timeout");
+
+	k_work_schedule(&write_work, K_MSEC(50));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), -1), 1);
+	zassert_equal(events[0].data.u32, 1);
+}
+
+#define WRITER_ROUNDS 100
+
+static struct k_thread writer_thread;
+K_THREAD_STACK_DEFINE(writer_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < WRITER_ROUNDS; i++) {
+		zassert_ok(zvfs_eventfd_write(efd[1], 1));
+		k_sleep(K_TICKS(1));
+	}
+}
+
+/* Events firing while zvfs_epoll_wait() collects the ready descriptors */
+ZTEST(zvfs_epoll, test_wait_concurrent)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	struct zvfs_epoll_event events[2];
+	zvfs_eventfd_t value;
+	int n;
+
+	/* always writable, so always collected along with efd[1] */
+	add(efd[0], ZVFS_EPOLLOUT, 0);
+	add(efd[1], ZVFS_EPOLLIN, 1);
+
+	/* let the writer preempt the collection at any point */
+	k_thread_priority_set(k_current_get(), K_LOWEST_APPLICATION_THREAD_PRIO);
+	k_thread_create(&writer_thread, writer_stack, K_THREAD_STACK_SIZEOF(writer_stack),
+			writer, NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO - 1, 0,
+			K_NO_WAIT);
+
+	while (k_thread_join(&writer_thread, K_NO_WAIT) != 0) {
+		/* one at a time, so that efd[1] is left over on the collection list */
+		n = wait_events(events, 1, 0);
+		zassert_equal(n, 1);
+		if (events[0].data.u32 == 1) {
+			(void)zvfs_eventfd_read(efd[1], &value);
+		}
+	}
+
+	k_thread_priority_set(k_current_get(), prio);
+
+	(void)zvfs_eventfd_read(efd[1], &value);
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 1);
+	zassert_equal(events[0].data.u32, 0);
+
+	zassert_ok(zvfs_eventfd_write(efd[1], 1));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 2);
+	zassert_not_equal(events[0].data.u32, events[1].data.u32);
+}
+
+ZTEST(zvfs_epoll, test_close)
+{
+	struct zvfs_epoll_event events[2];
+	int fd = efd[0];
+
+	add(efd[0], ZVFS_EPOLLIN, 0);
+	zassert_ok(zvfs_eventfd_write(efd[0], 1));
+
+	zassert_ok(zvfs_close(efd[0]));
+	zassert_equal(wait_events(events, ARRAY_SIZE(events), 0), 0);
+
+	/* the descriptor number is reused, and is not part of the interest set */
+	efd[0] = zvfs_eventfd(0, 0);
+	zassert_equal(efd[0], fd);
+	add(efd[0], ZVFS_EPOLLIN, 0);
+}
+
+static void before(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	epfd = zvfs_epoll_create();
+	zassert_true(epfd >= 0, "zvfs_epoll_create() failed: %d", errno);
+
+	for (size_t i = 0; i < ARRAY_SIZE(efd); i++) {
+		efd[i] = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+		zassert_true(efd[i] >= 0, "zvfs_eventfd() failed: %d", errno);
+	}
+}
+
+static void after(void *arg)
+{
+	ARG_UNUSED(arg);
+
+	for (size_t i = 0; i < ARRAY_SIZE(efd); i++) {
+		if (efd[i] >= 0) {
+			zvfs_close(efd[i]);
+			efd[i] = -1;
+		}
+	}
+
+	if (epfd >= 0) {
+		zvfs_close(epfd);
+		epfd = -1;
+	}
+}
+
+ZTEST_SUITE(zvfs_epoll, NULL, NULL, before, after, NULL);
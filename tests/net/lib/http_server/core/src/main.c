@@ -13,6 +13,7 @@
 #include <zephyr/net/http/service.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/posix/sys/eventfd.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/ztest.h>
 
 #define BUFFER_SIZE                    1024
@@ -541,6 +542,38 @@ struct http_resource_detail_dynamic dynamic_response_headers_detail = {
 HTTP_RESOURCE_DEFINE(dynamic_response_headers_resource, test_http_service, "/response_headers",
 		     &dynamic_response_headers_detail);
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+HTTP_RESOURCE_CACHE_DEFINE(cached_resource_cache, 64, 60000);
+
+static int cached_cb_calls;
+
+static int cached_cb(struct http_client_ctx *client, enum http_data_status status,
+		     const struct http_request_ctx *request_ctx,
+		     struct http_response_ctx *response_ctx, void *user_data)
+{
+	cached_cb_calls++;
+
+	response_ctx->body = (const uint8_t *)TEST_DYNAMIC_GET_PAYLOAD;
+	response_ctx->body_len = strlen(TEST_DYNAMIC_GET_PAYLOAD);
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+struct http_resource_detail_dynamic cached_detail = {
+	.common = {
+		.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+		.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+		.content_type = "text/plain",
+	},
+	.cb = cached_cb,
+	.user_data = NULL,
+	.cache = &cached_resource_cache,
+};
+
+HTTP_RESOURCE_DEFINE(cached_resource, test_http_service, "/cached", &cached_detail);
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 static int client_fd = -1;
 static uint8_t buf[BUFFER_SIZE];
 
@@ -2359,6 +2392,263 @@ ZTEST(server_function_tests, test_http2_500_internal_server_error)
 				HTTP2_FLAG_END_STREAM);
 }
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+static void cached_etag(char *etag, size_t len)
+{
+	snprintk(etag, len, "\"%08x\"",
+		 crc32_ieee((const uint8_t *)TEST_DYNAMIC_GET_PAYLOAD,
+			    strlen(TEST_DYNAMIC_GET_PAYLOAD)));
+}
+
+static void expect_http1_response(size_t *offset, const char *expected_response)
+{
+	size_t len = strlen(expected_response);
+
+	memset(buf + *offset, 0, sizeof(buf) - *offset);
+
+	test_read_data(offset, len);
+	zassert_mem_equal(buf, expected_response, len,
+			  "Received data doesn't match expected response");
+	test_consume_data(offset, len);
+}
+
+ZTEST(server_function_tests, test_http1_cached_get)
+{
+	static const char request[] =
+		"GET /cached HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char generated_response[] =
+		"HTTP/1.1 200\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Content-Type: text/plain\r\n"
+		"\r\n"
+		"10\r\n" TEST_DYNAMIC_GET_PAYLOAD "\r\n"
+		"0\r\n\r\n";
+	char etag[HTTP_SERVER_ETAG_LEN];
+	char conditional_request[128];
+	char expected_response[128];
+	size_t offset = 0;
+	int ret;
+
+	cached_etag(etag, sizeof(etag));
+
+	/* The first response is generated by the resource callback */
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http1_response(&offset, generated_response);
+	zassert_equal(cached_cb_calls, 1, "Resource callback not called");
+
+	/* The next one is served from the cache, with an ETag */
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	snprintk(expected_response, sizeof(expected_response),
+		 "HTTP/1.1 200 OK\r\n"
+		 "Content-Type: text/plain\r\n"
+		 "Content-Length: 16\r\n"
+		 "ETag: %s\r\n"
+		 "\r\n"
+		 TEST_DYNAMIC_GET_PAYLOAD, etag);
+
+	expect_http1_response(&offset, expected_response);
+	zassert_equal(cached_cb_calls, 1, "Cached response not served from the cache");
+
+	/* A request with the ETag gets no body */
+	snprintk(conditional_request, sizeof(conditional_request),
+		 "GET /cached HTTP/1.1\r\n"
+		 "Host: 127.0.0.1:8080\r\n"
+		 "If-None-Match: %s\r\n"
+		 "\r\n", etag);
+
+	ret = zsock_send(client_fd, conditional_request, strlen(conditional_request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	snprintk(expected_response, sizeof(expected_response),
+		 "HTTP/1.1 304 Not Modified\r\n"
+		 "ETag: %s\r\n"
+		 "\r\n", etag);
+
+	expect_http1_response(&offset, expected_response);
+	zassert_equal(cached_cb_calls, 1, "Cached response not served from the cache");
+}
+
+ZTEST(server_function_tests, test_http1_cached_get_bypass)
+{
+	static const char request[] =
+		"GET /cached HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char request_with_query[] =
+		"GET /cached?id=1 HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char generated_response[] =
+		"HTTP/1.1 200\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Content-Type: text/plain\r\n"
+		"\r\n"
+		"10\r\n" TEST_DYNAMIC_GET_PAYLOAD "\r\n"
+		"0\r\n\r\n";
+	size_t offset = 0;
+	int ret;
+
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http1_response(&offset, generated_response);
+
+	/* The response to a request with a query is not served from the cache */
+	ret = zsock_send(client_fd, request_with_query, strlen(request_with_query), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http1_response(&offset, generated_response);
+	zassert_equal(cached_cb_calls, 2, "Response to a query served from the cache");
+
+	/* Nor is the response once the cache is invalidated */
+	http_resource_cache_invalidate(&cached_resource_cache);
+
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http1_response(&offset, generated_response);
+	zassert_equal(cached_cb_calls, 3, "Invalidated response served from the cache");
+}
+
+ZTEST(server_function_tests, test_http1_cached_get_other_path)
+{
+	static const char request[] =
+		"GET /cached HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char request_other_path[] =
+		"GET /cached/other HTTP/1.1\r\n"
+		"Host: 127.0.0.1:8080\r\n"
+		"\r\n";
+	static const char generated_response[] =
+		"HTTP/1.1 200\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Content-Type: text/plain\r\n"
+		"\r\n"
+		"10\r\n" TEST_DYNAMIC_GET_PAYLOAD "\r\n"
+		"0\r\n\r\n";
+	size_t offset = 0;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_HTTP_SERVER_RESOURCE_WILDCARD)) {
+		ztest_test_skip();
+	}
+
+	ret = zsock_send(client_fd, request, strlen(request), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	expect_http1_response(&offset, generated_response);
+
+	/* The resource also answers the paths below it, which are not cached */
+	for (int i = 0; i < 2; i++) {
+		ret = zsock_send(client_fd, request_other_path, strlen(request_other_path), 0);
+		zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+		expect_http1_response(&offset, generated_response);
+	}
+
+	zassert_equal(cached_cb_calls, 3, "Response to another path served from the cache");
+}
+
+static void send_http2_cached_get(int stream_id, const char *etag)
+{
+	const struct http_header fields[] = {
+		{ ":method", "GET" },
+		{ ":scheme", "http" },
+		{ ":path", "/cached" },
+		{ "if-none-match", etag },
+	};
+	struct http_hpack_header_buf header;
+	uint8_t frame[128];
+	size_t len = HTTP2_FRAME_HEADER_SIZE;
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(fields); i++) {
+		if (fields[i].value == NULL) {
+			continue;
+		}
+
+		header.name = fields[i].name;
+		header.name_len = strlen(fields[i].name);
+		header.value = fields[i].value;
+		header.value_len = strlen(fields[i].value);
+
+		ret = http_hpack_encode_header(frame + len, sizeof(frame) - len, &header);
+		zassert_true(ret > 0, "Failed to encode header");
+		len += ret;
+	}
+
+	sys_put_be24(len - HTTP2_FRAME_HEADER_SIZE, &frame[HTTP2_FRAME_LENGTH_OFFSET]);
+	frame[HTTP2_FRAME_TYPE_OFFSET] = HTTP2_HEADERS_FRAME;
+	frame[HTTP2_FRAME_FLAGS_OFFSET] = HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM;
+	sys_put_be32(stream_id, &frame[HTTP2_FRAME_STREAM_ID_OFFSET]);
+
+	ret = zsock_send(client_fd, frame, len, 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+}
+
+ZTEST(server_function_tests, test_http2_cached_get)
+{
+	static const uint8_t preface[] = {
+		TEST_HTTP2_MAGIC,
+		TEST_HTTP2_SETTINGS,
+		TEST_HTTP2_SETTINGS_ACK,
+	};
+	char etag[HTTP_SERVER_ETAG_LEN];
+	const struct http_header cached_headers[] = {
+		{ ":status", "200" },
+		{ "etag", etag },
+	};
+	const struct http_header not_modified_headers[] = {
+		{ ":status", "304" },
+		{ "etag", etag },
+	};
+	size_t offset = 0;
+	int ret;
+
+	cached_etag(etag, sizeof(etag));
+
+	ret = zsock_send(client_fd, preface, sizeof(preface), 0);
+	zassert_not_equal(ret, -1, "send() failed (%d)", errno);
+
+	memset(buf, 0, sizeof(buf));
+
+	expect_http2_settings_frame(&offset, false);
+	expect_http2_settings_frame(&offset, true);
+
+	/* The first response is generated by the resource callback */
+	send_http2_cached_get(TEST_STREAM_ID_1, NULL);
+
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_1, HTTP2_FLAG_END_HEADERS, NULL, 0);
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_1, TEST_DYNAMIC_GET_PAYLOAD,
+				strlen(TEST_DYNAMIC_GET_PAYLOAD), HTTP2_FLAG_END_STREAM);
+	zassert_equal(cached_cb_calls, 1, "Resource callback not called");
+
+	/* The next one is served from the cache, with an ETag */
+	send_http2_cached_get(TEST_STREAM_ID_2, NULL);
+
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_2, HTTP2_FLAG_END_HEADERS,
+				   cached_headers, ARRAY_SIZE(cached_headers));
+	expect_http2_data_frame(&offset, TEST_STREAM_ID_2, TEST_DYNAMIC_GET_PAYLOAD,
+				strlen(TEST_DYNAMIC_GET_PAYLOAD), HTTP2_FLAG_END_STREAM);
+	zassert_equal(cached_cb_calls, 1, "Cached response not served from the cache");
+
+	/* A request with the ETag gets no body */
+	send_http2_cached_get(TEST_STREAM_ID_2 + 2, etag);
+
+	expect_http2_headers_frame(&offset, TEST_STREAM_ID_2 + 2,
+				   HTTP2_FLAG_END_HEADERS | HTTP2_FLAG_END_STREAM,
+				   not_modified_headers, ARRAY_SIZE(not_modified_headers));
+	zassert_equal(cached_cb_calls, 1, "Cached response not served from the cache");
+}
+#endif /* CONFIG_HTTP_SERVER_RESPONSE_CACHE */
+
 ZTEST(server_function_tests_no_init, test_http_server_start_stop)
 {
 	struct sockaddr_in sa = { 0 };
@@ -2799,6 +3089,11 @@ static void http_server_tests_before(void *fixture)
 	dynamic_payload_len = 0;
 	dynamic_error = false;
 
+#if defined(CONFIG_HTTP_SERVER_RESPONSE_CACHE)
+	cached_cb_calls = 0;
+	http_resource_cache_invalidate(&cached_resource_cache);
+#endif
+
 	ret = http_server_start();
 	if (ret < 0) {
 		printk("Failed to start the server\n");
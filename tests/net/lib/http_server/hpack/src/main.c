@@ -494,4 +494,108 @@ ZTEST(http2_hpack, test_http2_hpack_literal_not_indexed_decode)
 				 ARRAY_SIZE(test_enc_literal_not_indexed_headers));
 }
 
+#if defined(CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE)
+static struct http_hpack_encoder test_encoder;
+
+static int test_hpack_encode_dynamic(const char *name, const char *value)
+{
+	struct http_hpack_header_buf hdr = {
+		.name = name,
+		.value = value,
+		.name_len = strlen(name),
+		.value_len = strlen(value)
+	};
+
+	return http_hpack_encode_header_dynamic(&test_encoder, test_buf,
+						sizeof(test_buf), &hdr);
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_encode)
+{
+	static const uint8_t size_update[] = { 0x3f, 0xe1, 0x03 };
+	int ret;
+
+	http_hpack_encoder_init(&test_encoder);
+
+	/* The peer is told first that the table is smaller than by default. */
+	ret = http_hpack_encode_size_update(&test_encoder, test_buf, sizeof(test_buf));
+	zassert_equal(ret, sizeof(size_update), "Wrong size update length");
+	zassert_mem_equal(test_buf, size_update, ret, "Wrong size update");
+	zassert_equal(http_hpack_encode_size_update(&test_encoder, test_buf,
+						    sizeof(test_buf)), 0,
+		      "Size update repeated");
+
+	/* Literal with incremental indexing, name from the static table */
+	ret = test_hpack_encode_dynamic("content-type", "text/plain");
+	zassert_true(ret > 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0x5f, "Header not indexed");
+
+	/* Literal with incremental indexing, literal name */
+	ret = test_hpack_encode_dynamic("server", "zephyr");
+	zassert_true(ret > 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0x76, "Header not indexed");
+
+	/* Both are now in the dynamic table, the newest first. */
+	ret = test_hpack_encode_dynamic("server", "zephyr");
+	zassert_equal(ret, 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0xbe, "Wrong index");
+
+	ret = test_hpack_encode_dynamic("content-type", "text/plain");
+	zassert_equal(ret, 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0xbf, "Wrong index");
+
+	/* A name of the dynamic table is used for a new value. */
+	ret = test_hpack_encode_dynamic("x-custom", "a");
+	zassert_true(ret > 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0x40, "Header not indexed");
+
+	ret = test_hpack_encode_dynamic("x-custom", "b");
+	zassert_true(ret > 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0x7e, "Wrong name index");
+
+	/* The content length is never indexed. */
+	ret = test_hpack_encode_dynamic("content-length", "100");
+	zassert_equal(test_buf[0], 0x1f, "Header indexed");
+	zassert_equal(test_hpack_encode_dynamic("content-length", "100"), ret,
+		      "Header indexed");
+}
+
+ZTEST(http2_hpack, test_http2_hpack_dynamic_evict)
+{
+	static const uint8_t size_update[] = { 0x3f, 0x27 };
+	int ret;
+
+	http_hpack_encoder_init(&test_encoder);
+	(void)http_hpack_encode_size_update(&test_encoder, test_buf, sizeof(test_buf));
+
+	(void)test_hpack_encode_dynamic("content-type", "text/plain");
+	(void)test_hpack_encode_dynamic("server", "zephyr");
+
+	/* Only the newest entry fits in 70 bytes (54 and 44 bytes). */
+	http_hpack_encoder_set_max_size(&test_encoder, 70);
+
+	ret = http_hpack_encode_size_update(&test_encoder, test_buf, sizeof(test_buf));
+	zassert_equal(ret, sizeof(size_update), "Wrong size update length");
+	zassert_mem_equal(test_buf, size_update, ret, "Wrong size update");
+
+	ret = test_hpack_encode_dynamic("server", "zephyr");
+	zassert_equal(ret, 1, "Wrong encoding length");
+	zassert_equal(test_buf[0], 0xbe, "Wrong index");
+
+	ret = test_hpack_encode_dynamic("content-type", "text/plain");
+	zassert_true(ret > 1, "Evicted header still indexed");
+	zassert_equal(test_buf[0], 0x5f, "Header not indexed");
+
+	/* With no table at all, the headers are not indexed anymore. */
+	http_hpack_encoder_set_max_size(&test_encoder, 0);
+
+	ret = http_hpack_encode_size_update(&test_encoder, test_buf, sizeof(test_buf));
+	zassert_equal(ret, 1, "Wrong size update length");
+	zassert_equal(test_buf[0], 0x20, "Wrong size update");
+
+	ret = test_hpack_encode_dynamic("content-type", "text/plain");
+	zassert_equal(test_buf[0], 0x1f, "Header indexed");
+}
+#endif /* CONFIG_HTTP_SERVER_HPACK_DYNAMIC_TABLE */
+
 ZTEST_SUITE(http2_hpack, NULL, NULL, NULL, NULL, NULL);
@@ -544,6 +544,52 @@ static void test_route_preference(void)
 	net_route_del(route_entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *prefix_entry;
+	struct net_route_entry *entry;
+	struct in6_addr other_addr;
+
+	/* Same /64 as dest_addr, but another host */
+	net_ipaddr_copy(&other_addr, &dest_addr);
+	other_addr.s6_addr[15] ^= 0x01;
+
+	route_entry = net_route_add(my_iface,
+				    &dest_addr, 128,
+				    &peer_addr_alt,
+				    NET_IPV6_ND_INFINITE_LIFETIME,
+				    NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(route_entry, "Host route add failed");
+
+	/* Adding a route replaces the one its address is routed through,
+	 * so add the prefix route with an address outside of the host route.
+	 */
+	prefix_entry = net_route_add(my_iface,
+				     &other_addr, 64,
+				     &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_entry, "Prefix route add failed");
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, route_entry, "Host route not preferred");
+
+	entry = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not found");
+
+	entry = net_route_lookup(peer_iface, &dest_addr);
+	zassert_is_null(entry, "Route found on the wrong interface");
+
+	net_route_del(route_entry);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(entry, prefix_entry, "Prefix route not found");
+
+	net_route_del(prefix_entry);
+
+	entry = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(entry, "Route found after deletion");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +612,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
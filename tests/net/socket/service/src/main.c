@@ -180,4 +180,67 @@ ZTEST(net_socket_service, test_service_sync)
 			 &tcp_service_sync);
 }
 
+ZTEST(net_socket_service, test_service_unregister)
+{
+	int ret;
+	int c_sock_udp;
+	int s_sock_udp;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	ssize_t len;
+	char buf[10];
+	struct zsock_pollfd sock[1] = {
+		[0] = { .fd = -1 },
+	};
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, CLIENT_PORT, &c_sock_udp, &c_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &s_sock_udp, &s_addr);
+
+	ret = bind(s_sock_udp, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(ret, 0, "bind failed");
+
+	ret = connect(c_sock_udp, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(ret, 0, "connect failed");
+
+	sock[0].fd = s_sock_udp;
+	sock[0].events = ZSOCK_POLLIN;
+
+	ret = net_socket_service_register(&udp_service_sync, sock, ARRAY_SIZE(sock), NULL);
+	zassert_equal(ret, 0, "Cannot register udp service (%d)", ret);
+
+	/* The same socket cannot be monitored by two services */
+	ret = net_socket_service_register(&tcp_service_small_sync, sock, ARRAY_SIZE(sock), NULL);
+	zassert_equal(ret, -EEXIST, "Could register socket twice (%d)", ret);
+
+	len = send(c_sock_udp, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	if (k_sem_take(&wait_data, K_MSEC(WAIT_TIME))) {
+		zassert_true(0, "Timeout while waiting callback");
+	}
+
+	ret = net_socket_service_unregister(&udp_service_sync);
+	zassert_equal(ret, 0, "Cannot unregister udp service (%d)", ret);
+
+	len = recv(s_sock_udp, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	/* The callback might have run again before the service was
+	 * unregistered, but not after.
+	 */
+	k_sem_reset(&wait_data);
+
+	len = send(c_sock_udp, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	zassert_equal(k_sem_take(&wait_data, K_MSEC(WAIT_TIME)), -EAGAIN,
+		      "Callback called for unregistered socket");
+
+	ret = close(c_sock_udp);
+	zassert_equal(ret, 0, "close failed");
+
+	ret = close(s_sock_udp);
+	zassert_equal(ret, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_service, NULL, NULL, NULL, NULL, NULL);
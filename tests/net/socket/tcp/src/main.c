@@ -12,6 +12,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <zephyr/net/net_context.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
+#include <zephyr/net/ethernet.h>
 
 #include "../../socket_helpers.h"
 
@@ -26,6 +27,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #define MY_IPV4_ADDR "127.0.0.1"
 #define MY_IPV6_ADDR "::1"
+#define MY_IPV4_ADDR_ETH "192.0.2.1"
 
 #define ANY_PORT 0
 #define SERVER_PORT 4242
@@ -262,6 +264,62 @@ ZTEST_USER(net_socket_tcp, test_v4_send_recv)
 	k_sleep(TCP_TEARDOWN_TIMEOUT);
 }
 
+ZTEST(net_socket_tcp, test_v4_send_recv_buf)
+{
+	/* Test if data can be received without copying on a ipv4 stream socket. */
+	static char rx_buf[sizeof(TEST_STR_LONG)];
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct net_buf *buf;
+	size_t total = 0;
+	ssize_t recved;
+	int new_sock;
+	int c_sock;
+	int s_sock;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_send(c_sock, TEST_STR_LONG, strlen(TEST_STR_LONG), 0);
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	recved = zsock_recv_buf(new_sock, &buf, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_equal(recved, -1, "peeking should've failed");
+	zassert_equal(errno, EINVAL, "incorrect errno");
+
+	while (total < strlen(TEST_STR_LONG)) {
+		recved = zsock_recv_buf(new_sock, &buf, 0, NULL, NULL);
+		zassert_true(recved > 0, "recv_buf failed (%d)", errno);
+		zassert_not_null(buf, "no buffer");
+		zassert_equal(net_buf_frags_len(buf), recved, "wrong buffer length");
+		zassert_true(total + recved <= strlen(TEST_STR_LONG), "too much data");
+
+		net_buf_linearize(&rx_buf[total], sizeof(rx_buf) - total, buf, 0, recved);
+		net_buf_unref(buf);
+		total += recved;
+	}
+
+	zassert_mem_equal(rx_buf, TEST_STR_LONG, strlen(TEST_STR_LONG), "wrong data");
+
+	test_close(c_sock);
+
+	recved = zsock_recv_buf(new_sock, &buf, 0, NULL, NULL);
+	zassert_equal(recved, 0, "EOF not detected");
+	zassert_is_null(buf, "buffer returned at EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 ZTEST_USER(net_socket_tcp, test_v6_send_recv)
 {
 	/* Test if send() and recv() work on a ipv6 stream socket. */
@@ -490,6 +548,78 @@ ZTEST(net_socket_tcp, test_v6_send_recv_large_no_delay)
 	restore_packet_loss_ratio();
 }
 
+static void test_send_recv_gso(const char *addr_str)
+{
+	static uint8_t tx_buf[3000];
+	static uint8_t rx_buf[sizeof(tx_buf)];
+	struct timeval timeo_optval = {
+		.tv_sec = 2,
+	};
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int new_sock;
+	int c_sock;
+	int s_sock;
+	int ret;
+
+	for (int i = 0; i < sizeof(tx_buf); i++) {
+		tx_buf[i] = (i * TEST_PRIME) & 0xff;
+	}
+
+	prepare_sock_tcp_v4(addr_str, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(addr_str, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	ret = zsock_setsockopt(new_sock, SOL_SOCKET, SO_RCVTIMEO, &timeo_optval,
+			       sizeof(timeo_optval));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_send(c_sock, tx_buf, sizeof(tx_buf), 0);
+
+	ret = zsock_recv(new_sock, rx_buf, sizeof(rx_buf), ZSOCK_MSG_WAITALL);
+	zassert_equal(ret, sizeof(rx_buf), "Invalid length received (%d)", ret);
+	zassert_mem_equal(rx_buf, tx_buf, sizeof(rx_buf), "Invalid data received");
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_gso)
+{
+	/* Test that data larger than a segment is sent in one packet with GSO,
+	 * although the packets of the IP stack are capped at the MTU without
+	 * IP fragmentation.
+	 */
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO)) {
+		ztest_test_skip();
+	}
+
+	test_send_recv_gso(MY_IPV4_ADDR);
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_gso_local)
+{
+	/* Test that data larger than a segment sent with GSO to the address of
+	 * an Ethernet interface, which the IP stack delivers back to us without
+	 * splitting it, is received.
+	 */
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO) || !IS_ENABLED(CONFIG_NET_L2_ETHERNET)) {
+		ztest_test_skip();
+	}
+
+	test_send_recv_gso(MY_IPV4_ADDR_ETH);
+}
+
 ZTEST(net_socket_tcp, test_v4_broken_link)
 {
 	/* Test if the data stops transmitting after the send returned with a timeout. */
@@ -2000,6 +2130,68 @@ ZTEST(net_socket_tcp, test_socket_permission)
 #endif /* CONFIG_USERSPACE */
 }
 
+#if defined(CONFIG_NET_L2_ETHERNET)
+/* An interface that is not the loopback one, the packets to its address
+ * are delivered back to us by the IP stack.
+ */
+struct eth_fake_context {
+	struct net_if *iface;
+	uint8_t mac_address[6];
+};
+
+static struct eth_fake_context eth_fake_data = {
+	.mac_address = { 0x00, 0x00, 0x5e, 0x00, 0x53, 0x01 },
+};
+
+static void eth_fake_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_fake_context *ctx = dev->data;
+
+	ctx->iface = iface;
+
+	net_if_set_link_addr(iface, ctx->mac_address,
+			     sizeof(ctx->mac_address),
+			     NET_LINK_ETHERNET);
+
+	ethernet_init(iface);
+}
+
+static int eth_fake_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct ethernet_api eth_fake_api_funcs = {
+	.iface_api.init = eth_fake_iface_init,
+	.send = eth_fake_send,
+};
+
+ETH_NET_DEVICE_INIT(eth_fake, "eth_fake", NULL, NULL, &eth_fake_data, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &eth_fake_api_funcs, NET_ETH_MTU);
+
+static void setup_eth_iface(void)
+{
+	struct in_addr addr;
+	struct in_addr netmask = { { { 255, 255, 255, 0 } } };
+	struct net_if_addr *ifaddr;
+
+	zassert_equal(zsock_inet_pton(AF_INET, MY_IPV4_ADDR_ETH, &addr), 1);
+
+	ifaddr = net_if_ipv4_addr_add(eth_fake_data.iface, &addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add address to the Ethernet interface");
+
+	zassert_true(net_if_ipv4_set_netmask_by_addr(eth_fake_data.iface, &addr, &netmask));
+}
+#else
+static void setup_eth_iface(void)
+{
+}
+#endif /* CONFIG_NET_L2_ETHERNET */
+
 static void *setup(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -2007,6 +2199,8 @@ static void *setup(void)
 	k_thread_access_grant(k_current_get(), &child_thread, child_stack);
 #endif
 
+	setup_eth_iface();
+
 	if (IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)) {
 		k_thread_priority_set(k_current_get(),
 				K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1));
@@ -2502,6 +2696,68 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+static void check_congestion(int sock, const char *expected)
+{
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int ret;
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+	zassert_str_equal(name, expected, "getsockopt got invalid value");
+}
+
+ZTEST(net_socket_tcp, test_congestion_option)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	int ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	check_congestion(c_sock, "reno");
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "bbr", strlen("bbr"));
+	zassert_equal(ret, -1, "setsockopt should've failed");
+	zassert_equal(errno, ENOENT, "wrong errno value, %d", errno);
+	check_congestion(c_sock, "reno");
+
+	/* The name does not need to be null-terminated */
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "cubic", strlen("cubic"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	check_congestion(c_sock, "cubic");
+
+	/* Accepted sockets inherit the algorithm of the listening one */
+	ret = zsock_setsockopt(s_sock, IPPROTO_TCP, TCP_CONGESTION, "cubic", sizeof("cubic"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	check_congestion(new_sock, "cubic");
+
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	test_recv(new_sock, 0);
+
+	/* Switching algorithms on an established connection keeps it working */
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "reno", sizeof("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	check_congestion(c_sock, "reno");
+
+	test_send(c_sock, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	test_recv(new_sock, 0);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
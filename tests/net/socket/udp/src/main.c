@@ -3106,6 +3106,138 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+#define MMSG_COUNT 3
+
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	static const char *const payloads[MMSG_COUNT] = { "one", "two", "three" };
+	char bufs[MMSG_COUNT + 1][16];
+	struct sockaddr_in addrs[MMSG_COUNT + 1];
+	struct iovec io_vector[MMSG_COUNT + 1];
+	struct mmsghdr msgvec[MMSG_COUNT + 1];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		io_vector[i].iov_base = (void *)payloads[i];
+		io_vector[i].iov_len = strlen(payloads[i]);
+		memset(&msgvec[i], 0, sizeof(msgvec[i]));
+		msgvec[i].msg_hdr.msg_name = &server_addr;
+		msgvec[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgvec, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "wrong length sent");
+	}
+
+	/* Give the packets a chance to go through the net stack */
+	k_msleep(10);
+
+	/* Ask for one more message than was sent, the call must not block */
+	for (int i = 0; i < MMSG_COUNT + 1; i++) {
+		memset(bufs[i], 0, sizeof(bufs[i]));
+		io_vector[i].iov_base = bufs[i];
+		io_vector[i].iov_len = sizeof(bufs[i]);
+		memset(&msgvec[i], 0, sizeof(msgvec[i]));
+		msgvec[i].msg_hdr.msg_name = &addrs[i];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		msgvec[i].msg_hdr.msg_iov = &io_vector[i];
+		msgvec[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT + 1, ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgvec[i].msg_len, strlen(payloads[i]), "wrong length received");
+		zassert_mem_equal(bufs[i], payloads[i], strlen(payloads[i]), "wrong data");
+		zassert_equal(msgvec[i].msg_hdr.msg_namelen, sizeof(client_addr),
+			      "unexpected addrlen");
+		zassert_equal(addrs[i].sin_port, client_addr.sin_port, "unexpected client port");
+	}
+
+	/* Nothing is left, so a non-blocking call fails */
+	rv = zsock_recvmmsg(server_sock, msgvec, MMSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno");
+
+	rv = zsock_recvmmsg(server_sock, msgvec, 0, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, 0, "empty recvmmsg failed");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_42_v4_recv_buf)
+{
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	socklen_t addrlen;
+	struct net_buf *buf;
+	int client_sock;
+	int server_sock;
+	ssize_t recved;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, CLIENT_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr, sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* TEST_STR2 does not fit in a single net_buf */
+	rv = zsock_sendto(client_sock, TEST_STR2, STRLEN(TEST_STR2), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	addrlen = sizeof(addr);
+	recved = zsock_recv_buf(server_sock, &buf, 0, (struct sockaddr *)&addr, &addrlen);
+	zassert_equal(recved, STRLEN(TEST_STR2), "recv_buf failed (%d)", errno);
+	zassert_not_null(buf, "no buffer");
+	zassert_equal(net_buf_frags_len(buf), recved, "wrong buffer length");
+	zassert_equal(addrlen, sizeof(client_addr), "unexpected addrlen");
+	zassert_equal(addr.sin_port, client_addr.sin_port, "unexpected client port");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), buf, 0, recved);
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	net_buf_unref(buf);
+
+	recved = zsock_recv_buf(server_sock, &buf, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(recved, -1, "recv_buf should've failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno");
+	zassert_is_null(buf, "buffer returned without data");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -114,6 +114,7 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_SACK = 19,
 } test_case_no;
 
 static enum test_state t_state;
@@ -134,6 +135,7 @@ static void handle_client_closing_failure_test(sa_family_t af, struct tcphdr *th
 static void handle_data_fin1_test(sa_family_t af, struct tcphdr *th);
 static void handle_data_during_fin1_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th);
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
@@ -235,6 +237,12 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+static bool tester_sends_options(uint8_t flags)
+{
+	return (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4 ||
+		test_case_no == TEST_SERVER_SACK) && (flags & SYN);
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -248,7 +256,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (tester_sends_options(flags)) {
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -284,7 +292,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (tester_sends_options(flags)) {
 		th->th_off = 10U;
 	} else {
 		th->th_off = 5U;
@@ -303,7 +311,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (tester_sends_options(flags)) {
 		/* Add TCP Options */
 		ret = net_pkt_write(pkt, tcp_options, opts_len);
 		if (ret < 0) {
@@ -457,6 +465,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_SERVER_RECV_OUT_OF_ORDER_DATA:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case TEST_SERVER_SACK:
+		handle_server_sack(pkt, &th);
+		break;
 	case TEST_CLIENT_FIN_WAIT_1_RETRANSMIT_IPV4:
 		handle_data_fin1_test(net_pkt_family(pkt), &th);
 		break;
@@ -763,7 +774,8 @@ static void test_server_timeout(struct k_work *work)
 	    test_case_no == TEST_SERVER_RST_ON_CLOSED_PORT ||
 	    test_case_no == TEST_SERVER_RST_ON_LISTENING_PORT_NO_ACTIVE_CONNECTION) {
 		handle_server_test(AF_INET, NULL);
-	} else if (test_case_no == TEST_SERVER_IPV6) {
+	} else if (test_case_no == TEST_SERVER_IPV6 ||
+		   test_case_no == TEST_SERVER_SACK) {
 		handle_server_test(AF_INET6, NULL);
 	} else {
 		zassert_true(false, "Invalid test case");
@@ -1909,14 +1921,15 @@ ZTEST(net_tcp, test_client_closing_failure_ipv6)
 	test_sem_take_failure(K_MSEC(400), __LINE__);
 }
 
-static struct net_context *create_server_socket(uint32_t my_seq,
-						uint32_t my_ack)
+static struct net_context *create_server_socket_for(enum test_case_no test_case,
+						    uint32_t my_seq,
+						    uint32_t my_ack)
 {
 	struct net_context *ctx;
 	int ret;
 
 	t_state = T_SYN;
-	test_case_no = TEST_SERVER_IPV6;
+	test_case_no = test_case;
 	seq = my_seq;
 	ack = my_ack;
 
@@ -1954,6 +1967,12 @@ static struct net_context *create_server_socket(uint32_t my_seq,
 	return ctx;
 }
 
+static struct net_context *create_server_socket(uint32_t my_seq,
+						uint32_t my_ack)
+{
+	return create_server_socket_for(TEST_SERVER_IPV6, my_seq, my_ack);
+}
+
 static void check_rst_fail(uint32_t seq_value)
 {
 	struct net_pkt *reply;
@@ -2082,8 +2101,8 @@ static struct out_of_order_check_struct out_of_order_check_list[] = {
 	{ 30, 10, 0, 0}, /* First packet will be out-of-order */
 	{ 20, 12, 0, 0},
 	{ 10,  9, 0, 0}, /* Section with a gap */
-	{ 0,  10, 10, 0},
-	{ 10, 10, 40, 0}, /* First sequence complete */
+	{ 0,  10, 19, 0}, /* Section before the gap complete */
+	{ 10, 10, 40, 0}, /* First sequence complete, partly retransmitted */
 	{ 50,  6, 40, 0},
 	{ 50,  3, 40, 0}, /* Discardable packet */
 	{ 55,  5, 40, 0},
@@ -2211,6 +2230,155 @@ ZTEST(net_tcp, test_server_out_of_order_data)
 	test_server_timeout_out_of_order_data();
 }
 
+struct sack_check_struct {
+	int seq_offset;
+	int length;
+	int ack_offset;
+	int num_blocks;
+	struct {
+		int start;
+		int end;
+	} blocks[NET_TCP_MAX_SACK_BLOCKS];
+};
+
+static const struct sack_check_struct sack_check_list[] = {
+	{ 10, 10,  0, 1, { { 10, 20 } } },
+	{ 30, 10,  0, 2, { { 30, 40 }, { 10, 20 } } }, /* Most recent block first */
+	{ 50,  5,  0, 3, { { 50, 55 }, { 10, 20 }, { 30, 40 } } },
+	{ 20, 10,  0, 2, { { 10, 40 }, { 50, 55 } } }, /* Gap between blocks filled */
+	{  0, 10, 40, 1, { { 50, 55 } } },
+	{ 40, 10, 55, 0 }, /* Everything received */
+};
+
+#define SACK_SEQ_INIT 1000
+static const struct sack_check_struct *sack_check;
+
+/* Returns the offset of the TCP option of the given kind in opts, or -1 */
+static int find_tcp_option(const uint8_t *opts, int len, uint8_t kind)
+{
+	int i = 0;
+
+	while (i < len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= len || opts[i + 1] < 2) {
+			break;
+		}
+
+		if (opts[i] == kind) {
+			return i;
+		}
+
+		i += opts[i + 1];
+	}
+
+	return -1;
+}
+
+static void handle_server_sack(struct net_pkt *pkt, struct tcphdr *th)
+{
+	uint8_t opts[NET_TCP_MAX_OPTS_LEN];
+	int opts_len = (th->th_off - 5) * 4;
+	int ret;
+	int i;
+
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			   sizeof(struct tcphdr));
+	zassert_equal(ret, 0, "Cannot skip the headers");
+
+	ret = net_pkt_read(pkt, opts, opts_len);
+	zassert_equal(ret, 0, "Cannot read the options");
+
+	net_pkt_cursor_init(pkt);
+
+	if (t_state == T_SYN_ACK) {
+		zassert_true(find_tcp_option(opts, opts_len, NET_TCP_SACK_PERM_OPT) >= 0,
+			     "SACK not permitted in SYN-ACK");
+		handle_server_test(net_pkt_family(pkt), th);
+		return;
+	}
+
+	zassert_equal(expected_ack, ntohl(th->th_ack), "Expected ACK %u but got %u",
+		      expected_ack, ntohl(th->th_ack));
+
+	i = find_tcp_option(opts, opts_len, NET_TCP_SACK_OPT);
+	if (sack_check->num_blocks == 0) {
+		zassert_true(i < 0, "Unexpected SACK option");
+	} else {
+		zassert_true(i >= 0, "No SACK option");
+		zassert_equal(opts[i + 1], 2 + sack_check->num_blocks * NET_TCP_SACK_BLOCK_SIZE,
+			      "Wrong number of SACK blocks");
+
+		for (int b = 0; b < sack_check->num_blocks; b++) {
+			uint8_t *block = &opts[i + 2 + b * NET_TCP_SACK_BLOCK_SIZE];
+
+			zassert_equal(sys_get_be32(block),
+				      SACK_SEQ_INIT + 1 + sack_check->blocks[b].start,
+				      "Wrong start of SACK block %d", b);
+			zassert_equal(sys_get_be32(block + 4),
+				      SACK_SEQ_INIT + 1 + sack_check->blocks[b].end,
+				      "Wrong end of SACK block %d", b);
+		}
+	}
+
+	test_sem_give();
+}
+
+/* Test case scenario IPv6
+ *   Send SYN permitting SACK,
+ *   expect SYN ACK permitting SACK,
+ *   send data with gaps,
+ *   expect ACKs reporting the received data in SACK blocks.
+ */
+ZTEST(net_tcp, test_server_sack)
+{
+	const uint8_t *data = lorem_ipsum + 10;
+	struct net_context *ctx;
+	struct net_pkt *pkt;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK)) {
+		ztest_test_skip();
+	}
+
+	k_sem_reset(&test_sem);
+
+	ctx = create_server_socket_for(TEST_SERVER_SACK, SACK_SEQ_INIT, 0);
+
+	ARRAY_FOR_EACH_PTR(sack_check_list, check) {
+		sack_check = check;
+		seq = SACK_SEQ_INIT + 1 + check->seq_offset;
+		expected_ack = SACK_SEQ_INIT + 1 + check->ack_offset;
+
+		pkt = prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					  &data[check->seq_offset], check->length);
+		zassert_not_null(pkt, "Cannot create pkt");
+
+		ret = net_recv_data(net_iface, pkt);
+		zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+		test_sem_take(K_MSEC(1000), __LINE__);
+	}
+
+	/* Abort the connection, no need for a full closing handshake */
+	seq = expected_ack;
+	pkt = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th)
 {
 	switch (t_state) {
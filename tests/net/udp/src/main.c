@@ -415,7 +415,7 @@ ZTEST(udp_fn_tests, test_udp)
 	struct net_conn_handle *handlers[CONFIG_NET_MAX_CONN];
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
-	struct ud *ud;
+	struct ud *ud, *ud2, *ud3;
 	int ret, i = 0;
 	bool st;
 
@@ -606,6 +606,17 @@ ZTEST(udp_fn_tests, test_udp)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4242);
 	TEST_IPV6_FAIL(ud, &in6addr_peer, &in6addr_my, 1234, 4243);
 
+	/* Connections sharing a local port are told apart by the remote one */
+	ud2 = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1235, 4242);
+	TEST_IPV6_OK(ud2, &in6addr_peer, &in6addr_my, 1235, 4242);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4242);
+
+	/* A listener on the port only gets what the connections do not */
+	ud3 = REGISTER(AF_INET6, NULL, &my_addr6, 0, 4242);
+	TEST_IPV6_OK(ud3, &in6addr_peer, &in6addr_my, 1236, 4242);
+	TEST_IPV6_OK(ud2, &in6addr_peer, &in6addr_my, 1235, 4242);
+	UNREGISTER(ud3);
+
 	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 4242);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
@@ -13,6 +13,7 @@
 #include "../../../lib/crc/crc7_sw.c"
 #include "../../../lib/crc/crc24_sw.c"
 #include "../../../lib/crc/crc32k_4_2_sw.c"
+#include "../../../lib/crc/crc_tables.c"
 
 ZTEST(crc, test_crc32_k_4_2)
 {
@@ -73,6 +74,47 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+/* Bit at a time reference for the reflected 32-bit CRCs */
+static uint32_t crc32_reflect_ref(uint32_t poly, uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int j = 0; j < 8; j++) {
+			crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+		}
+	}
+
+	return crc;
+}
+
+ZTEST(crc, test_crc_long_buffers)
+{
+	static uint8_t buf[300];
+	uint32_t seed = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 151 + 7);
+	}
+
+	/* Cover the unaligned head, the sliced middle and the tail of every engine */
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len < sizeof(buf) - off; len += (len < 32) ? 1 : 29) {
+			const uint8_t *data = &buf[off];
+
+			zassert_equal(crc32_ieee_update(seed, data, len),
+				      ~crc32_reflect_ref(0xedb88320, ~seed, data, len),
+				      "crc32_ieee off %zu len %zu", off, len);
+			zassert_equal(crc32_c(seed, data, len, false, false),
+				      crc32_reflect_ref(0x82f63b78, seed, data, len),
+				      "crc32_c off %zu len %zu", off, len);
+			zassert_equal(crc16_ccitt((uint16_t)seed, data, len),
+				      crc16_reflect(0x8408, (uint16_t)seed, data, len),
+				      "crc16_ccitt off %zu len %zu", off, len);
+		}
+		seed = seed * 1103515245 + 12345;
+	}
+}
+
 ZTEST(crc, test_crc24_pgp)
 {
 	uint8_t test1[] = { 'A' };